@@ -9,14 +9,66 @@
 #include <climits> 
 
 
+//* MODOS DE REDONDEO (TERCER PARAMETRO DE BFP_bias, MISMOS QUE HW/bfp_hls.h)
+// RNE: AL PAR MAS CERCANO, TRUNC: TRUNCA LA MAGNITUD, STOCH: ESTOCASTICO
+// (E[q] = x / 2^shift, SIN SESGO AL ACUMULAR), HALF_AWAY: EMPATES LEJOS DE 0.
+// EN CPU LOS BITS DE STOCH SALEN DE UN GENERADOR POR CONTADOR (BFP_Rng); EN
+// HW DE UN LFSR POR LANE, ASI QUE CPU Y HW SON REPRODUCIBLES PERO NO IGUALES.
+// COMO EN HW, EL GENERADOR VA APARTE DE BFP_Stats Y STOCH EXIGE UNO SEMBRADO
+enum : int {
+    BFP_RND_RNE       = 0,
+    BFP_RND_TRUNC     = 1,
+    BFP_RND_STOCH     = 2,
+    BFP_RND_HALF_AWAY = 3
+};
+
+//* POLITICAS DE REDONDEO (SIN ESTADO, MISMAS QUE HW/bfp_hls.h)
+// step(q, cmp): q = COCIENTE TRUNCADO, cmp = SIGNO DE (RESTO - MEDIO ULP)
+struct RoundNearestEven {
+    static constexpr int id = BFP_RND_RNE;
+    template<class T>
+    static T step(T q, int cmp) { return (cmp > 0 || (cmp == 0 && (q & 1u))) ? T(q + 1) : q; }
+};
+
+struct RoundTowardZero {
+    static constexpr int id = BFP_RND_TRUNC;
+    template<class T>
+    static T step(T q, int) { return q; }
+};
+
+struct RoundHalfAway {
+    static constexpr int id = BFP_RND_HALF_AWAY;
+    template<class T>
+    static T step(T q, int cmp) { return (cmp >= 0) ? T(q + 1) : q; }
+};
+
+// POLITICA DE CADA MODO (STOCH CAE A RNE EN LOS CAMINOS SIN GENERADOR)
+template<int RND> struct BFP_round_policy                    { using type = RoundNearestEven; };
+template<>        struct BFP_round_policy<BFP_RND_TRUNC>     { using type = RoundTowardZero; };
+template<>        struct BFP_round_policy<BFP_RND_HALF_AWAY> { using type = RoundHalfAway; };
+
+//* x / 2^shift REDONDEADO CON LA POLITICA P (MAGNITUDES; shift <= 0 NO DESPLAZA)
+// EN 64 BITS: EL PRODUCTO DE MANTISAS (2 * (WM + 1) BITS) NO CABE EN 32 CON WM >= 16
+template<class P>
+static inline uint64_t bfp_round_shr(uint64_t x, int shift) {
+    if (shift <= 0) return x;
+    if (shift >= 64) return 0u;   // TODO SE DESCARTA
+
+    const uint64_t q    = x >> shift;
+    const uint64_t rem  = x & ((uint64_t(1) << shift) - 1u);
+    const uint64_t half = uint64_t(1) << (shift - 1);
+    return P::step(q, (rem > half) ? 1 : (rem == half) ? 0 : -1);
+}
+
 //*CONFIGURACION DE BIAS PARA FORMATO BFP 
-template<int WE, int WM>
+template<int WE, int WM, int RND = BFP_RND_RNE>
 struct BFP_bias {
 
     static constexpr int we = WE;                      
     static constexpr int wm = WM;                      
     static constexpr int bias_bfp = (1 << (WE - 1)) -1;
-
+    static constexpr int rnd = RND;
+    using round = typename BFP_round_policy<RND>::type;
 
 };
 
@@ -29,16 +81,8 @@ static inline uint32_t helper_rne(uint32_t x, int shift) {
         return (s == 0) ? x : (x << s);
     }
 
-    //SHIFT RIGHT
-    if (shift >= 32) return 0u;       // ES LO QUE TODO SE DESCARTA
-
-    uint32_t q    = x >> shift;
-    uint32_t rem  = x & ((1u << shift) - 1u);
-    uint32_t half = 1u << (shift - 1);
-
-    // RNE: NEAREST / TIES-TO-EVEN
-    if (rem > half || (rem == half && (q & 1u))) {++q; }
-    return q;
+    //SHIFT RIGHT: NEAREST / TIES-TO-EVEN
+    return uint32_t(bfp_round_shr<RoundNearestEven>(x, shift));
 }
 
 //* ------------------------------------------------------------------------
@@ -71,10 +115,112 @@ struct BFP_Global{
      
 };
 
-//* CODIFICACION GLOBLAL CALCULANDO EMAX Y USANDO RNE
+//* GENERADOR POR CONTADOR (REDONDEO ESTOCASTICO)
+// EL SORTEO k ES UNA FUNCION PURA DE (SEMILLA, k) (MEZCLA splitmix64): SIN
+// ESTADO MAS QUE EL CONTADOR, REPRODUCIBLE DESDE LA SEMILLA Y POSICIONABLE
+// (ctr) PARA REPARTIR UN TENSOR ENTRE HILOS SIN DEPENDER DEL ORDEN
+static inline uint64_t bfp_mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+struct BFP_Rng {
+    uint64_t key;   // SEMILLA MEZCLADA
+    uint64_t ctr;   // SORTEOS CONSUMIDOS
+
+    explicit BFP_Rng(uint64_t s) { seed(s); }   // SIN CONSTRUCTOR POR DEFECTO
+
+    void seed(uint64_t s) { key = bfp_mix64(s); ctr = 0; }
+
+    // SUBSECUENCIA k (2^32 SORTEOS CADA UNA): FILA / BLOQUE k DE UN TENSOR
+    BFP_Rng stream(uint64_t k) const {
+        BFP_Rng r = *this;
+        r.ctr += k << 32;
+        return r;
+    }
+
+    uint64_t next64() {
+        return bfp_mix64(key + (++ctr) * 0x9E3779B97F4A7C15ull);
+    }
+
+    uint32_t next() {
+        return uint32_t(next64() >> 32);
+    }
+};
+
+//* CONTADORES DE SALUD NUMERICA (MISMA INTERFAZ QUE HW/bfp_hls.h)
+// EN ESTE MODELO NO HAY CENTINELAS: NaN/Inf SE CUENTAN A LA ENTRADA DE
+// encode_block Y 1/0 EN rcp_blocks COMO Inf
+template<class Cfg>
+struct BFP_Stats {
+    static constexpr int n_exp = 1 << Cfg::we;
+
+    uint32_t blocks;            // BLOQUES BFP PRODUCIDOS (record_block)
+    uint32_t exp_overflow;      // EXPONENTE COMPARTIDO SATURADO A 2^WE - 1
+    uint32_t exp_underflow;     // EXPONENTE COMPARTIDO SATURADO A 0
+    uint32_t mant_sat;          // MANTISAS RECORTADAS A MANT_MAX
+    uint32_t flush_zero;        // ELEMENTOS NO NULOS CUANTIZADOS A 0
+    uint32_t nan_count;
+    uint32_t inf_count;
+    uint32_t exp_hist[n_exp];   // HISTOGRAMA DE exp_shared
+
+    template<std::size_t Block_size>
+    void record_block(const BFP_Global<Cfg, Block_size>& blk) {
+        blocks++;
+        exp_hist[blk.exp_shared & (n_exp - 1)]++;
+    }
+
+    // SUMAR LOS CONTADORES DE OTRO BFP_Stats (MISMO WE, OTRO MODO DE REDONDEO)
+    template<class O>
+    void merge(const BFP_Stats<O>& o) {
+        static_assert(BFP_Stats<O>::n_exp == n_exp, "merge: distinto WE");
+        blocks        += o.blocks;
+        exp_overflow  += o.exp_overflow;
+        exp_underflow += o.exp_underflow;
+        mant_sat      += o.mant_sat;
+        flush_zero    += o.flush_zero;
+        nan_count     += o.nan_count;
+        inf_count     += o.inf_count;
+        for (int e = 0; e < n_exp; e++) exp_hist[e] += o.exp_hist[e];
+    }
+};
+
+//* REDONDEO SEGUN Cfg::rnd (SHIFT RIGHT): POLITICA Cfg::round, O EL GENERADOR EN
+//* STOCH (SOLO SORTEA SI DESCARTA BITS). 64 BITS COMO bfp_round_shr; shift < 0
+//* DESPLAZA A LA IZQUIERDA
+template<class Cfg>
+static inline uint64_t helper_round(uint64_t x, int shift, BFP_Rng& rng) {
+    if (shift <= 0) return (-shift >= 64) ? 0u : (x << -shift);
+    if (Cfg::rnd != BFP_RND_STOCH) return bfp_round_shr<typename Cfg::round>(x, shift);
+    if (shift >= 64) return 0u;
+
+    const uint64_t r = rng.next64() >> (64 - shift);      // shift BITS ALEATORIOS
+    const uint64_t q = x >> shift;
+    const uint64_t rem = x & ((uint64_t(1) << shift) - 1u);
+    return q + ((rem + r) >> shift);                      // SIN DESBORDAR x + r
+}
+
+//* GENERADOR DE LAS VERSIONES SIN BFP_Rng: SOLO MODOS DETERMINISTAS (NO SORTEAN)
+template<class Cfg>
+static inline BFP_Rng bfp_no_rng() {
+    static_assert(Cfg::rnd != BFP_RND_STOCH, "STOCH necesita un BFP_Rng sembrado");
+    return BFP_Rng(0);
+}
+
+// CONTAR SATURACION DEL EXPONENTE (MISMO CRITERIO QUE EL CLAMP)
+template<class Cfg>
+static inline void count_exp_clamp(long long Er, BFP_Stats<Cfg>& st) {
+    const long long Es = Er + Cfg::bias_bfp;
+    if (Es < 0) st.exp_underflow++;
+    if (Es > (1 << Cfg::we) - 1) st.exp_overflow++;
+}
+
+//* CODIFICACION GLOBLAL CALCULANDO EMAX Y REDONDEANDO CON Cfg::rnd
 
 template< class Cfg, std::size_t Block_size>
-BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs){
+BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs,
+                                         BFP_Stats<Cfg>& st, BFP_Rng& rng){
 
     BFP_Global<Cfg, Block_size> out{};
 
@@ -105,12 +251,13 @@ BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs
     
     //* CALCULO DEL EXPONENTE COMPARTIDO PARA BFP CON BIAS
     int exp_shared_bfp = Emax + Cfg::bias_bfp;
+    count_exp_clamp<Cfg>(Emax, st);
     // PARA ASEGURAR QUE CABE EN WE BITS
     if (exp_shared_bfp < 0 ) exp_shared_bfp = 0;
     if (exp_shared_bfp > (1 << Cfg::we) - 1) exp_shared_bfp = (1 << Cfg::we) - 1;
     out.exp_shared = uint32_t(exp_shared_bfp);
 
-    //* CUANTIZAR Y CODIFICAR CADA ELEMENTO CON EL EXPONENTE MAX (SHIFT & RNE)
+    //* CUANTIZAR Y CODIFICAR CADA ELEMENTO CON EL EXPONENTE MAX (SHIFT & REDONDEO)
     // PARA LIMPIAR A WE
     const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1;
 
@@ -134,8 +281,13 @@ BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs
             out.sign[i]  = 0;
             out.mant[i]  = 0;
             out.delta[i] = 0;
+            st.flush_zero++; // SUBNORMAL -> 0
             continue;
         }
+        if (exp_fp32 == 0xFF) {
+            if (u.u & 0x7FFFFF) st.nan_count++;
+            else                st.inf_count++;
+        }
 
         // EXPONENTE REAL Y DELTA_i    Δ_i = Emax - Ereal_i
         int Ereal_i = exp_fp32 - 127;
@@ -160,13 +312,14 @@ BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs
         uint32_t mant_reduced;
 
         if (shift_total >= 31) mant_reduced = 0u; //CASO DE UNDERFLOW POR DESPLAZAR DEMASIADO
-        else if (shift_total >= 0) mant_reduced = helper_rne(mant24, shift_total);
+        else if (shift_total >= 0) mant_reduced = uint32_t(helper_round<Cfg>(mant24, shift_total, rng));
         else {
             int sleft = -shift_total;
             mant_reduced = (sleft >= 32) ? 0u : (mant24 << sleft);// CASO QUE NO DEBE PASAR
          }
 
-        if(mant_reduced > mant_max) mant_reduced = mant_max;
+        if(mant_reduced > mant_max) { mant_reduced = mant_max; st.mant_sat++; }
+        if(mant_reduced == 0u) st.flush_zero++;
 
         //* GUARDAR SIGN Y MANTISA WM
         out.sign[i] = s;
@@ -178,6 +331,21 @@ BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs
     
 }  
 
+// VERSION SIN GENERADOR (MODOS DETERMINISTAS)
+template< class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs,
+                                         BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return encode_block<Cfg, Block_size>(xs, st, rng);
+}
+
+// VERSION SIN CONTADORES
+template< class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs){
+    BFP_Stats<Cfg> st{};
+    return encode_block<Cfg, Block_size>(xs, st);
+}
+
 
 
 #endif 
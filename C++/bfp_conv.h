@@ -0,0 +1,114 @@
+#ifndef BFP_CONV_H
+#define BFP_CONV_H
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "bfp.h"
+
+//* CONVOLUCION 2D EN BFP (REFERENCIA CPU MULTIHILO)
+// LAYOUT HWC CON CANALES EN BLOQUES DE Block_size (MISMO QUE HW/bfp_conv.cpp):
+//   ENTRADA : in[(y * W + x) * CB + cb]                    CB = ceil(C_in / Bs)
+//   PESOS   : w[((oc * K + ky) * K + kx) * CB + cb]         UN BLOQUE = Bs CANALES DE ENTRADA
+//   SALIDA  : out[(oy * OW + ox) * C_out + oc]              FP32
+// EL VALOR DE UN LANE ES mant * 2^(E - bias - wm), ASI QUE CADA PAR DE BLOQUES
+// APORTA UN PRODUCTO PUNTO ENTERO DE MANTISAS CON EXPONENTE Ea + Eb.
+
+struct Conv2DShape {
+    int height;
+    int width;
+    int c_in;
+    int c_out;
+    int ksize;
+    int stride;
+    int pad;
+
+    int out_h() const { return (height + 2 * pad - ksize) / stride + 1; }
+    int out_w() const { return (width + 2 * pad - ksize) / stride + 1; }
+    template<std::size_t Block_size>
+    int cb_in() const { return (c_in + int(Block_size) - 1) / int(Block_size); }
+};
+
+//* CODIFICAR UN MAPA HWC (FP32) EN BLOQUES DE CANALES
+// PARA LOS PESOS w[oc][ky][kx][ci]: pixels = C_out * K * K, channels = C_in
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+std::vector<Blk> conv_encode_hwc(const std::vector<float>& x, int pixels, int channels) {
+    const int cb_n = (channels + int(Block_size) - 1) / int(Block_size);
+    std::vector<Blk> out(std::size_t(pixels) * cb_n);
+    for (int p = 0; p < pixels; p++) {
+        for (int cb = 0; cb < cb_n; cb++) {
+            std::array<float, Block_size> xs{};
+            for (std::size_t l = 0; l < Block_size; l++) {
+                const int c = cb * int(Block_size) + int(l);
+                xs[l] = (c < channels) ? x[std::size_t(p) * channels + c] : 0.0f;
+            }
+            out[std::size_t(p) * cb_n + cb] = encode_block<Cfg, Block_size>(xs);
+        }
+    }
+    return out;
+}
+
+//* PRODUCTO PUNTO DE DOS BLOQUES (ENTERO) ESCALADO A DOUBLE
+template<class Cfg, std::size_t Block_size, class Blk>
+static inline double conv_block_dot(const Blk& a, const Blk& b) {
+    long long dot = 0;
+    for (std::size_t i = 0; i < Block_size; i++) {
+        const long long prod = (long long)a.mant[i] * (long long)b.mant[i];
+        dot += (a.sign[i] ^ b.sign[i]) ? -prod : prod;
+    }
+    if (dot == 0) return 0.0;
+    const int e = int(a.exp_shared) + int(b.exp_shared) - 2 * Cfg::bias_bfp - 2 * Cfg::wm;
+    return std::ldexp(double(dot), e);
+}
+
+//* CONVOLUCION DE REFERENCIA: LAS FILAS DE SALIDA SE REPARTEN ENTRE HILOS
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+std::vector<float> conv2d_bfp_ref(const std::vector<Blk>& in,
+                                  const std::vector<Blk>& w,
+                                  const Conv2DShape& s,
+                                  unsigned n_threads = std::thread::hardware_concurrency()) {
+    const int OH = s.out_h(), OW = s.out_w();
+    const int CB = s.cb_in<Block_size>();
+    const int K  = s.ksize;
+    std::vector<float> out(std::size_t(OH) * OW * s.c_out, 0.0f);
+
+    auto work = [&](int row_begin, int row_end) {
+        for (int oy = row_begin; oy < row_end; oy++) {
+            for (int ox = 0; ox < OW; ox++) {
+                for (int oc = 0; oc < s.c_out; oc++) {
+                    double acc = 0.0;
+                    for (int ky = 0; ky < K; ky++) {
+                        const int y = oy * s.stride + ky - s.pad;
+                        if (y < 0 || y >= s.height) continue;   // PADDING CON CEROS
+                        for (int kx = 0; kx < K; kx++) {
+                            const int x = ox * s.stride + kx - s.pad;
+                            if (x < 0 || x >= s.width) continue;
+                            for (int cb = 0; cb < CB; cb++) {
+                                acc += conv_block_dot<Cfg, Block_size>(
+                                    in[(std::size_t(y) * s.width + x) * CB + cb],
+                                    w[((std::size_t(oc) * K + ky) * K + kx) * CB + cb]);
+                            }
+                        }
+                    }
+                    out[(std::size_t(oy) * OW + ox) * s.c_out + oc] = float(acc);
+                }
+            }
+        }
+    };
+
+    if (n_threads == 0) n_threads = 1;
+    n_threads = std::min<unsigned>(n_threads, unsigned(OH));
+    std::vector<std::thread> pool;
+    const int rows_per = (OH + int(n_threads) - 1) / int(n_threads);
+    for (unsigned t = 0; t < n_threads; t++) {
+        const int r0 = int(t) * rows_per;
+        const int r1 = std::min(OH, r0 + rows_per);
+        if (r0 < r1) pool.emplace_back(work, r0, r1);
+    }
+    for (auto& th : pool) th.join();
+    return out;
+}
+
+#endif // BFP_CONV_H
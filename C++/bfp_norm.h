@@ -0,0 +1,194 @@
+#ifndef BFP_NORM_H
+#define BFP_NORM_H
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "bfp.h"
+
+//* LAYERNORM / RMSNORM POR FILAS (MISMO ALGORITMO ENTERO QUE HW/bfp_norm_hls.h)
+// UNA FILA = row_blocks BLOQUES CONSECUTIVOS; gamma/beta TIENEN row_blocks * Bs CANALES.
+// CADA LANE SE ALINEA AL EXPONENTE MAXIMO DE LA FILA CON NORM_GUARD BITS EXTRA:
+//   s_i = mant_i * 2^(G - d_i)   sq_i = mant_i^2 * 2^(G - 2 d_i)   d_i = Emax - E_bloque
+// MEDIA Y VARIANZA SALEN DE SUMAS int64; 1/sqrt CON TABLA + UN PASO DE NEWTON (Q16).
+
+static constexpr int BFP_NORM_GUARD = 20;       // PAR: G/2 ENTERO
+static constexpr int BFP_NORM_RSQRT_FRAC = 16;
+
+// 1/sqrt(m) EN EL PUNTO MEDIO DE CADA TRAMO DE 1/16 DE m EN [1, 4), Q16
+static const uint32_t BFP_NORM_RSQRT_TABLE[48] = {
+    64535, 62664, 60947, 59364, 57898, 56535, 55265, 54076,
+    52961, 51912, 50923, 49989, 49104, 48265, 47467, 46707,
+    45983, 45292, 44630, 43997, 43390, 42808, 42248, 41710,
+    41192, 40693, 40211, 39746, 39297, 38863, 38443, 38036,
+    37642, 37260, 36889, 36529, 36179, 35840, 35509, 35188,
+    34875, 34571, 34274, 33985, 33703, 33427, 33159, 32897,
+};
+
+//* 1/sqrt(v), v > 0:  v = m * 2^e, m EN [1, 4), e PAR  ->  1/sqrt(v) = y * 2^-(16 + e/2)
+static inline void bfp_rsqrt_q16(uint64_t v, uint32_t& y, int& e) {
+    int p = 63;
+    while (p > 0 && !((v >> p) & 1u)) p--;
+    e = p & ~1;
+
+    const uint64_t m = (e >= BFP_NORM_RSQRT_FRAC) ? (v >> (e - BFP_NORM_RSQRT_FRAC))
+                                                  : (v << (BFP_NORM_RSQRT_FRAC - e));
+    const uint64_t y0 = BFP_NORM_RSQRT_TABLE[(m >> (BFP_NORM_RSQRT_FRAC - 4)) - 16];
+
+    // NEWTON:  y1 = y0 * (3 - m * y0^2) / 2
+    const uint64_t my2 = (m * ((y0 * y0) >> BFP_NORM_RSQRT_FRAC)) >> BFP_NORM_RSQRT_FRAC;
+    const int64_t  t   = (int64_t(3) << BFP_NORM_RSQRT_FRAC) - int64_t(my2);
+    y = uint32_t((int64_t(y0) * t) >> (BFP_NORM_RSQRT_FRAC + 1));
+}
+
+//* LANES DE UN BLOQUE ALINEADOS A Emax (BUCLE SIN SALTOS, VECTORIZABLE)
+template<class Cfg, std::size_t Block_size, class Blk>
+static inline void bfp_norm_align(const Blk& blk, int Emax,
+                                  std::array<int64_t, Block_size>& s,
+                                  std::array<int64_t, Block_size>& sq) {
+    constexpr int G = BFP_NORM_GUARD;
+    const int d = Emax - int(blk.exp_shared);
+    const bool s_zero  = d > G + Cfg::wm + 1;
+    const bool sq_zero = 2 * d > G + 2 * Cfg::wm + 2;
+    for (std::size_t l = 0; l < Block_size; l++) {
+        const int64_t m  = blk.mant[l];
+        const int64_t v  = s_zero ? 0 : ((m << G) >> d);
+        s[l]  = blk.sign[l] ? -v : v;
+        sq[l] = sq_zero ? 0 : (((m * m) << G) >> (2 * d));
+    }
+}
+
+//* NORMALIZA UNA FILA: out = (x - mean) / sqrt(var + eps) * gamma + beta
+// rms = true: RMSNorm (SIN MEDIA NI beta)
+// channels: CANALES VALIDOS DE LA FILA (<= row_blocks * Block_size); LOS LANES
+// c >= channels DEL ULTIMO BLOQUE NO ENTRAN EN LAS SUMAS Y SALEN A CERO
+// FILA VACIA (row_blocks o channels <= 0): NO SE ESCRIBE NADA
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+void bfp_norm_row(const Blk* row, int row_blocks, int channels,
+                  const float* gamma, const float* beta,
+                  bool rms, float eps, Blk* out, BFP_Stats<Cfg>& st, BFP_Rng& rng) {
+    constexpr int G = BFP_NORM_GUARD;
+    if (row_blocks <= 0 || channels <= 0) return;
+
+    int Emax = 0;
+    for (int b = 0; b < row_blocks; b++) Emax = std::max(Emax, int(row[b].exp_shared));
+
+    int64_t S = 0, SQ = 0;
+    std::array<int64_t, Block_size> s{}, sq{};
+    for (int b = 0; b < row_blocks; b++) {
+        bfp_norm_align<Cfg, Block_size>(row[b], Emax, s, sq);
+        for (std::size_t l = 0; l < Block_size; l++) {
+            const bool valid = int(std::size_t(b) * Block_size + l) < channels;
+            S  += valid ? s[l] : 0;
+            SQ += valid ? sq[l] : 0;
+        }
+    }
+
+    const int64_t n = int64_t(channels);
+    const int64_t mean_q = rms ? 0 : S / n;
+    int64_t var_q = SQ / n - ((mean_q * mean_q) >> G);
+    if (var_q < 0) var_q = 0;
+
+    // eps EN UNIDADES DE V = 2^(2 (Emax - bias - wm) - G)
+    const float eps_v = std::ldexp(eps, G - 2 * (Emax - Cfg::bias_bfp - Cfg::wm));
+    var_q += (eps_v >= 4.0e18f) ? int64_t(4000000000000000000LL) : int64_t(eps_v);
+
+    uint32_t y = 0;
+    int e = 0;
+    if (var_q > 0) bfp_rsqrt_q16(uint64_t(var_q), y, e);
+    const int out_shift = -(BFP_NORM_RSQRT_FRAC + e / 2 + G / 2);
+
+    for (int b = 0; b < row_blocks; b++) {
+        bfp_norm_align<Cfg, Block_size>(row[b], Emax, s, sq);
+        std::array<float, Block_size> ys{};
+        for (std::size_t l = 0; l < Block_size; l++) {
+            const std::size_t c = std::size_t(b) * Block_size + l;
+            const float xn = std::ldexp(float((s[l] - mean_q) * int64_t(y)), out_shift);
+            ys[l] = (int(c) >= channels) ? 0.0f : rms ? xn * gamma[c] : xn * gamma[c] + beta[c];
+        }
+        out[b] = encode_block<Cfg, Block_size>(ys, st, rng);
+        st.template record_block<Block_size>(out[b]);
+    }
+}
+
+//* TODAS LAS FILAS; LAS FILAS SE REPARTEN ENTRE HILOS
+// LA FILA r REDONDEA CON LA SUBSECUENCIA r DE rng (STOCH): EL RESULTADO NO
+// DEPENDE DEL NUMERO DE HILOS
+// CADA FILA TIENE gamma.size() CANALES: SI NO ES MULTIPLO DE Block_size, EL
+// ULTIMO BLOQUE DE CADA FILA ES PARCIAL
+// COMO rows_ok EN HW/bfp_kernel.cpp, UNA FORMA INVALIDA SE RECHAZA (SALIDA
+// VACIA): row_blocks <= 0, x.size() NO MULTIPLO DE row_blocks (LA ULTIMA FILA
+// QUEDARIA INCOMPLETA), gamma VACIO O beta MAS CORTO QUE gamma EN LAYERNORM
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+std::vector<Blk> bfp_norm_rows(const std::vector<Blk>& x, int row_blocks,
+                               const std::vector<float>& gamma,
+                               const std::vector<float>& beta,
+                               bool rms, float eps, const BFP_Rng& rng,
+                               unsigned n_threads = std::thread::hardware_concurrency()) {
+    if (row_blocks <= 0 || x.size() % std::size_t(row_blocks) != 0) return {};
+    const int rows = int(x.size()) / row_blocks;
+    const int channels = std::min(int(gamma.size()), row_blocks * int(Block_size));
+    if (channels <= 0 || (!rms && beta.size() < std::size_t(channels))) return {};
+    std::vector<Blk> out(x.size());
+
+    auto work = [&](int r0, int r1) {
+        BFP_Stats<Cfg> st{};
+        for (int r = r0; r < r1; r++) {
+            BFP_Rng row_rng = rng.stream(uint64_t(r));
+            bfp_norm_row<Cfg, Block_size, Blk>(&x[std::size_t(r) * row_blocks], row_blocks, channels,
+                                               gamma.data(), beta.data(),
+                                               rms, eps, &out[std::size_t(r) * row_blocks], st, row_rng);
+        }
+    };
+
+    if (n_threads == 0) n_threads = 1;
+    n_threads = std::min<unsigned>(n_threads, unsigned(std::max(rows, 1)));
+    std::vector<std::thread> pool;
+    const int rows_per = (rows + int(n_threads) - 1) / int(n_threads);
+    for (unsigned t = 0; t < n_threads; t++) {
+        const int r0 = int(t) * rows_per;
+        const int r1 = std::min(rows, r0 + rows_per);
+        if (r0 < r1) pool.emplace_back(work, r0, r1);
+    }
+    for (auto& th : pool) th.join();
+    return out;
+}
+
+// STOCH: rng SEMBRADO OBLIGATORIO; SIN rng SOLO COMPILAN LOS MODOS DETERMINISTAS
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+std::vector<Blk> layernorm_bfp(const std::vector<Blk>& x, int row_blocks,
+                               const std::vector<float>& gamma,
+                               const std::vector<float>& beta,
+                               const BFP_Rng& rng, float eps = 1e-5f,
+                               unsigned n_threads = std::thread::hardware_concurrency()) {
+    return bfp_norm_rows<Cfg, Block_size, Blk>(x, row_blocks, gamma, beta, false, eps, rng, n_threads);
+}
+
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+std::vector<Blk> layernorm_bfp(const std::vector<Blk>& x, int row_blocks,
+                               const std::vector<float>& gamma,
+                               const std::vector<float>& beta,
+                               float eps = 1e-5f,
+                               unsigned n_threads = std::thread::hardware_concurrency()) {
+    return layernorm_bfp<Cfg, Block_size, Blk>(x, row_blocks, gamma, beta, bfp_no_rng<Cfg>(), eps, n_threads);
+}
+
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+std::vector<Blk> rmsnorm_bfp(const std::vector<Blk>& x, int row_blocks,
+                             const std::vector<float>& gamma,
+                             const BFP_Rng& rng, float eps = 1e-5f,
+                             unsigned n_threads = std::thread::hardware_concurrency()) {
+    return bfp_norm_rows<Cfg, Block_size, Blk>(x, row_blocks, gamma, gamma, true, eps, rng, n_threads);
+}
+
+template<class Cfg, std::size_t Block_size, class Blk = BFP_Global<Cfg, Block_size>>
+std::vector<Blk> rmsnorm_bfp(const std::vector<Blk>& x, int row_blocks,
+                             const std::vector<float>& gamma,
+                             float eps = 1e-5f,
+                             unsigned n_threads = std::thread::hardware_concurrency()) {
+    return rmsnorm_bfp<Cfg, Block_size, Blk>(x, row_blocks, gamma, bfp_no_rng<Cfg>(), eps, n_threads);
+}
+
+#endif // BFP_NORM_H
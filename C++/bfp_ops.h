@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include "bfp.h"
 
 // Utilidad local para clamp de exponente real a WE bits (sesgado)
@@ -18,7 +19,8 @@ static inline uint32_t clamp_E_to_bfp(int Er){
 // ALINEAR + SUMAR CON SIGNO + NORMALIZAR
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
-                                        const BFP_Global<Cfg, Block_size>& B){
+                                        const BFP_Global<Cfg, Block_size>& B,
+                                        BFP_Stats<Cfg>& st, BFP_Rng& rng){
 
     BFP_Global<Cfg, Block_size> Z{};
 
@@ -39,8 +41,8 @@ BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
     std::array<uint32_t, Block_size> Sgn{};
 
     for (std::size_t i = 0; i < Block_size; ++i) {
-        const uint32_t Ma = (shiftA >= 32) ? 0u : helper_rne(A.mant[i], shiftA);
-        const uint32_t Mb = (shiftB >= 32) ? 0u : helper_rne(B.mant[i], shiftB);
+        const uint32_t Ma = (shiftA >= 32) ? 0u : uint32_t(helper_round<Cfg>(A.mant[i], shiftA, rng));
+        const uint32_t Mb = (shiftB >= 32) ? 0u : uint32_t(helper_round<Cfg>(B.mant[i], shiftB, rng));
 
         const int32_t Sa = A.sign[i] ? -int32_t(Ma) : int32_t(Ma);
         const int32_t Sb = B.sign[i] ? -int32_t(Mb) : int32_t(Mb);
@@ -59,11 +61,12 @@ BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
     // 3) Normalización global (con saturación de exponente si hiciera falta)
     int E = E_base;
     if (overflow_any) {
-        // sube exponente y divide mantisas por 2 con RNE
+        // sube exponente y divide mantisas por 2 (redondeo Cfg::rnd)
         ++E;
         for (std::size_t i = 0; i < Block_size; ++i) {
-            uint32_t m = helper_rne(Mag[i], 1);
-            if (m > MANT_MAX) m = MANT_MAX;
+            uint32_t m = uint32_t(helper_round<Cfg>(Mag[i], 1, rng));
+            if (m > MANT_MAX) { m = MANT_MAX; st.mant_sat++; }
+            if (m == 0u && Mag[i] != 0u) st.flush_zero++;
             Mag[i] = m;
             if (Mag[i] == 0u) Sgn[i] = 0u; // -0 → +0
         }
@@ -84,7 +87,7 @@ BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
             E -= shl;
             for (std::size_t i = 0; i < Block_size; ++i) {
                 uint64_t up = (uint64_t)Mag[i] << shl;
-                if (up > MANT_MAX) up = MANT_MAX;
+                if (up > MANT_MAX) { up = MANT_MAX; st.mant_sat++; }
                 Mag[i] = (uint32_t)up;
                 if (Mag[i] == 0u) Sgn[i] = 0u;
             }
@@ -93,6 +96,7 @@ BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
 
     // 4) Salida (Δ_out = 0)
     Z.exp_shared = clamp_E_to_bfp<Cfg>(E);
+    count_exp_clamp<Cfg>(E, st);
     for (std::size_t i = 0; i < Block_size; ++i) {
         Z.mant[i]  = Mag[i];
         Z.sign[i]  = (Mag[i] == 0u) ? 0u : Sgn[i];
@@ -111,7 +115,8 @@ BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size>
 sub_blocks(const BFP_Global<Cfg, Block_size>& A,
-           const BFP_Global<Cfg, Block_size>& B)
+           const BFP_Global<Cfg, Block_size>& B,
+           BFP_Stats<Cfg>& st, BFP_Rng& rng)
 {
 
     BFP_Global<Cfg, Block_size> Bneg = B;
@@ -120,15 +125,16 @@ sub_blocks(const BFP_Global<Cfg, Block_size>& A,
         if (Bneg.mant[i] == 0u) {Bneg.sign[i] = 0u;}          // FORZAR CERO 
         else { Bneg.sign[i] = Bneg.sign[i] ^ 1u;} // INVIERTE SIGNO
     }
-    return add_blocks<Cfg, Block_size>(A, Bneg);
+    return add_blocks<Cfg, Block_size>(A, Bneg, st, rng);
 }
 
 
 //* MULTIPLICACION  
-// PRODUCTO + SHIFT + NORMALIZACION
+// PRODUCTO EXACTO + UN SOLO REDONDEO AL EXPONENTE FINAL (COMO HW/bfp_ops_hls.h)
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg,Block_size> mul_blocks(const BFP_Global<Cfg,Block_size> &A,
-                                       const BFP_Global<Cfg,Block_size> &B){
+                                       const BFP_Global<Cfg,Block_size> &B,
+                                       BFP_Stats<Cfg>& st, BFP_Rng& rng){
 
     BFP_Global<Cfg, Block_size> Z{};
 
@@ -140,63 +146,52 @@ BFP_Global<Cfg,Block_size> mul_blocks(const BFP_Global<Cfg,Block_size> &A,
     // FIX: Exponente del producto por bloque (constante)
     int E = Ea + Eb;
 
-    bool overflow_any = false;
+    std::array<uint64_t, Block_size> P{};
     std::array<uint32_t, Block_size> Mag{};
     std::array<uint32_t, Block_size> Sgn{};
+    uint64_t max_P = 0u;
 
     for (std::size_t i = 0; i < Block_size; ++i) {
-        uint32_t sign = A.sign[i] ^ B.sign[i];
-
-        // Producto de mantisas (hasta ~2*(WM+1) bits), reducir a 2^WM con RNE
-        const uint64_t P    = uint64_t(A.mant[i]) * uint64_t(B.mant[i]);
-        uint64_t q    = P >> Cfg::wm;
-        uint64_t rem  = P & ((uint64_t(1) << Cfg::wm) - 1);
-        const uint64_t half = uint64_t(1) << (Cfg::wm - 1);
-        if (rem > half || (rem == half && (q & 1u))) ++q;
-
-        uint32_t m = (uint32_t)q; // FIX: sin alineos por i (Δ ya pagado en encode)
-
-        if (m == 0u) sign = 0u;
-        Sgn[i] = sign;
-        Mag[i] = m;
-
-        if (m > MANT_MAX) overflow_any = true;
+        Sgn[i] = A.sign[i] ^ B.sign[i];
+        // Producto exacto de mantisas (hasta 2*(WM+1) bits): se redondea despues
+        P[i] = uint64_t(A.mant[i]) * uint64_t(B.mant[i]);
+        if (P[i] > max_P) max_P = P[i];
     }
 
-    // 3) Normalización global
-    if (overflow_any) {
-        ++E;
-        for (std::size_t i = 0; i < Block_size; ++i) {
-            uint32_t m = helper_rne(Mag[i], 1);
-            if (m > MANT_MAX) m = MANT_MAX;
-            Mag[i] = m;
-            if (Mag[i] == 0u) Sgn[i] = 0u;
-        }
-    } else {
-        uint32_t max_mag = 0u;
-        for (auto v : Mag) if (v > max_mag) max_mag = v;
+    if (max_P == 0u) {
+        Z.exp_shared = 0; Z.sign.fill(0u); Z.mant.fill(0u); Z.delta.fill(0);
+        return Z;
+    }
 
-        if (max_mag == 0u) {
-            Z.exp_shared = 0; Z.sign.fill(0u); Z.mant.fill(0u); Z.delta.fill(0);
-            return Z;
-        }
+    // 3) Normalización global: el mayor producto queda con su MSB en WM
+    // (shift = msb - WM, negativo = llenado). Si su redondeo llega a 2^(WM+1)
+    // (acarreo), shift + 1: cada lane se redondea UNA vez con el exponente
+    // final, sin el doble redondeo WM -> WM-1
+    int msb = 0;
+    for (int b = 2 * Cfg::wm + 1; b >= 0; --b) if ((max_P >> b) & 1u) { msb = b; break; }
+    int shift = msb - Cfg::wm;
+    if (shift > 0) {
+        const uint64_t top = max_P >> shift;
+        const uint64_t low = max_P & ((uint64_t(1) << shift) - 1u);
+        // Estocastico: cualquier bit descartado puede redondear hacia arriba
+        const bool carry = (Cfg::rnd == BFP_RND_STOCH)
+                         ? (top == MANT_MAX && low != 0u)
+                         : (bfp_round_shr<typename Cfg::round>(max_P, shift) > MANT_MAX);
+        if (carry) shift++;
+    }
+    E += shift - Cfg::wm;
 
-        int msb = -1;
-        for (int b = Cfg::wm + 1; b >= 0; --b) if (max_mag & (1u << b)) { msb = b; break; }
-        if (msb < Cfg::wm) {
-            int shl = Cfg::wm - msb;
-            E -= shl;
-            for (std::size_t i = 0; i < Block_size; ++i) {
-                uint64_t up = (uint64_t)Mag[i] << shl;
-                if (up > MANT_MAX) up = MANT_MAX;
-                Mag[i] = (uint32_t)up;
-                if (Mag[i] == 0u) Sgn[i] = 0u;
-            }
-        }
+    for (std::size_t i = 0; i < Block_size; ++i) {
+        uint32_t m = uint32_t(helper_round<Cfg>(P[i], shift, rng));
+        if (m > MANT_MAX) { m = MANT_MAX; st.mant_sat++; }
+        if (m == 0u && P[i] != 0u) st.flush_zero++;
+        Mag[i] = m;
+        if (Mag[i] == 0u) Sgn[i] = 0u;
     }
 
     // 4) Construir salida (Δ_out = 0)
     Z.exp_shared = clamp_E_to_bfp<Cfg>(E);
+    count_exp_clamp<Cfg>(E, st);
     for (std::size_t i = 0; i < Block_size; ++i) {
         Z.mant[i]  = Mag[i];
         Z.sign[i]  = (Mag[i] == 0u) ? 0u : Sgn[i];
@@ -216,7 +211,8 @@ BFP_Global<Cfg,Block_size> mul_blocks(const BFP_Global<Cfg,Block_size> &A,
 //* RECIPROCO (1/B) 
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size>
-rcp_blocks(const BFP_Global<Cfg, Block_size>& B)
+rcp_blocks(const BFP_Global<Cfg, Block_size>& B,
+           BFP_Stats<Cfg>& st)
 {
     BFP_Global<Cfg, Block_size> R{};
 
@@ -235,6 +231,7 @@ rcp_blocks(const BFP_Global<Cfg, Block_size>& B)
     for (std::size_t i = 0; i < Block_size; ++i) {
         if (B.mant[i] == 0u) {
             // 1/0 -> saturación representable
+            st.inf_count++;
             Mag[i] = MANT_MAX;
             Sgn[i] = B.sign[i];
             continue;
@@ -242,12 +239,12 @@ rcp_blocks(const BFP_Global<Cfg, Block_size>& B)
 
         uint32_t sign = B.sign[i];
 
-        // qq ≈ (1 / mant_Bi) * 2^WM = (2^(2*WM)) / mant_Bi, con RNE
+        // qq ≈ (1 / mant_Bi) * 2^WM = (2^(2*WM)) / mant_Bi, redondeado con Cfg::round
         const uint64_t Num = 1ull << (2 * Cfg::wm); // 1/mant -> 2^(mant)
         const uint64_t Den = (uint64_t)B.mant[i];
         uint64_t qq  = Num / Den;
-        uint64_t rem = Num % Den;
-        if ( (rem << 1) > Den || ((rem << 1) == Den && (qq & 1ull)) ) ++qq;
+        const uint64_t rem2 = (Num % Den) << 1;
+        qq = Cfg::round::step(qq, (rem2 > Den) ? 1 : (rem2 == Den) ? 0 : -1);
 
         uint32_t m = (uint32_t)qq; // FIX: sin realineos por i
 
@@ -262,8 +259,9 @@ rcp_blocks(const BFP_Global<Cfg, Block_size>& B)
     if (overflow_any) {
         ++E;
         for (std::size_t i = 0; i < Block_size; ++i) {
-            uint32_t m = helper_rne(Mag[i], 1);
-            if (m > MANT_MAX) m = MANT_MAX;
+            uint32_t m = uint32_t(bfp_round_shr<typename Cfg::round>(Mag[i], 1)); // SIN SORTEO, COMO HW
+            if (m > MANT_MAX) { m = MANT_MAX; st.mant_sat++; }
+            if (m == 0u && Mag[i] != 0u) st.flush_zero++;
             Mag[i] = m;
             if (Mag[i] == 0u) Sgn[i] = 0u;
         }
@@ -283,7 +281,7 @@ rcp_blocks(const BFP_Global<Cfg, Block_size>& B)
             E -= shl;
             for (std::size_t i = 0; i < Block_size; ++i) {
                 uint64_t up = (uint64_t)Mag[i] << shl;
-                if (up > MANT_MAX) up = MANT_MAX;
+                if (up > MANT_MAX) { up = MANT_MAX; st.mant_sat++; }
                 Mag[i] = (uint32_t)up;
                 if (Mag[i] == 0u) Sgn[i] = 0u;
             }
@@ -292,6 +290,7 @@ rcp_blocks(const BFP_Global<Cfg, Block_size>& B)
 
     // 4) Salida (Δ_out = 0)
     R.exp_shared = clamp_E_to_bfp<Cfg>(E);
+    count_exp_clamp<Cfg>(E, st);
     for (std::size_t i = 0; i < Block_size; ++i) {
         R.mant[i]  = Mag[i];
         R.sign[i]  = (Mag[i] == 0u) ? 0u : Sgn[i];
@@ -312,10 +311,689 @@ rcp_blocks(const BFP_Global<Cfg, Block_size>& B)
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size>
 div_blocks(const BFP_Global<Cfg, Block_size>& A,
-           const BFP_Global<Cfg, Block_size>& B)
+           const BFP_Global<Cfg, Block_size>& B,
+           BFP_Stats<Cfg>& st, BFP_Rng& rng)
 {
-    auto R = rcp_blocks<Cfg, Block_size>(B);
-    return mul_blocks<Cfg, Block_size>(A, R); // A/R -> 1/B -> A(1/B)
+    auto R = rcp_blocks<Cfg, Block_size>(B, st);
+    return mul_blocks<Cfg, Block_size>(A, R, st, rng); // A/R -> 1/B -> A(1/B)
+}
+
+
+//* ACTIVACIONES POR TABLA (GELU, SiLU, tanh, sigmoid, exp), MISMAS TABLAS QUE HW/bfp_act_hls.h
+// |x| DE UN LANE ESTA EN LA OCTAVA [2^e, 2^(e+1)), e = E - bias - wm + p (p = 1 MAS ALTO DE mant).
+// LA TABLA SE INDEXA CON (SIGNO, e, BITS ALTOS DE LA FRACCION) E INTERPOLA CON EL RESTO.
+// FUERA DE [2^ACT_E_LO, 2^ACT_E_HI): TAYLOR (x PEQUEÑO) O SATURACION (exp -> Inf / 0).
+// TABLAS constexpr GENERADAS POR BFP_bias<WE, WM> (EXACTAS SI WM < ACT_TABLE_BITS).
+enum : unsigned int {
+    ACT_GELU    = 0,
+    ACT_SILU    = 1,
+    ACT_TANH    = 2,
+    ACT_SIGMOID = 3,
+    ACT_EXP     = 4,
+    ACT_KINDS   = 5
+};
+
+static constexpr int ACT_E_LO       = -8;
+static constexpr int ACT_E_HI       = 4;
+static constexpr int ACT_OCTAVES    = ACT_E_HI - ACT_E_LO;
+static constexpr int ACT_TABLE_BITS = 6;
+
+constexpr double act_ce_exp(double x) {
+    constexpr double LN2 = 0.69314718055994530942;
+    if (x > 700.0) return std::numeric_limits<double>::infinity();
+    if (x < -700.0) return 0.0;
+    int k = int(x / LN2 + (x >= 0.0 ? 0.5 : -0.5));
+    const double r = x - double(k) * LN2;
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 24; n++) {
+        term *= r / double(n);
+        sum += term;
+    }
+    for (; k > 0; k--) sum *= 2.0;
+    for (; k < 0; k++) sum *= 0.5;
+    return sum;
+}
+
+constexpr double act_ce_erf(double z) {
+    constexpr double SQRT_PI = 1.77245385090551602730;
+    const bool neg = z < 0.0;
+    if (neg) z = -z;
+    double r = 0.0;
+    if (z < 2.5) {
+        double term = z, sum = z;               // TAYLOR
+        for (int n = 1; n < 64; n++) {
+            term *= -z * z / double(n);
+            sum += term / double(2 * n + 1);
+        }
+        r = 2.0 / SQRT_PI * sum;
+    } else {
+        double f = z;                           // FRACCION CONTINUA DE erfc
+        for (int k = 60; k >= 1; k--) f = z + (double(k) / 2.0) / f;
+        r = 1.0 - act_ce_exp(-z * z) / (SQRT_PI * f);
+    }
+    return neg ? -r : r;
+}
+
+constexpr double act_ce_eval(unsigned int kind, double x) {
+    constexpr double INV_SQRT2 = 0.70710678118654752440;
+    switch (kind) {
+        case ACT_GELU:    return 0.5 * x * (1.0 + act_ce_erf(x * INV_SQRT2));
+        case ACT_SILU:    return x / (1.0 + act_ce_exp(-x));
+        case ACT_TANH:    return 1.0 - 2.0 / (act_ce_exp(2.0 * x) + 1.0);
+        case ACT_SIGMOID: return 1.0 / (1.0 + act_ce_exp(-x));
+        default:          return act_ce_exp(x);
+    }
+}
+
+// v[SIGNO][OCTAVA][NODO], NODO k DE LA OCTAVA e: (1 + k / 2^T) * 2^e
+template<class Cfg, unsigned int Kind>
+struct BFP_ActTable {
+    static constexpr int bits = (Cfg::wm < ACT_TABLE_BITS) ? Cfg::wm : ACT_TABLE_BITS;
+    static constexpr int segs = 1 << bits;
+
+    float v[2][ACT_OCTAVES][segs + 1];
+
+    constexpr BFP_ActTable() : v{} {
+        for (int s = 0; s < 2; s++) {
+            for (int o = 0; o < ACT_OCTAVES; o++) {
+                double scale = 1.0;
+                for (int e = ACT_E_LO + o; e > 0; e--) scale *= 2.0;
+                for (int e = ACT_E_LO + o; e < 0; e++) scale *= 0.5;
+                for (int k = 0; k <= segs; k++) {
+                    const double x = (1.0 + double(k) / double(segs)) * scale;
+                    v[s][o][k] = float(act_ce_eval(Kind, s ? -x : x));
+                }
+            }
+        }
+    }
+};
+
+template<class Cfg, unsigned int Kind>
+float act_lane(uint32_t sign, uint32_t mant, uint32_t exp_shared) {
+    static constexpr BFP_ActTable<Cfg, Kind> tbl{};
+    constexpr int bits = BFP_ActTable<Cfg, Kind>::bits;
+
+    if (mant == 0u) return (Kind == ACT_SIGMOID) ? 0.5f : (Kind == ACT_EXP) ? 1.0f : 0.0f;
+
+    int p = Cfg::wm;
+    while (p > 0 && !((mant >> p) & 1u)) p--;
+    const int e = int(exp_shared) - Cfg::bias_bfp - Cfg::wm + p;
+
+    if (e < ACT_E_LO || e >= ACT_E_HI) {
+        const float x = std::ldexp(sign ? -float(mant) : float(mant),
+                                   int(exp_shared) - Cfg::bias_bfp - Cfg::wm);
+        if (e < ACT_E_LO) {                     // x PEQUEÑO: TAYLOR
+            switch (Kind) {
+                case ACT_GELU:    return 0.5f * x + 0.3989422804f * x * x;
+                case ACT_SILU:    return 0.5f * x + 0.25f * x * x;
+                case ACT_TANH:    return x;
+                case ACT_SIGMOID: return 0.5f + 0.25f * x;
+                default:          return 1.0f + x;
+            }
+        }
+        switch (Kind) {                         // SATURACION
+            case ACT_GELU:
+            case ACT_SILU:    return sign ? 0.0f : x;
+            case ACT_TANH:    return sign ? -1.0f : 1.0f;
+            case ACT_SIGMOID: return sign ? 0.0f : 1.0f;
+            default:          return sign ? 0.0f : std::numeric_limits<float>::infinity();
+        }
+    }
+
+    const uint32_t frac = (mant << (Cfg::wm - p)) & ((1u << Cfg::wm) - 1u);
+    const uint32_t idx  = frac >> (Cfg::wm - bits);
+    const uint32_t rem  = frac & ((1u << (Cfg::wm - bits)) - 1u);
+    const float t  = std::ldexp(float(rem), bits - Cfg::wm);
+    const float lo = tbl.v[sign][e - ACT_E_LO][idx];
+    const float hi = tbl.v[sign][e - ACT_E_LO][idx + 1];
+    return lo + (hi - lo) * t;
+}
+
+template<class Cfg, std::size_t Block_size, unsigned int Kind>
+BFP_Global<Cfg, Block_size> act_block(const BFP_Global<Cfg, Block_size>& A,
+                                      BFP_Stats<Cfg>& st, BFP_Rng& rng) {
+    std::array<float, Block_size> ys{};
+    for (std::size_t i = 0; i < Block_size; i++) ys[i] = act_lane<Cfg, Kind>(A.sign[i], A.mant[i], A.exp_shared);
+    return encode_block<Cfg, Block_size>(ys, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> act_blocks(unsigned int kind,
+                                       const BFP_Global<Cfg, Block_size>& A,
+                                       BFP_Stats<Cfg>& st, BFP_Rng& rng) {
+    switch (kind) {
+        case ACT_GELU:    return act_block<Cfg, Block_size, ACT_GELU>(A, st, rng);
+        case ACT_SILU:    return act_block<Cfg, Block_size, ACT_SILU>(A, st, rng);
+        case ACT_TANH:    return act_block<Cfg, Block_size, ACT_TANH>(A, st, rng);
+        case ACT_SIGMOID: return act_block<Cfg, Block_size, ACT_SIGMOID>(A, st, rng);
+        default:          return act_block<Cfg, Block_size, ACT_EXP>(A, st, rng);
+    }
+}
+
+
+//* ACUMULADOR ANCHO POR LANE (MISMO ALGORITMO QUE BFP_Accum EN HW/bfp_dot_hls.h)
+// UN ENTERO ANCHO POR LANE Y UN SOLO EXPONENTE:  valor_i = acc[i] * 2^(acc_e - bias - wm - GuardBits)
+// add() SOLO ALINEA AL EXPONENTE MAYOR (SIN REDONDEAR A WM BITS EN CADA PASO);
+// to_block() HACE EL UNICO REDONDEO (POLITICA Cfg::round) DE VUELTA A BFP_Global.
+template<class Cfg, std::size_t Block_size, int GuardBits = 24>
+struct BFP_Accum {
+    static constexpr int guard = GuardBits;
+    static_assert(GuardBits >= 0 && 2 * (Cfg::wm + 1) + GuardBits <= 48,
+                  "BFP_Accum: GuardBits deja menos de 15 bits de margen en int64");
+
+    std::array<int64_t, Block_size> acc{};
+    int  acc_e = 0;
+    bool empty = true;
+
+    void clear() { acc.fill(0); acc_e = 0; empty = true; }
+
+    // LANES CON SIGNO p, VALOR p * 2^(e - bias - wm)
+    void add_lanes(const std::array<int64_t, Block_size>& p, int e) {
+        int d_acc = 0, d_in = 0;
+        if (empty)          { acc_e = e; empty = false; }
+        else if (e > acc_e) { d_acc = e - acc_e; acc_e = e; }
+        else                { d_in = acc_e - e; }
+
+        for (std::size_t i = 0; i < Block_size; ++i) {
+            const int64_t q = p[i] * (int64_t(1) << GuardBits);
+            const int64_t a = (d_acc >= 63) ? (acc[i] < 0 ? -1 : 0) : (acc[i] >> d_acc);
+            const int64_t b = (d_in >= 63) ? (q < 0 ? -1 : 0) : (q >> d_in);
+            acc[i] = a + b;
+        }
+    }
+
+    void add(const BFP_Global<Cfg, Block_size>& B) {
+        std::array<int64_t, Block_size> p{};
+        for (std::size_t i = 0; i < Block_size; ++i)
+            p[i] = B.sign[i] ? -int64_t(B.mant[i]) : int64_t(B.mant[i]);
+        add_lanes(p, int(B.exp_shared));
+    }
+
+    void sub(const BFP_Global<Cfg, Block_size>& B) {
+        std::array<int64_t, Block_size> p{};
+        for (std::size_t i = 0; i < Block_size; ++i)
+            p[i] = B.sign[i] ? int64_t(B.mant[i]) : -int64_t(B.mant[i]);
+        add_lanes(p, int(B.exp_shared));
+    }
+
+    // acc += A * B LANE A LANE (EXPONENTE Ea + Eb - bias - wm)
+    void mac(const BFP_Global<Cfg, Block_size>& A, const BFP_Global<Cfg, Block_size>& B) {
+        std::array<int64_t, Block_size> p{};
+        for (std::size_t i = 0; i < Block_size; ++i) {
+            const int64_t prod = int64_t(A.mant[i]) * int64_t(B.mant[i]);
+            p[i] = (A.sign[i] ^ B.sign[i]) ? -prod : prod;
+        }
+        add_lanes(p, int(A.exp_shared) + int(B.exp_shared) - Cfg::bias_bfp - Cfg::wm);
+    }
+
+    // SUMA DE LOS LANES (PRODUCTO PUNTO / REDUCCION COMPLETA)
+    double sum_lanes() const {
+        int64_t s = 0;
+        for (auto a : acc) s += a;
+        return std::ldexp(double(s), acc_e - Cfg::bias_bfp - Cfg::wm - GuardBits);
+    }
+
+    double to_double(std::size_t i) const {
+        return std::ldexp(double(acc[i]), acc_e - Cfg::bias_bfp - Cfg::wm - GuardBits);
+    }
+
+    // REDONDEO DE 64 BITS (Cfg::round); shift < 0 DESPLAZA A LA IZQUIERDA (SATURANDO)
+    static uint64_t round64(uint64_t x, int shift) {
+        if (shift <= 0) {
+            const int s = -shift;
+            if (s >= 63 || (x >> (63 - s)) != 0) return ~uint64_t(0) >> 1;
+            return x << s;
+        }
+        return bfp_round_shr<typename Cfg::round>(x, shift);
+    }
+
+    // UNICO REDONDEO FINAL A WM+1 BITS CON EL EXPONENTE DEL LANE MAYOR (Δ_out = 0)
+    BFP_Global<Cfg, Block_size> to_block(BFP_Stats<Cfg>& st) const {
+        BFP_Global<Cfg, Block_size> Z{};
+        const uint32_t MANT_MAX = (1u << (Cfg::wm + 1)) - 1u;
+
+        uint64_t max_mag = 0;
+        for (auto a : acc) max_mag = std::max(max_mag, uint64_t(a < 0 ? -a : a));
+        if (max_mag == 0) {
+            Z.exp_shared = 0; Z.sign.fill(0u); Z.mant.fill(0u); Z.delta.fill(0);
+            return Z;
+        }
+
+        int msb = 63;
+        while (msb > 0 && !((max_mag >> msb) & 1u)) --msb;
+
+        // EXPONENTE REAL DEL BLOQUE (+1 SI EL REDONDEO LLEVA EL MAYOR A 2^(WM+1))
+        int E = acc_e - GuardBits + msb - Cfg::wm - Cfg::bias_bfp;
+        if (round64(max_mag, msb - Cfg::wm) > MANT_MAX) ++E;
+
+        count_exp_clamp<Cfg>(E, st);
+        Z.exp_shared = clamp_E_to_bfp<Cfg>(E);
+        const int shift = int(Z.exp_shared) - (acc_e - GuardBits);
+
+        bool all_zero = true;
+        for (std::size_t i = 0; i < Block_size; ++i) {
+            const uint64_t mag = uint64_t(acc[i] < 0 ? -acc[i] : acc[i]);
+            uint64_t m = round64(mag, shift);
+            if (m > MANT_MAX) { m = MANT_MAX; st.mant_sat++; }
+            if (m == 0 && mag != 0) st.flush_zero++;
+            Z.mant[i]  = uint32_t(m);
+            Z.sign[i]  = (m != 0 && acc[i] < 0) ? 1u : 0u;
+            Z.delta[i] = 0;
+            if (m != 0) all_zero = false;
+        }
+        if (all_zero) Z.exp_shared = 0;
+        return Z;
+    }
+
+    BFP_Global<Cfg, Block_size> to_block() const {
+        BFP_Stats<Cfg> st{};
+        return to_block(st);
+    }
+};
+
+//* REDUCCION DE n BLOQUES CON UN SOLO REDONDEO FINAL
+template<class Cfg, std::size_t Block_size, int GuardBits = 24>
+BFP_Global<Cfg, Block_size> reduce_blocks(const BFP_Global<Cfg, Block_size>* xs, std::size_t n,
+                                          BFP_Stats<Cfg>& st){
+    BFP_Accum<Cfg, Block_size, GuardBits> acc;
+    for (std::size_t b = 0; b < n; ++b) acc.add(xs[b]);
+    return acc.to_block(st);
+}
+
+//* PRODUCTO PUNTO DE DOS VECTORES DE n BLOQUES (UN SOLO REDONDEO, A DOUBLE)
+template<class Cfg, std::size_t Block_size, int GuardBits = 24>
+double dot_blocks(const BFP_Global<Cfg, Block_size>* a, const BFP_Global<Cfg, Block_size>* b,
+                  std::size_t n){
+    BFP_Accum<Cfg, Block_size, GuardBits> acc;
+    for (std::size_t k = 0; k < n; ++k) acc.mac(a[k], b[k]);
+    return acc.sum_lanes();
+}
+
+
+//* OPERANDO ESCALAR Y BROADCAST (MISMA SEMANTICA QUE OP_*_SCALAR / OP_*_BCAST EN HW/bfp_kernel.cpp)
+// ESCALAR:   z[i] = a[i] op s, CON s CODIFICADO UNA SOLA VEZ EN LOS N LANES
+// BROADCAST: z[i] = a[i] op b[i % nb]  (nb BLOQUES DE B REUSADOS: BIAS / ESCALA POR CANAL)
+enum : unsigned int {
+    ARITH_ADD = 0,
+    ARITH_SUB = 1,
+    ARITH_MUL = 2,
+    ARITH_DIV = 3
+};
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> arith_blocks(unsigned int kind,
+                                         const BFP_Global<Cfg, Block_size>& A,
+                                         const BFP_Global<Cfg, Block_size>& B,
+                                         BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    switch (kind) {
+        case ARITH_ADD: return add_blocks<Cfg, Block_size>(A, B, st, rng);
+        case ARITH_SUB: return sub_blocks<Cfg, Block_size>(A, B, st, rng);
+        case ARITH_MUL: return mul_blocks<Cfg, Block_size>(A, B, st, rng);
+        default:        return div_blocks<Cfg, Block_size>(A, B, st, rng);
+    }
+}
+
+// EL ESCALAR SE CODIFICA UNA VEZ CON EL REDONDEO DETERMINISTA DEL MODO (STOCH
+// USA RNE), COMO EN HW: TODOS LOS LANES Y BLOQUES VEN EL MISMO B
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> splat_block(float s, BFP_Stats<Cfg>& st){
+    using D = BFP_bias<Cfg::we, Cfg::wm, (Cfg::rnd == BFP_RND_STOCH) ? int(BFP_RND_RNE) : Cfg::rnd>;
+    std::array<float, Block_size> xs;
+    xs.fill(s);
+    BFP_Stats<D> sd{};
+    const BFP_Global<D, Block_size> S = encode_block<D, Block_size>(xs, sd);
+    st.merge(sd);
+
+    BFP_Global<Cfg, Block_size> B{};
+    B.exp_shared = S.exp_shared;
+    B.sign       = S.sign;
+    B.mant       = S.mant;
+    B.delta      = S.delta;
+    return B;
+}
+
+template<class Cfg, std::size_t Block_size>
+void scalar_blocks(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n, float s,
+                   BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    const auto B = splat_block<Cfg, Block_size>(s, st);
+    for (std::size_t i = 0; i < n; ++i) z[i] = arith_blocks<Cfg, Block_size>(kind, a[i], B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void bcast_blocks(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n,
+                  const BFP_Global<Cfg, Block_size>* b, std::size_t nb,
+                  BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        z[i] = arith_blocks<Cfg, Block_size>(kind, a[i], b[j], st, rng);
+        j = (j + 1 == nb) ? 0 : j + 1;
+    }
+}
+
+
+//* TENSORES DE LONGITUD ARBITRARIA (MISMA SEMANTICA QUE n_elements EN HW/bfp_kernel.cpp)
+// EL ULTIMO BLOQUE PUEDE TENER MENOS DE Block_size LANES VALIDOS. LOS LANES
+// INVALIDOS LLEVAN UNA COPIA DEL LANE 0 (NO CAMBIAN Emax NI LOS LANES VALIDOS,
+// TODAS LAS OPS SON LANE A LANE) Y SALEN A CERO; LA ENTRADA FP32 NO SE LEE MAS
+// ALLA DE n_elements
+template<std::size_t Block_size>
+inline std::size_t tail_lanes(std::size_t n_elements, std::size_t blk){
+    const std::size_t rest = n_elements - blk * Block_size;
+    return rest < Block_size ? rest : Block_size;
+}
+
+template<class Cfg, std::size_t Block_size>
+void fill_tail_lanes(BFP_Global<Cfg, Block_size>& X, std::size_t lanes){
+    for (std::size_t i = lanes; i < Block_size; ++i) {
+        X.sign[i] = X.sign[0];
+        X.mant[i] = X.mant[0];
+        X.delta[i] = X.delta[0];
+    }
+}
+
+template<class Cfg, std::size_t Block_size>
+void mask_tail_lanes(BFP_Global<Cfg, Block_size>& X, std::size_t lanes){
+    for (std::size_t i = lanes; i < Block_size; ++i) {
+        X.sign[i] = 0;
+        X.mant[i] = 0;
+        X.delta[i] = 0;
+    }
+}
+
+// x[0 .. n_elements) -> ceil(n_elements / Block_size) BLOQUES
+template<class Cfg, std::size_t Block_size>
+void encode_tensor(const float* x, std::size_t n_elements, BFP_Global<Cfg, Block_size>* z,
+                   BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    const std::size_t nb = (n_elements + Block_size - 1) / Block_size;
+    for (std::size_t b = 0; b < nb; ++b) {
+        const std::size_t lanes = tail_lanes<Block_size>(n_elements, b);
+        std::array<float, Block_size> xs;
+        for (std::size_t i = 0; i < Block_size; ++i) xs[i] = x[b * Block_size + (i < lanes ? i : 0)];
+        z[b] = encode_block<Cfg, Block_size>(xs, st, rng);
+        mask_tail_lanes<Cfg, Block_size>(z[b], lanes);
+    }
+}
+
+// SOLO SE ESCRIBEN LOS n_elements VALORES VALIDOS
+template<class Cfg, std::size_t Block_size>
+void decode_tensor(const BFP_Global<Cfg, Block_size>* a, std::size_t n_elements, float* y){
+    const std::size_t nb = (n_elements + Block_size - 1) / Block_size;
+    for (std::size_t b = 0; b < nb; ++b) {
+        const std::size_t lanes = tail_lanes<Block_size>(n_elements, b);
+        for (std::size_t i = 0; i < lanes; ++i) y[b * Block_size + i] = a[b].rebuild_FP32(i);
+    }
+}
+
+template<class Cfg, std::size_t Block_size>
+void arith_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a,
+                  const BFP_Global<Cfg, Block_size>* b, std::size_t n_elements,
+                  BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    const std::size_t nb = (n_elements + Block_size - 1) / Block_size;
+    for (std::size_t i = 0; i < nb; ++i) {
+        const std::size_t lanes = tail_lanes<Block_size>(n_elements, i);
+        BFP_Global<Cfg, Block_size> A = a[i], B = b[i];
+        fill_tail_lanes<Cfg, Block_size>(A, lanes);
+        fill_tail_lanes<Cfg, Block_size>(B, lanes);
+        z[i] = arith_blocks<Cfg, Block_size>(kind, A, B, st, rng);
+        mask_tail_lanes<Cfg, Block_size>(z[i], lanes);
+    }
+}
+
+//* OPERANDOS MIXTOS BFP x FP32 (MISMA SEMANTICA QUE OP_*_MIX EN HW/bfp_kernel.cpp)
+// a EN BFP (PESOS), b EN FP32 (ACTIVACIONES) CODIFICADO BLOQUE A BLOQUE DENTRO DEL
+// BUCLE: SIN PASADA encode_tensor PREVIA NI TENSOR BFP INTERMEDIO DE b.
+// SALIDA EN BFP (z) O EN FP32 (y, SOLO LOS n_elements VALORES VALIDOS)
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> mixed_block(unsigned int kind, const BFP_Global<Cfg, Block_size>& a,
+                                        const float* b, std::size_t lanes, BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    std::array<float, Block_size> xs;
+    for (std::size_t i = 0; i < Block_size; ++i) xs[i] = b[i < lanes ? i : 0];
+    BFP_Global<Cfg, Block_size> A = a;
+    fill_tail_lanes<Cfg, Block_size>(A, lanes);
+    const auto B = encode_block<Cfg, Block_size>(xs, st, rng);
+    auto Z = arith_blocks<Cfg, Block_size>(kind, A, B, st, rng);
+    mask_tail_lanes<Cfg, Block_size>(Z, lanes);
+    return Z;
+}
+
+template<class Cfg, std::size_t Block_size>
+void mixed_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, const float* b,
+                  std::size_t n_elements, BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    const std::size_t nb = (n_elements + Block_size - 1) / Block_size;
+    for (std::size_t i = 0; i < nb; ++i)
+        z[i] = mixed_block<Cfg, Block_size>(kind, a[i], b + i * Block_size,
+                                            tail_lanes<Block_size>(n_elements, i), st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void mixed_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, const float* b,
+                  std::size_t n_elements, float* y, BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    const std::size_t nb = (n_elements + Block_size - 1) / Block_size;
+    for (std::size_t i = 0; i < nb; ++i) {
+        const std::size_t lanes = tail_lanes<Block_size>(n_elements, i);
+        const auto Z = mixed_block<Cfg, Block_size>(kind, a[i], b + i * Block_size, lanes, st, rng);
+        for (std::size_t l = 0; l < lanes; ++l) y[i * Block_size + l] = Z.rebuild_FP32(l);
+    }
+}
+
+template<class Cfg, std::size_t Block_size>
+void act_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n_elements,
+                BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st, BFP_Rng& rng){
+    const std::size_t nb = (n_elements + Block_size - 1) / Block_size;
+    for (std::size_t i = 0; i < nb; ++i) {
+        const std::size_t lanes = tail_lanes<Block_size>(n_elements, i);
+        BFP_Global<Cfg, Block_size> A = a[i];
+        fill_tail_lanes<Cfg, Block_size>(A, lanes);
+        z[i] = act_blocks<Cfg, Block_size>(kind, A, st, rng);
+        mask_tail_lanes<Cfg, Block_size>(z[i], lanes);
+    }
+}
+
+//* VERSIONES SIN GENERADOR (MODOS DETERMINISTAS; STOCH NO COMPILA SIN BFP_Rng)
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B,
+                                        BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return add_blocks<Cfg, Block_size>(A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> sub_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B,
+                                        BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return sub_blocks<Cfg, Block_size>(A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> mul_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B,
+                                        BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return mul_blocks<Cfg, Block_size>(A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> div_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B,
+                                        BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return div_blocks<Cfg, Block_size>(A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size, unsigned int Kind>
+BFP_Global<Cfg, Block_size> act_block(const BFP_Global<Cfg, Block_size>& A,
+                                      BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return act_block<Cfg, Block_size, Kind>(A, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> act_blocks(unsigned int kind,
+                                       const BFP_Global<Cfg, Block_size>& A,
+                                       BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return act_blocks<Cfg, Block_size>(kind, A, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> arith_blocks(unsigned int kind,
+                                         const BFP_Global<Cfg, Block_size>& A,
+                                         const BFP_Global<Cfg, Block_size>& B,
+                                         BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    return arith_blocks<Cfg, Block_size>(kind, A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void scalar_blocks(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n, float s,
+                   BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    scalar_blocks<Cfg, Block_size>(kind, a, n, s, z, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void bcast_blocks(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n,
+                  const BFP_Global<Cfg, Block_size>* b, std::size_t nb,
+                  BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    bcast_blocks<Cfg, Block_size>(kind, a, n, b, nb, z, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void encode_tensor(const float* x, std::size_t n_elements, BFP_Global<Cfg, Block_size>* z,
+                   BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    encode_tensor<Cfg, Block_size>(x, n_elements, z, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void arith_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a,
+                  const BFP_Global<Cfg, Block_size>* b, std::size_t n_elements,
+                  BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    arith_tensor<Cfg, Block_size>(kind, a, b, n_elements, z, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void mixed_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, const float* b,
+                  std::size_t n_elements, BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    mixed_tensor<Cfg, Block_size>(kind, a, b, n_elements, z, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void mixed_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, const float* b,
+                  std::size_t n_elements, float* y, BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    mixed_tensor<Cfg, Block_size>(kind, a, b, n_elements, y, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+void act_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n_elements,
+                BFP_Global<Cfg, Block_size>* z, BFP_Stats<Cfg>& st){
+    BFP_Rng rng = bfp_no_rng<Cfg>();
+    act_tensor<Cfg, Block_size>(kind, a, n_elements, z, st, rng);
+}
+
+//* VERSIONES SIN CONTADORES (INTERFAZ ORIGINAL)
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B){
+    BFP_Stats<Cfg> st{};
+    return add_blocks<Cfg, Block_size>(A, B, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> sub_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B){
+    BFP_Stats<Cfg> st{};
+    return sub_blocks<Cfg, Block_size>(A, B, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> mul_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B){
+    BFP_Stats<Cfg> st{};
+    return mul_blocks<Cfg, Block_size>(A, B, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> rcp_blocks(const BFP_Global<Cfg, Block_size>& B){
+    BFP_Stats<Cfg> st{};
+    return rcp_blocks<Cfg, Block_size>(B, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> div_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                        const BFP_Global<Cfg, Block_size>& B){
+    BFP_Stats<Cfg> st{};
+    return div_blocks<Cfg, Block_size>(A, B, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> gelu_blocks(const BFP_Global<Cfg, Block_size>& A){
+    BFP_Stats<Cfg> st{};
+    return act_block<Cfg, Block_size, ACT_GELU>(A, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> silu_blocks(const BFP_Global<Cfg, Block_size>& A){
+    BFP_Stats<Cfg> st{};
+    return act_block<Cfg, Block_size, ACT_SILU>(A, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> tanh_blocks(const BFP_Global<Cfg, Block_size>& A){
+    BFP_Stats<Cfg> st{};
+    return act_block<Cfg, Block_size, ACT_TANH>(A, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> sigmoid_blocks(const BFP_Global<Cfg, Block_size>& A){
+    BFP_Stats<Cfg> st{};
+    return act_block<Cfg, Block_size, ACT_SIGMOID>(A, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> exp_blocks(const BFP_Global<Cfg, Block_size>& A){
+    BFP_Stats<Cfg> st{};
+    return act_block<Cfg, Block_size, ACT_EXP>(A, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+void scalar_blocks(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n, float s,
+                   BFP_Global<Cfg, Block_size>* z){
+    BFP_Stats<Cfg> st{};
+    scalar_blocks<Cfg, Block_size>(kind, a, n, s, z, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+void bcast_blocks(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, std::size_t n,
+                  const BFP_Global<Cfg, Block_size>* b, std::size_t nb, BFP_Global<Cfg, Block_size>* z){
+    BFP_Stats<Cfg> st{};
+    bcast_blocks<Cfg, Block_size>(kind, a, n, b, nb, z, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+void mixed_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, const float* b,
+                  std::size_t n_elements, BFP_Global<Cfg, Block_size>* z){
+    BFP_Stats<Cfg> st{};
+    mixed_tensor<Cfg, Block_size>(kind, a, b, n_elements, z, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+void mixed_tensor(unsigned int kind, const BFP_Global<Cfg, Block_size>* a, const float* b,
+                  std::size_t n_elements, float* y){
+    BFP_Stats<Cfg> st{};
+    mixed_tensor<Cfg, Block_size>(kind, a, b, n_elements, y, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> reduce_blocks(const BFP_Global<Cfg, Block_size>* xs, std::size_t n){
+    BFP_Stats<Cfg> st{};
+    return reduce_blocks<Cfg, Block_size>(xs, n, st);
 }
 
 
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <iomanip>
 #include <limits>   // ADD: para inf/metricas
+#include <vector>
+#include <chrono>
 
 #include "bfp.h"
 #include "bfp_ops.h"
@@ -143,6 +145,58 @@ static void run_pair(const char* titulo,
     report_op("DIV via RCP (A*(1/B))", blk_div, ref_div, A, B, "mant(DIV)");
 }
 
+// ADD: activaciones por tabla vs std:: (error) y bloques por segundo (throughput)
+static void report_activations()
+{
+    const int n_blocks = 4096;
+    std::vector<BFP_Global<Cfg,N>> blks(n_blocks);
+    for (int b = 0; b < n_blocks; ++b) {
+        std::array<float,N> xs{};
+        const float range = std::ldexp(1.0f, (b % 9) - 5);      // bloques de 2^-5 a 2^3
+        for (std::size_t i = 0; i < N; ++i)
+            xs[i] = range * std::sin(0.77f * float(b * N + i) + 0.3f);
+        blks[b] = encode_block<Cfg,N>(xs);
+    }
+
+    const char* names[ACT_KINDS] = {"GELU", "SiLU", "tanh", "sigmoid", "exp"};
+    std::cout << "\n==== Activaciones por tabla (" << n_blocks << " bloques, |x| <= 8) ====\n";
+    std::vector<BFP_Global<Cfg,N>> out(n_blocks);
+    for (unsigned k = 0; k < ACT_KINDS; ++k) {
+        BFP_Stats<Cfg> st{};
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int b = 0; b < n_blocks; ++b) out[b] = act_blocks<Cfg,N>(k, blks[b], st);
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        // Error absoluto y relativo al maximo |f| del bloque (la salida comparte exponente)
+        double max_abs = 0.0, max_rel = 0.0;
+        for (int b = 0; b < n_blocks; ++b) {
+            std::array<double,N> ref{};
+            double blk_max = 1e-30;
+            for (std::size_t i = 0; i < N; ++i) {
+                const double x = blks[b].rebuild_FP32(i);
+                switch (k) {
+                    case ACT_GELU:    ref[i] = 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0))); break;
+                    case ACT_SILU:    ref[i] = x / (1.0 + std::exp(-x)); break;
+                    case ACT_TANH:    ref[i] = std::tanh(x); break;
+                    case ACT_SIGMOID: ref[i] = 1.0 / (1.0 + std::exp(-x)); break;
+                    default:          ref[i] = std::exp(x); break;
+                }
+                blk_max = std::max(blk_max, std::fabs(ref[i]));
+            }
+            for (std::size_t i = 0; i < N; ++i) {
+                const double e = std::fabs(double(out[b].rebuild_FP32(i)) - ref[i]);
+                max_abs = std::max(max_abs, e);
+                max_rel = std::max(max_rel, e / blk_max);
+            }
+        }
+        std::cout << std::left << std::setw(8) << names[k] << std::right
+                  << "  max_abs=" << std::scientific << std::setprecision(2) << max_abs
+                  << "  max_rel(blk)=" << max_rel << std::defaultfloat
+                  << "  | " << std::fixed << std::setprecision(1)
+                  << double(n_blocks) * N / s * 1e-6 << " Melem/s" << std::defaultfloat << "\n";
+    }
+}
+
 int main() {
     // ===== Par base (tu caso) =====
     std::array<float,N> A = {
@@ -177,5 +231,7 @@ int main() {
                                130.0f, 190.0f, 60.0f, 80.0f, 30.0f, 72.0f, 100.0f,  10.0f };
     run_pair("Muy disparejos (magnitudes mixtas)", A3, B3);
 
+    report_activations();
+
     return 0;
 }
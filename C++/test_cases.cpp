@@ -2,9 +2,13 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
+#include <limits>
 #include "bfp.h"
 #include "bfp_ops.h"
+#include "bfp_conv.h"
+#include "bfp_norm.h"
 
 using Cfg = BFP_bias<4,5>;
 constexpr std::size_t N = 16;
@@ -218,6 +222,514 @@ void test_rounding() {
     std::cout << "Si Redondeo RNE funciona correctamente" << std::endl;
 }
 
+void test_stats_counters() {
+    std::cout << "\n=== TEST: Contadores de Salud Numerica ===" << std::endl;
+    BFP_Stats<Cfg> st{};
+
+    // Overflow de exponente (WE=4: E_real max = 8) y flush de un valor pequeño
+    std::array<float,N> big{};
+    big.fill(1000.0f);
+    big[1] = 1e-6f;
+    auto blkA = encode_block<Cfg>(big, st);
+    st.record_block(blkA);
+    assert(st.exp_overflow == 1);
+    assert(st.flush_zero == 1);
+
+    // Underflow de exponente (E_real min = -7) y NaN/Inf a la entrada
+    std::array<float,N> small{};
+    small.fill(1e-4f);
+    auto blkB = encode_block<Cfg>(small, st);
+    st.record_block(blkB);
+    assert(st.exp_underflow == 1);
+
+    std::array<float,N> special{};
+    special[0] = std::numeric_limits<float>::quiet_NaN();
+    special[1] = std::numeric_limits<float>::infinity();
+    encode_block<Cfg>(special, st);
+    assert(st.nan_count == 1 && st.inf_count == 1);
+
+    // 1/0 se cuenta como Inf
+    std::array<float,N> den{};
+    den.fill(2.0f);
+    den[3] = 0.0f;
+    auto R = rcp_blocks<Cfg>(encode_block<Cfg>(den), st);
+    st.record_block(R);
+    assert(st.inf_count == 2);
+
+    assert(st.blocks == 3);
+    assert(st.exp_hist[blkA.exp_shared] >= 1 && st.exp_hist[blkB.exp_shared] >= 1);
+    std::cout << "  overflow=" << st.exp_overflow << " underflow=" << st.exp_underflow
+              << " mant_sat=" << st.mant_sat << " flush=" << st.flush_zero
+              << " nan=" << st.nan_count << " inf=" << st.inf_count << std::endl;
+    std::cout << "Si Contadores acumulados correctamente" << std::endl;
+}
+
+void test_conv2d_reference() {
+    std::cout << "\n=== TEST: Convolucion 2D BFP (referencia multihilo) ===" << std::endl;
+    // 6x5x20 -> 3, K=3, stride 2, pad 1 (C_in no multiplo de N: 2 bloques)
+    const Conv2DShape s{6, 5, 20, 3, 3, 2, 1};
+    std::vector<float> x(s.height * s.width * s.c_in), w(s.c_out * s.ksize * s.ksize * s.c_in);
+    for (size_t i = 0; i < x.size(); i++) x[i] = std::sin(0.3f * float(i)) * 4.0f;
+    for (size_t i = 0; i < w.size(); i++) w[i] = std::cos(0.7f * float(i)) * 0.25f;
+
+    const auto xb = conv_encode_hwc<Cfg, N>(x, s.height * s.width, s.c_in);
+    const auto wb = conv_encode_hwc<Cfg, N>(w, s.c_out * s.ksize * s.ksize, s.c_in);
+
+    const auto out_mt = conv2d_bfp_ref<Cfg, N>(xb, wb, s, 3);
+    const auto out_st = conv2d_bfp_ref<Cfg, N>(xb, wb, s, 1);
+    assert(out_mt == out_st);
+
+    // Convolucion directa sobre los valores reconstruidos
+    const int CB = s.cb_in<N>();
+    double worst = 0.0;
+    for (int oy = 0; oy < s.out_h(); oy++)
+        for (int ox = 0; ox < s.out_w(); ox++)
+            for (int oc = 0; oc < s.c_out; oc++) {
+                double acc = 0.0;
+                for (int ky = 0; ky < s.ksize; ky++)
+                    for (int kx = 0; kx < s.ksize; kx++) {
+                        const int y = oy * s.stride + ky - s.pad, xx = ox * s.stride + kx - s.pad;
+                        if (y < 0 || y >= s.height || xx < 0 || xx >= s.width) continue;
+                        for (int ci = 0; ci < s.c_in; ci++) {
+                            const auto& a = xb[(y * s.width + xx) * CB + ci / N];
+                            const auto& b = wb[((oc * s.ksize + ky) * s.ksize + kx) * CB + ci / N];
+                            acc += double(a.rebuild_FP32(ci % N)) * double(b.rebuild_FP32(ci % N));
+                        }
+                    }
+                const double got = out_mt[(oy * s.out_w() + ox) * s.c_out + oc];
+                worst = std::max(worst, std::fabs(got - acc) / std::max(1.0, std::fabs(acc)));
+            }
+    std::cout << "  salida " << s.out_h() << "x" << s.out_w() << "x" << s.c_out
+              << ", error maximo vs directa = " << worst << std::endl;
+    assert(worst < 1e-5);
+    std::cout << "Si Referencia multihilo coincide con la convolucion directa" << std::endl;
+}
+
+void test_norm_reference() {
+    std::cout << "\n=== TEST: LayerNorm / RMSNorm por filas ===" << std::endl;
+    const int rb = 3, rows = 5, C = rb * int(N);
+    std::vector<float> x(rows * C), gamma(C), beta(C);
+    for (size_t i = 0; i < x.size(); i++) x[i] = std::sin(0.41f * float(i)) * 2.0f + float(i / C);
+    for (int c = 0; c < C; c++) {
+        gamma[c] = 1.0f + 0.02f * float(c);
+        beta[c]  = -0.25f + 0.01f * float(c);
+    }
+    const auto xb = conv_encode_hwc<Cfg, N>(x, rows * rb, int(N));
+
+    for (bool rms : {false, true}) {
+        const auto y_mt = rms ? rmsnorm_bfp<Cfg, N>(xb, rb, gamma, 1e-5f, 4)
+                              : layernorm_bfp<Cfg, N>(xb, rb, gamma, beta, 1e-5f, 4);
+        const auto y_st = rms ? rmsnorm_bfp<Cfg, N>(xb, rb, gamma, 1e-5f, 1)
+                              : layernorm_bfp<Cfg, N>(xb, rb, gamma, beta, 1e-5f, 1);
+
+        double worst = 0.0;
+        for (int r = 0; r < rows; r++) {
+            double mean = 0.0, var = 0.0;
+            for (int c = 0; c < C; c++) mean += double(xb[r * rb + c / N].rebuild_FP32(c % N)) / C;
+            if (rms) mean = 0.0;
+            for (int c = 0; c < C; c++) var += std::pow(double(xb[r * rb + c / N].rebuild_FP32(c % N)) - mean, 2) / C;
+            double row_max = 1e-30, err = 0.0;
+            for (int c = 0; c < C; c++) {
+                const int b = r * rb + c / N, l = c % N;
+                assert(y_mt[b].exp_shared == y_st[b].exp_shared && y_mt[b].mant[l] == y_st[b].mant[l]);
+                const double ref = (double(xb[b].rebuild_FP32(l)) - mean) / std::sqrt(var + 1e-5) * gamma[c]
+                                 + (rms ? 0.0 : beta[c]);
+                row_max = std::max(row_max, std::fabs(ref));
+                err = std::max(err, std::fabs(double(y_mt[b].rebuild_FP32(l)) - ref));
+            }
+            worst = std::max(worst, err / row_max);
+        }
+        std::cout << "  " << (rms ? "RMSNorm  " : "LayerNorm") << " error maximo (rel. al max de fila) = "
+                  << worst << std::endl;
+        assert(worst < 2.0 * std::ldexp(1.0, -Cfg::wm));
+    }
+
+    // Formas invalidas: salida vacia (sin division por cero ni filas perdidas)
+    const std::vector<float> none;
+    assert((layernorm_bfp<Cfg, N>(xb, 0, gamma, beta).empty()));
+    assert((layernorm_bfp<Cfg, N>(xb, 4, gamma, beta).empty()));       // 15 bloques / 4
+    assert((rmsnorm_bfp<Cfg, N>(xb, rb, none).empty()));
+    assert((layernorm_bfp<Cfg, N>(xb, rb, gamma, none).empty()));
+    std::cout << "Si Normalizacion entera coincide con la referencia double" << std::endl;
+}
+
+void test_wide_accumulator() {
+    std::cout << "\n=== TEST: Acumulador ancho BFP_Accum ===" << std::endl;
+    const int n = 512;
+    std::vector<BFP_Global<Cfg, N>> xs(n), ys(n);
+    for (int b = 0; b < n; b++) {
+        std::array<float, N> u{}, v{};
+        for (size_t l = 0; l < N; l++) {
+            u[l] = std::sin(0.23f * float(b * N + l)) * std::ldexp(1.0f, b % 7 - 3);
+            v[l] = std::cos(0.05f * float(b + l)) + 0.1f;
+        }
+        xs[b] = encode_block<Cfg, N>(u);
+        ys[b] = encode_block<Cfg, N>(v);
+    }
+
+    // Suma exacta (double) de los valores BFP y de la cadena de add_blocks
+    std::array<double, N> ref{};
+    double dot_ref = 0.0;
+    auto chain = xs[0];
+    for (int b = 0; b < n; b++) {
+        if (b > 0) chain = add_blocks<Cfg, N>(chain, xs[b]);
+        for (size_t l = 0; l < N; l++) {
+            ref[l]  += xs[b].rebuild_FP32(l);
+            dot_ref += double(xs[b].rebuild_FP32(l)) * double(ys[b].rebuild_FP32(l));
+        }
+    }
+
+    const auto red = reduce_blocks<Cfg, N>(xs.data(), xs.size());
+    double scale = 1e-30, err_red = 0.0, err_chain = 0.0;
+    for (size_t l = 0; l < N; l++) scale = std::max(scale, std::fabs(ref[l]));
+    for (size_t l = 0; l < N; l++) {
+        err_red   = std::max(err_red, std::fabs(red.rebuild_FP32(l) - ref[l]) / scale);
+        err_chain = std::max(err_chain, std::fabs(chain.rebuild_FP32(l) - ref[l]) / scale);
+    }
+    const double dot = dot_blocks<Cfg, N>(xs.data(), ys.data(), xs.size());
+    const double err_dot = std::fabs(dot - dot_ref) / std::max(1e-30, std::fabs(dot_ref));
+
+    std::cout << "  reduccion de " << n << " bloques: error (rel. al max) = " << err_red
+              << "  (cadena add_blocks: " << err_chain << ")" << std::endl;
+    std::cout << "  producto punto: error relativo = " << err_dot << std::endl;
+    // Un solo redondeo: 1/2 ulp del bloque (mas bits perdidos bajo la guarda)
+    assert(err_red <= std::ldexp(1.0, -Cfg::wm - 1) * 1.01);
+    assert(err_dot < 1e-9);
+
+    // Sumar y restar lo mismo deja el acumulador en cero
+    BFP_Accum<Cfg, N> acc;
+    acc.add(xs[3]);
+    acc.add(xs[10]);
+    acc.sub(xs[3]);
+    acc.sub(xs[10]);
+    const auto z = acc.to_block();
+    assert(z.exp_shared == 0);
+    for (size_t l = 0; l < N; l++) assert(z.mant[l] == 0u);
+    std::cout << "Si Un solo redondeo final, sin error acumulado por paso" << std::endl;
+}
+
+void test_scalar_broadcast() {
+    std::cout << "\n=== TEST: Operando escalar / broadcast por filas ===" << std::endl;
+    const std::size_t nb = 3, n = 4 * nb;
+    std::vector<BFP_Global<Cfg, N>> a(n), b(nb), z(n), ref(n);
+    for (std::size_t k = 0; k < n; k++) {
+        std::array<float, N> u{};
+        for (size_t l = 0; l < N; l++) u[l] = 2.0f * std::sin(0.3f * float(k * N + l)) + 0.1f * float(l);
+        a[k] = encode_block<Cfg, N>(u);
+    }
+    for (std::size_t k = 0; k < nb; k++) {
+        std::array<float, N> v{};
+        for (size_t l = 0; l < N; l++) v[l] = 0.5f + std::cos(0.7f * float(k * N + l));
+        b[k] = encode_block<Cfg, N>(v);
+    }
+
+    const float s = -1.375f;
+    std::array<float, N> sv;
+    sv.fill(s);
+    const auto S = encode_block<Cfg, N>(sv);
+    BFP_Stats<Cfg> st{};
+
+    for (unsigned kind = ARITH_ADD; kind <= ARITH_DIV; kind++) {
+        // Escalar == operacion normal contra el bloque replicado
+        scalar_blocks<Cfg, N>(kind, a.data(), n, s, z.data());
+        for (std::size_t k = 0; k < n; k++) {
+            ref[k] = arith_blocks<Cfg, N>(kind, a[k], S, st);
+            assert(z[k].exp_shared == ref[k].exp_shared && z[k].mant == ref[k].mant && z[k].sign == ref[k].sign);
+        }
+        // Broadcast == operacion normal contra b[k % nb]
+        bcast_blocks<Cfg, N>(kind, a.data(), n, b.data(), nb, z.data());
+        for (std::size_t k = 0; k < n; k++) {
+            ref[k] = arith_blocks<Cfg, N>(kind, a[k], b[k % nb], st);
+            assert(z[k].exp_shared == ref[k].exp_shared && z[k].mant == ref[k].mant && z[k].sign == ref[k].sign);
+        }
+    }
+    std::cout << "Si ADD/SUB/MUL/DIV escalar y broadcast coinciden con la operacion por bloques" << std::endl;
+}
+
+void test_partial_tail() {
+    std::cout << "\n=== TEST: Tensores con bloque final parcial (n_elements) ===" << std::endl;
+    const std::size_t nb = 6, v = 7, n = (nb - 1) * N + v;
+
+    // Entrada con basura tras n_elements: no debe leerse
+    std::vector<float> x(nb * N, 1e30f), y(nb * N, -1.0f);
+    for (std::size_t i = 0; i < n; i++) x[i] = -3.0f - 0.1f * std::sin(0.7f * float(i));
+    BFP_Stats<Cfg> st{};
+    std::vector<BFP_Global<Cfg, N>> xb(nb), zb(nb);
+    encode_tensor<Cfg, N>(x.data(), n, xb.data(), st);
+    assert(st.exp_overflow == 0);
+
+    // Bloque final = codificar solo los lanes validos (resto a cero)
+    std::array<float, N> tail{};
+    for (std::size_t l = 0; l < v; l++) tail[l] = x[(nb - 1) * N + l];
+    const auto ref = encode_block<Cfg, N>(tail);
+    assert(xb[nb - 1].exp_shared == ref.exp_shared);
+    for (std::size_t l = 0; l < N; l++) assert(xb[nb - 1].mant[l] == ref.mant[l]);
+
+    // decode_tensor solo escribe n_elements valores
+    decode_tensor<Cfg, N>(xb.data(), n, y.data());
+    for (std::size_t i = n; i < y.size(); i++) assert(y[i] == -1.0f);
+
+    // exp: con relleno a cero los lanes invalidos valen exp(0) = 1 y fijan Emax;
+    // enmascarados, Emax sale de los lanes validos (~exp(-3))
+    act_tensor<Cfg, N>(ACT_EXP, xb.data(), n, zb.data(), st);
+    const auto padded = act_blocks<Cfg, N>(ACT_EXP, ref, st);
+    double err_mask = 0.0, err_pad = 0.0;
+    for (std::size_t l = 0; l < v; l++) {
+        const double e = std::exp(double(xb[nb - 1].rebuild_FP32(l)));
+        err_mask = std::max(err_mask, std::fabs(zb[nb - 1].rebuild_FP32(l) - e) / e);
+        err_pad  = std::max(err_pad, std::fabs(padded.rebuild_FP32(l) - e) / e);
+    }
+    for (std::size_t l = v; l < N; l++) assert(zb[nb - 1].mant[l] == 0u);
+    std::cout << "  exp en el bloque final: error rel. " << err_mask << " (relleno a cero: " << err_pad << ")"
+              << std::endl;
+    assert(zb[nb - 1].exp_shared < padded.exp_shared && err_mask < err_pad);
+
+    // DIV con B = 0 tras n_elements: sin Inf ni saturacion por los lanes invalidos
+    std::vector<BFP_Global<Cfg, N>> bb(nb);
+    std::vector<float> b(nb * N, 0.0f);
+    for (std::size_t i = 0; i < n; i++) b[i] = 1.5f + 0.25f * float(i % 3);
+    encode_tensor<Cfg, N>(b.data(), n, bb.data(), st);
+    BFP_Stats<Cfg> st_div{};
+    arith_tensor<Cfg, N>(ARITH_DIV, xb.data(), bb.data(), n, zb.data(), st_div);
+    assert(st_div.inf_count == 0 && st_div.exp_overflow == 0);
+
+    // LayerNorm con 40 canales por fila (3 bloques, el ultimo con 8 lanes)
+    const int rb = 3, rows = 4, C = 40;
+    std::vector<float> xr(rows * rb * N, 0.0f), gamma(C, 1.0f), beta(C, 0.0f);
+    for (int r = 0; r < rows; r++)
+        for (int c = 0; c < C; c++) xr[r * rb * N + c] = std::cos(0.3f * float(r * C + c)) + float(r);
+    const auto xrb = conv_encode_hwc<Cfg, N>(xr, rows * rb, int(N));
+    const auto yrb = layernorm_bfp<Cfg, N>(xrb, rb, gamma, beta, 1e-5f, 2);
+    double worst = 0.0;
+    for (int r = 0; r < rows; r++) {
+        double mean = 0.0, var = 0.0;
+        for (int c = 0; c < C; c++) mean += double(xrb[r * rb + c / N].rebuild_FP32(c % N)) / C;
+        for (int c = 0; c < C; c++) var += std::pow(double(xrb[r * rb + c / N].rebuild_FP32(c % N)) - mean, 2) / C;
+        for (int c = 0; c < C; c++) {
+            const double ref_n = (double(xrb[r * rb + c / N].rebuild_FP32(c % N)) - mean) / std::sqrt(var + 1e-5);
+            worst = std::max(worst, std::fabs(double(yrb[r * rb + c / N].rebuild_FP32(c % N)) - ref_n));
+        }
+        for (int c = C; c < rb * int(N); c++) assert(yrb[r * rb + c / N].mant[c % N] == 0u);
+    }
+    std::cout << "  LayerNorm de 40 canales: error maximo = " << worst << std::endl;
+    assert(worst < 4.0 * std::ldexp(1.0, -Cfg::wm));
+    std::cout << "Si Los lanes invalidos no afectan a Emax ni se escriben" << std::endl;
+}
+
+void test_mixed_operands() {
+    std::cout << "\n=== TEST: Operandos mixtos BFP x FP32 (B codificado en el bucle) ===" << std::endl;
+    const std::size_t nb = 4, n = (nb - 1) * N + 5;
+    std::vector<float> w(nb * N), x(nb * N, 1e30f), y(nb * N, -1.0f), y_ref(nb * N, -1.0f);
+    for (std::size_t i = 0; i < nb * N; i++) w[i] = 0.5f * std::cos(0.11f * float(i));
+    for (std::size_t i = 0; i < n; i++) x[i] = 1.0f + std::sin(0.37f * float(i)) * float(1 + i % 3);
+
+    BFP_Stats<Cfg> st{};
+    std::vector<BFP_Global<Cfg, N>> wb(nb), xb(nb), z(nb), ref(nb);
+    encode_tensor<Cfg, N>(w.data(), n, wb.data(), st);
+    encode_tensor<Cfg, N>(x.data(), n, xb.data(), st);
+
+    for (unsigned kind = ARITH_ADD; kind <= ARITH_DIV; kind++) {
+        // == encode_tensor(b) + arith_tensor, bit a bit (basura tras n_elements no se lee)
+        arith_tensor<Cfg, N>(kind, wb.data(), xb.data(), n, ref.data(), st);
+        mixed_tensor<Cfg, N>(kind, wb.data(), x.data(), n, z.data());
+        for (std::size_t k = 0; k < nb; k++)
+            assert(z[k].exp_shared == ref[k].exp_shared && z[k].mant == ref[k].mant && z[k].sign == ref[k].sign);
+
+        // Salida FP32 == decode_tensor del resultado BFP, solo n_elements valores
+        mixed_tensor<Cfg, N>(kind, wb.data(), x.data(), n, y.data());
+        decode_tensor<Cfg, N>(ref.data(), n, y_ref.data());
+        assert(std::memcmp(y.data(), y_ref.data(), sizeof(float) * y.size()) == 0);
+    }
+    std::cout << "Si ADD/SUB/MUL/DIV mixtos coinciden con encode_tensor + arith_tensor" << std::endl;
+}
+
+// 1.0 + 64 x 2^-6: cada incremento es medio ulp de 1.0 (WM=5), RNE/TRUNC se estancan
+void test_wide_mantissa_mul() {
+    std::cout << "\n=== TEST: MUL con mantisa ancha (WM=23) ===" << std::endl;
+    using WCfg = BFP_bias<8,23>;
+    std::array<float, N> a{}, b{};
+    for (size_t l = 0; l < N; l++) {
+        a[l] = 1.0f + 0.57f * float(l);
+        b[l] = 9.9f - 0.43f * float(l);
+    }
+    const auto A = encode_block<WCfg, N>(a);
+    const auto B = encode_block<WCfg, N>(b);
+    const auto P = mul_blocks<WCfg, N>(A, B);
+
+    // El producto de mantisas ocupa 2 * (WM + 1) = 48 bits: tiene que ir en 64
+    double scale = 1e-30, err = 0.0;
+    for (size_t l = 0; l < N; l++)
+        scale = std::max(scale, std::fabs(double(A.rebuild_FP32(l)) * B.rebuild_FP32(l)));
+    for (size_t l = 0; l < N; l++) {
+        const double ref = double(A.rebuild_FP32(l)) * double(B.rebuild_FP32(l));
+        err = std::max(err, std::fabs(P.rebuild_FP32(l) - ref) / scale);
+    }
+    std::cout << "  error (rel. al max) = " << err << std::endl;
+    assert(err <= std::ldexp(1.0, -WCfg::wm));
+    std::cout << "Si Producto de 48 bits sin desborde" << std::endl;
+}
+
+// Acarreo en MUL con la configuracion del kernel (WE=5, WM=7): mismos
+// operandos y valores esperados que check_mul_carry en HW/tb_kernel.cc.
+// 181*181 = 32761 redondea a 256 = 2^(WM+1): el bloque sube un exponente y
+// 5*179 = 895 se redondea UNA vez a 895/256 = 3.496 -> 3 (no 895/128 -> 7 -> 4)
+template<int Mode>
+void mul_carry_case(uint32_t want_lane1) {
+    using C = BFP_bias<5, 7, Mode>;
+    BFP_Global<C, N> A{}, B{};
+    A.exp_shared = C::bias_bfp;
+    B.exp_shared = C::bias_bfp;
+    A.mant[0] = 181; B.mant[0] = 181;
+    A.mant[1] = 5;   B.mant[1] = 179;
+    A.mant[2] = 100; B.mant[2] = 3;    // 300 / 256 -> 1
+    A.sign[2] = 1;
+
+    BFP_Stats<C> st{};
+    const auto Z = mul_blocks<C, N>(A, B, st);
+    assert(Z.exp_shared == uint32_t(C::bias_bfp + 8 - C::wm));
+    assert(Z.mant[0] == 128u && Z.mant[1] == want_lane1 && Z.mant[2] == 1u && Z.sign[2] == 1u);
+    assert(st.mant_sat == 0u);
+}
+
+void test_mul_carry() {
+    std::cout << "\n=== TEST: MUL con acarreo (redondeo unico, igual que HW) ===" << std::endl;
+    mul_carry_case<BFP_RND_RNE>(3u);
+    mul_carry_case<BFP_RND_HALF_AWAY>(3u);
+
+    // Mismos 4000 bloques aleatorios que check_mul_single_round en HW: RNE
+    // contra el redondeo unico de referencia al shift del mayor producto
+    using C = BFP_bias<5, 7, BFP_RND_RNE>;
+    const uint32_t mant_max = (1u << (C::wm + 1)) - 1u;
+    uint32_t lcg = 12345u;
+    auto rnd = [&lcg]() { lcg = lcg * 1664525u + 1013904223u; return lcg >> 8; };
+    auto rne = [](uint64_t x, int sh) {
+        if (sh <= 0) return x << -sh;
+        const uint64_t q = x >> sh, r = x & ((uint64_t(1) << sh) - 1), half = uint64_t(1) << (sh - 1);
+        return (r > half || (r == half && (q & 1u))) ? q + 1 : q;
+    };
+
+    unsigned carries = 0;
+    for (unsigned t = 0; t < 4000; t++) {
+        BFP_Global<C, N> A{}, B{};
+        A.exp_shared = C::bias_bfp;
+        B.exp_shared = C::bias_bfp;
+        const uint32_t top = (t & 1) ? 181u + rnd() % 75u : 1u + rnd() % mant_max;
+        uint64_t P[N], max_P = 0;
+        for (std::size_t l = 0; l < N; l++) {
+            A.mant[l] = (l == 0) ? top : rnd() % (top + 1u);
+            // & mant_max: el mismo truncado que el ap_uint<WM+1> de HW si top < 3
+            B.mant[l] = (l == 0) ? (top - rnd() % 4u) & mant_max : rnd() % (mant_max + 1u);
+            A.sign[l] = rnd() & 1u;
+            P[l] = uint64_t(A.mant[l]) * uint64_t(B.mant[l]);
+            max_P = std::max(max_P, P[l]);
+        }
+        if (max_P == 0) continue;
+        int msb = 0;
+        while ((max_P >> (msb + 1)) != 0) msb++;
+        int shift = msb - C::wm;
+        if (rne(max_P, shift) > mant_max) { shift++; carries++; }
+
+        BFP_Stats<C> st{};
+        const auto Z = mul_blocks<C, N>(A, B, st);
+        assert(Z.exp_shared == uint32_t(C::bias_bfp - C::wm + shift));
+        for (std::size_t l = 0; l < N; l++) assert(Z.mant[l] == rne(P[l], shift));
+    }
+    assert(carries > 0);
+    std::cout << "  4000 bloques aleatorios, acarreos = " << carries << std::endl;
+    std::cout << "Si 5*179 -> 3 como en HW: un solo redondeo tambien con acarreo" << std::endl;
+}
+
+template<int Mode>
+float accumulate_small(uint64_t seed) {
+    using C = BFP_bias<4, 5, Mode>;
+    BFP_Stats<C> st{};
+    BFP_Rng rng(seed);
+    std::array<float, N> one{}, tiny{};
+    one.fill(1.0f);
+    tiny.fill(std::ldexp(1.0f, -6));
+    auto acc = encode_block<C, N>(one, st, rng);
+    const auto inc = encode_block<C, N>(tiny, st, rng);
+    for (int k = 0; k < 64; k++) acc = add_blocks<C, N>(acc, inc, st, rng);
+
+    float mean = 0.0f;
+    for (std::size_t i = 0; i < N; i++) mean += acc.rebuild_FP32(i);
+    return mean / float(N);
+}
+
+void test_rounding_modes() {
+    std::cout << "\n=== TEST: Modos de redondeo (RNE / TRUNC / STOCH / HALF_AWAY) ===" << std::endl;
+    using CfgT = BFP_bias<4, 5, BFP_RND_TRUNC>;
+    using CfgS = BFP_bias<4, 5, BFP_RND_STOCH>;
+
+    BFP_Stats<CfgT> st_t{};
+    BFP_Rng rng_t(0);                                    // NO SE CONSUME
+    assert(helper_round<CfgT>(0b1011, 2, rng_t) == 2);  // 2.75 -> 2
+    assert(helper_round<CfgT>(0b1110, 2, rng_t) == 3);  // 3.5  -> 3
+    assert(rng_t.ctr == 0);
+
+    // Politicas sin estado: empates 2.5 / 3.5
+    assert(bfp_round_shr<RoundNearestEven>(0b1010u, 2) == 2 && bfp_round_shr<RoundNearestEven>(0b1110u, 2) == 4);
+    assert(bfp_round_shr<RoundTowardZero>(0b1010u, 2) == 2 && bfp_round_shr<RoundTowardZero>(0b1110u, 2) == 3);
+    assert(bfp_round_shr<RoundHalfAway>(0b1010u, 2) == 3 && bfp_round_shr<RoundHalfAway>(0b1110u, 2) == 4);
+    assert(bfp_round_shr<RoundHalfAway>(uint64_t(5) << 40, 41) == 3);   // 2.5 en 64 bits
+
+    // Reciproco: 2^10 / 21 = 48.76 -> RNE/HALF_AWAY 49, TOWARD_ZERO 48
+    using CfgH = BFP_bias<4, 5, BFP_RND_HALF_AWAY>;
+    BFP_Stats<CfgH> st_h{};
+    BFP_Global<CfgT, N> bt{};  bt.exp_shared = Cfg::bias_bfp;  bt.mant.fill(21);
+    BFP_Global<CfgH, N> bh{};  bh.exp_shared = Cfg::bias_bfp;  bh.mant.fill(21);
+    assert((rcp_blocks<CfgT, N>(bt, st_t).mant[0] == 48));
+    assert((rcp_blocks<CfgH, N>(bh, st_h).mant[0] == 49));
+
+    // Estocastico: solo valores vecinos, media ~ x / 2^shift
+    BFP_Stats<CfgS> st_s{};
+    BFP_Rng rng_s(1);
+    uint32_t sum = 0;
+    for (int k = 0; k < 4096; k++) {
+        const uint32_t q = uint32_t(helper_round<CfgS>(0b1010, 2, rng_s));   // 2.5
+        assert(q == 2 || q == 3);
+        sum += q;
+    }
+    assert(std::fabs(float(sum) / 4096.0f - 2.5f) < 0.05f);
+    assert(helper_round<CfgS>(0b1000, 2, rng_s) == 2);         // exacto: sin sorteo
+
+    // Escalar de scalar_blocks: un solo B con RNE tambien en STOCH (como HW)
+    BFP_Stats<Cfg> st_r{};
+    const auto s_stoch = splat_block<CfgS, N>(0.3f, st_s);
+    const auto s_rne   = splat_block<Cfg, N>(0.3f, st_r);
+    assert(s_stoch.exp_shared == s_rne.exp_shared && s_stoch.mant == s_rne.mant);
+
+    const float rne   = accumulate_small<BFP_RND_RNE>(0);
+    const float trunc = accumulate_small<BFP_RND_TRUNC>(0);
+    const float stoch = accumulate_small<BFP_RND_STOCH>(7);
+    assert(rne == 1.0f && trunc == 1.0f);
+    assert(std::fabs(stoch - 2.0f) < 0.25f);
+    assert(accumulate_small<BFP_RND_STOCH>(7) == stoch);       // reproducible desde la semilla
+
+    // LayerNorm en STOCH: una subsecuencia por fila, igual con 1 o 4 hilos;
+    // otra semilla da otro redondeo
+    const int rb = 2, rows = 6;
+    std::vector<BFP_Global<CfgS, N>> xs(std::size_t(rows) * rb);
+    for (std::size_t b = 0; b < xs.size(); b++) {
+        std::array<float, N> v{};
+        for (std::size_t l = 0; l < N; l++) v[l] = std::sin(0.37f * float(b * N + l)) * 3.0f;
+        xs[b] = encode_block<CfgS, N>(v, st_s, rng_s);
+    }
+    std::vector<float> gamma(rb * N, 0.9f), beta(rb * N, 0.1f);
+    const auto ln_1 = layernorm_bfp<CfgS, N>(xs, rb, gamma, beta, BFP_Rng(5), 1e-5f, 1);
+    const auto ln_4 = layernorm_bfp<CfgS, N>(xs, rb, gamma, beta, BFP_Rng(5), 1e-5f, 4);
+    const auto ln_6 = layernorm_bfp<CfgS, N>(xs, rb, gamma, beta, BFP_Rng(6), 1e-5f, 4);
+    bool same = true, differs = false;
+    for (std::size_t b = 0; b < xs.size(); b++) {
+        same    = same && ln_1[b].exp_shared == ln_4[b].exp_shared && ln_1[b].mant == ln_4[b].mant;
+        differs = differs || ln_1[b].mant != ln_6[b].mant;
+    }
+    assert(same && differs);
+    std::cout << "  1.0 + 64 x 2^-6: RNE=" << rne << " TRUNC=" << trunc
+              << " STOCH=" << stoch << " (exacto: 2)" << std::endl;
+    std::cout << "Si RNE/TRUNC se estancan, STOCH acumula sin sesgo y las politicas redondean bien" << std::endl;
+}
+
 int main() {
     std::cout << "=====================================" << std::endl;
     std::cout << "   PRUEBAS DE CASOS EXTREMOS BFP    " << std::endl;
@@ -231,6 +743,16 @@ int main() {
     test_normalization();
     test_delta_calculation();
     test_rounding();
+    test_stats_counters();
+    test_conv2d_reference();
+    test_norm_reference();
+    test_wide_accumulator();
+    test_scalar_broadcast();
+    test_partial_tail();
+    test_mixed_operands();
+    test_wide_mantissa_mul();
+    test_mul_carry();
+    test_rounding_modes();
     
     std::cout << "\n=====================================" << std::endl;
     std::cout << "   TODAS LAS PRUEBAS PASADAS Si      " << std::endl;
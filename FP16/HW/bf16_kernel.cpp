@@ -0,0 +1,42 @@
+#include "half_kernel_hls.h"
+
+//=============================================================================
+// MAIN BF16 KERNEL
+//=============================================================================
+extern "C" {
+void bf16_kernel(
+    const unsigned int operation,
+    const unsigned int n_blocks,
+    const half_word_t* in_a,          // n_blocks * N elementos de 16 bits, 32 por palabra
+    const half_word_t* in_b,
+    half_word_t* out
+) {
+
+#pragma HLS INTERFACE s_axilite port=operation
+#pragma HLS INTERFACE s_axilite port=n_blocks
+#pragma HLS INTERFACE s_axilite port=return
+
+  // Interface pragmas: 512-bit ports, one bundle each, long bursts
+    #pragma HLS INTERFACE m_axi port=in_a offset=slave bundle=gmem0 \
+        depth=2 max_read_burst_length=64 num_read_outstanding=16
+
+    #pragma HLS INTERFACE m_axi port=in_b offset=slave bundle=gmem1 \
+        depth=2 max_read_burst_length=64 num_read_outstanding=16
+
+    #pragma HLS INTERFACE m_axi port=out offset=slave bundle=gmem2 \
+        depth=2 max_write_burst_length=64 num_write_outstanding=16
+
+    const unsigned int n_words = half_words(n_blocks);
+
+    half_stream_t sa("sa"), sb("sb"), sz("sz");
+#pragma HLS STREAM variable=sa depth=64
+#pragma HLS STREAM variable=sb depth=64
+#pragma HLS STREAM variable=sz depth=64
+
+#pragma HLS DATAFLOW
+    half_read_words(in_a, sa, n_words, operation != OP_RCP);
+    half_read_words(in_b, sb, n_words, true);
+    half_compute_words<bf16_fmt>(operation, sa, sb, sz, n_words);
+    half_write_words(sz, out, n_words);
+}
+}
@@ -0,0 +1,126 @@
+#ifndef FP16_OPS_HLS_H
+#define FP16_OPS_HLS_H
+
+#include <ap_int.h>
+#include <cstdint>
+#include <cmath>
+
+//=============================================================================
+// FORMATOS DE 16 BITS
+//   fp16_fmt: IEEE binary16 (1 signo, 5 exponente, 10 mantisa), con subnormales
+//   bf16_fmt: bfloat16 (1 signo, 8 exponente, 7 mantisa) = 16 bits altos de FP32
+// Cada operacion se calcula en FP32 y se redondea una vez al formato (RNE).
+// FP32 tiene al menos 2p+2 bits de mantisa para ambos formatos, asi que +, -,
+// * y / salen correctamente redondeados (sin error de doble redondeo).
+//=============================================================================
+
+inline uint32_t f32_to_bits(float f) {
+#pragma HLS INLINE
+    union {float f; uint32_t u;} c = {f};
+    return c.u;
+}
+
+inline float bits_to_f32(uint32_t u) {
+#pragma HLS INLINE
+    union {uint32_t u; float f;} c = {u};
+    return c.f;
+}
+
+struct bf16_fmt {
+    static constexpr const char* name = "BF16";
+
+    static float to_float(uint16_t h) {
+#pragma HLS INLINE
+        return bits_to_f32(uint32_t(h) << 16);
+    }
+
+    // RNE sobre los 16 bits bajos; NaN se mantiene NaN (quiet)
+    static uint16_t from_float(float f) {
+#pragma HLS INLINE
+        const uint32_t u = f32_to_bits(f);
+        if ((u & 0x7FFFFFFFu) > 0x7F800000u) return uint16_t((u >> 16) | 0x0040u);
+        return uint16_t((u + 0x7FFFu + ((u >> 16) & 1u)) >> 16);
+    }
+};
+
+struct fp16_fmt {
+    static constexpr const char* name = "FP16";
+
+    static float to_float(uint16_t h) {
+#pragma HLS INLINE
+        const uint32_t sign = uint32_t(h & 0x8000u) << 16;
+        const uint32_t e = (h >> 10) & 0x1Fu;
+        const uint32_t m = h & 0x3FFu;
+        if (e == 0x1F) return bits_to_f32(sign | 0x7F800000u | (m << 13));     // Inf / NaN
+        if (e == 0) {
+            const float v = float(m) * (1.0f / 16777216.0f);                   // m * 2^-24
+            return sign ? -v : v;
+        }
+        return bits_to_f32(sign | ((e + 112u) << 23) | (m << 13));
+    }
+
+    // RNE con subnormales; |f| >= 65520 -> Inf
+    static uint16_t from_float(float f) {
+#pragma HLS INLINE
+        const uint32_t u = f32_to_bits(f);
+        const uint16_t sign = uint16_t((u >> 16) & 0x8000u);
+        const uint32_t a = u & 0x7FFFFFFFu;
+        if (a > 0x7F800000u) return sign | 0x7E00u;                           // NaN
+        if (a >= 0x477FF000u) return sign | 0x7C00u;                          // Inf / overflow
+        if (a < 0x38800000u) {
+            // Subnormal (o cero): mantisa = round(|f| * 2^24)
+            const int e = int(a >> 23);
+            if (e < 102) return sign;                                         // < 2^-25
+            const uint32_t mant = (a & 0x7FFFFFu) | 0x800000u;
+            const int shift = 126 - e;                                        // 14..24
+            uint32_t q = mant >> shift;
+            const uint32_t rem = mant & ((1u << shift) - 1u);
+            const uint32_t half = 1u << (shift - 1);
+            if (rem > half || (rem == half && (q & 1u))) q++;
+            return sign | uint16_t(q);
+        }
+        // Normal: rebias 127 -> 15 y RNE de 23 a 10 bits (el acarreo sube el exponente)
+        const uint32_t r = a - 0x38000000u;
+        return sign | uint16_t((r + 0xFFFu + ((r >> 13) & 1u)) >> 13);
+    }
+};
+
+//=============================================================================
+// OPERACIONES POR ELEMENTO (misma semantica que FP32/HW/fp32_ops_hls.h:
+// x/0 = +-Inf segun el signo de A, 1/0 = +Inf)
+//=============================================================================
+template<class Fmt>
+uint16_t half_add(uint16_t a, uint16_t b) {
+#pragma HLS INLINE
+    return Fmt::from_float(Fmt::to_float(a) + Fmt::to_float(b));
+}
+
+template<class Fmt>
+uint16_t half_sub(uint16_t a, uint16_t b) {
+#pragma HLS INLINE
+    return Fmt::from_float(Fmt::to_float(a) - Fmt::to_float(b));
+}
+
+template<class Fmt>
+uint16_t half_mul(uint16_t a, uint16_t b) {
+#pragma HLS INLINE
+    return Fmt::from_float(Fmt::to_float(a) * Fmt::to_float(b));
+}
+
+template<class Fmt>
+uint16_t half_div(uint16_t a, uint16_t b) {
+#pragma HLS INLINE
+    const float fa = Fmt::to_float(a), fb = Fmt::to_float(b);
+    if (fb == 0.0f) return Fmt::from_float((fa >= 0) ? (1.0f/0.0f) : (-1.0f/0.0f));
+    return Fmt::from_float(fa / fb);
+}
+
+template<class Fmt>
+uint16_t half_rcp(uint16_t b) {
+#pragma HLS INLINE
+    const float fb = Fmt::to_float(b);
+    if (fb == 0.0f) return Fmt::from_float(1.0f/0.0f);
+    return Fmt::from_float(1.0f / fb);
+}
+
+#endif // FP16_OPS_HLS_H
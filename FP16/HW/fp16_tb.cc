@@ -0,0 +1,176 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ap_int.h>
+
+// Incluimos las mismas operaciones de referencia
+#include "fp16_ops_hls.h"
+
+// =============================
+// Configuración
+// =============================
+#define N           16          // Tamaño de bloque (mismo que el kernel)
+#define HALF_LANES  32          // Elementos de 16 bits por palabra de 512 bits
+#define MAX_BLOCKS  5           // Nº máximo de bloques que vas a probar en cosim
+#define TOTAL_ELEMS (N * (MAX_BLOCKS + 1))   // redondeado a palabras completas
+
+// =============================
+// Prototipos de los kernels HLS
+// (usan EXACTAMENTE la misma firma que fp16_kernel.cpp / bf16_kernel.cpp)
+// =============================
+typedef ap_uint<512> half_word_t;
+
+extern "C" {
+void fp16_kernel(const unsigned int operation, const unsigned int n_blocks,
+                 const half_word_t* in_a, const half_word_t* in_b, half_word_t* out);
+void bf16_kernel(const unsigned int operation, const unsigned int n_blocks,
+                 const half_word_t* in_a, const half_word_t* in_b, half_word_t* out);
+}
+
+// =============================
+// Códigos de operación (igual que en half_kernel_hls.h)
+// =============================
+typedef enum : unsigned int {
+    OP_ADD = 2,
+    OP_SUB = 3,
+    OP_MUL = 4,
+    OP_DIV = 5,
+    OP_RCP = 6
+} half_op_t;
+
+// =============================
+// Buffers globales (alineados a la palabra de 512 bits del kernel)
+// =============================
+alignas(64) static uint16_t A[TOTAL_ELEMS];
+alignas(64) static uint16_t B[TOTAL_ELEMS];
+alignas(64) static uint16_t Z_hw[TOTAL_ELEMS];   // salida del kernel
+static uint16_t Z_sw[TOTAL_ELEMS];               // salida de referencia en C
+
+// =============================
+// Datos de prueba: rango amplio, un cero en B, un subnormal FP16 y
+// valores que desbordan FP16 al multiplicar
+// =============================
+template<class Fmt>
+void init_inputs(unsigned int n_blocks) {
+    const unsigned int total = N * n_blocks;
+    for (unsigned int i = 0; i < total; ++i) {
+        const float a = 0.37f * float(i) * ((i % 3) ? 1.0f : -1.0f) + 0.01f;
+        const float b = 0.2f * float(i + 1) * std::pow(2.0f, float(int(i % 7) - 3));
+        A[i] = Fmt::from_float(a);
+        B[i] = Fmt::from_float(b);
+    }
+    if (total > 2) {
+        B[0] = 0;                                   // x/0, 1/0
+        A[1] = Fmt::from_float(3.0e-6f);            // subnormal en FP16
+        A[2] = Fmt::from_float(300.0f);
+        B[2] = Fmt::from_float(400.0f);             // 120000: Inf en FP16
+    }
+}
+
+template<class Fmt>
+void compute_reference(unsigned int op, unsigned int n_blocks) {
+    for (unsigned int i = 0; i < N * n_blocks; ++i) {
+        switch (op) {
+            case OP_ADD: Z_sw[i] = half_add<Fmt>(A[i], B[i]); break;
+            case OP_SUB: Z_sw[i] = half_sub<Fmt>(A[i], B[i]); break;
+            case OP_MUL: Z_sw[i] = half_mul<Fmt>(A[i], B[i]); break;
+            case OP_DIV: Z_sw[i] = half_div<Fmt>(A[i], B[i]); break;
+            case OP_RCP: Z_sw[i] = half_rcp<Fmt>(B[i]); break;
+        }
+    }
+}
+
+// =============================
+// Ejecuta un test: el kernel debe ser bit a bit igual a la referencia
+// =============================
+template<class Fmt>
+bool run_test(unsigned int op, unsigned int n_blocks) {
+    init_inputs<Fmt>(n_blocks);
+    compute_reference<Fmt>(op, n_blocks);
+    std::memset(Z_hw, 0, sizeof(Z_hw));
+
+    auto* a = reinterpret_cast<const half_word_t*>(A);
+    auto* b = reinterpret_cast<const half_word_t*>(B);
+    auto* z = reinterpret_cast<half_word_t*>(Z_hw);
+    if (std::strcmp(Fmt::name, "FP16") == 0) fp16_kernel(op, n_blocks, a, b, z);
+    else                                     bf16_kernel(op, n_blocks, a, b, z);
+
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < N * n_blocks; ++i) {
+        if (Z_hw[i] != Z_sw[i]) {
+            if (mismatches++ < 4)
+                std::cout << "  [" << Fmt::name << " OP " << op << "] Mismatch en i=" << i << " HW=0x"
+                          << std::hex << Z_hw[i] << " SW=0x" << Z_sw[i] << std::dec << "\n";
+        }
+    }
+    std::cout << "[" << Fmt::name << " OP " << op << "] n_blocks=" << n_blocks
+              << " -> " << (mismatches ? "FAIL" : "OK") << std::endl;
+    return mismatches == 0;
+}
+
+// =============================
+// Conversiones FP32 <-> 16 bits en casos frontera
+// =============================
+bool check_conversions() {
+    const float inf = std::numeric_limits<float>::infinity();
+    struct Case { const char* name; bool ok; };
+    const Case cases[] = {
+        {"FP16 1.0",                 fp16_fmt::from_float(1.0f) == 0x3C00},
+        {"FP16 max 65504",           fp16_fmt::from_float(65504.0f) == 0x7BFF},
+        {"FP16 65520 -> Inf",        fp16_fmt::from_float(65520.0f) == 0x7C00},
+        {"FP16 -Inf",                fp16_fmt::from_float(-inf) == 0xFC00},
+        {"FP16 NaN",                 (fp16_fmt::from_float(std::nanf("")) & 0x7FFF) > 0x7C00},
+        {"FP16 min subnormal 2^-24", fp16_fmt::from_float(std::ldexp(1.0f, -24)) == 0x0001},
+        {"FP16 2^-25 -> 0 (empate par)", fp16_fmt::from_float(std::ldexp(1.0f, -25)) == 0x0000},
+        {"FP16 1 + 2^-11 -> 1 (empate par)", fp16_fmt::from_float(1.0f + std::ldexp(1.0f, -11)) == 0x3C00},
+        {"FP16 ida y vuelta subnormal", fp16_fmt::to_float(0x0155) == 341.0f * std::ldexp(1.0f, -24)},
+        {"BF16 1.0",                 bf16_fmt::from_float(1.0f) == 0x3F80},
+        {"BF16 1 + 2^-8 -> 1 (empate par)", bf16_fmt::from_float(1.0f + std::ldexp(1.0f, -8)) == 0x3F80},
+        {"BF16 NaN",                 (bf16_fmt::from_float(std::nanf("")) & 0x7FFF) > 0x7F80},
+        {"BF16 ida y vuelta",        bf16_fmt::to_float(0xC2F7) == -123.5f},
+    };
+    bool all = true;
+    for (const Case& c : cases) {
+        std::cout << "  " << std::left << std::setw(36) << c.name << std::right
+                  << (c.ok ? "[OK]" : "[FAIL]") << "\n";
+        all &= c.ok;
+    }
+    return all;
+}
+
+// =============================
+// main() del testbench
+// =============================
+int main() {
+    bool all_ok = true;
+
+    std::cout << "====================================================\n";
+    std::cout << "  CONVERSIONES FP32 <-> FP16 / BF16\n";
+    std::cout << "====================================================\n";
+    all_ok &= check_conversions();
+
+    // Bloques pares e impares (la ultima palabra de 512 bits queda a medias)
+    std::cout << "====================================================\n";
+    std::cout << "  KERNELS FP16 / BF16 vs REFERENCIA\n";
+    std::cout << "====================================================\n";
+    for (unsigned int op = OP_ADD; op <= OP_RCP; ++op) {
+        all_ok &= run_test<fp16_fmt>(op, 1);
+        all_ok &= run_test<fp16_fmt>(op, MAX_BLOCKS);
+        all_ok &= run_test<bf16_fmt>(op, 2);
+        all_ok &= run_test<bf16_fmt>(op, MAX_BLOCKS);
+    }
+
+    if (all_ok) {
+        std::cout << "========================================\n";
+        std::cout << "  TODOS LOS TESTS PASARON (HW == SW)\n";
+        std::cout << "========================================\n";
+        return 0;   // C TB OK → cosim OK
+    } else {
+        std::cout << "========================================\n";
+        std::cout << "  ALGÚN TEST FALLÓ\n";
+        std::cout << "========================================\n";
+        return 1;   // C TB falla → cosim marca FAIL
+    }
+}
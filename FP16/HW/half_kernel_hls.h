@@ -0,0 +1,92 @@
+#ifndef HALF_KERNEL_HLS_H
+#define HALF_KERNEL_HLS_H
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "fp16_ops_hls.h"
+
+// Configuration
+#define N 16
+#define HALF_LANES 32      // Elementos de 16 bits por palabra de 512 bits
+
+typedef ap_uint<512> half_word_t;
+typedef hls::stream<half_word_t> half_stream_t;
+
+// Operation codes (los mismos que FP32/HW/fp32_kernel.cpp)
+typedef enum : unsigned int {
+    OP_ADD = 2,
+    OP_SUB = 3,
+    OP_MUL = 4,
+    OP_DIV = 5,
+    OP_RCP = 6
+} half_op_t;
+
+//=============================================================================
+// ARQUITECTURA: la misma linea base que fp32_kernel (DATAFLOW read A / read B /
+// compute / write, puertos de 512 bits, II=1) con 32 lanes de 16 bits por
+// palabra. fp16_kernel y bf16_kernel solo cambian el formato (Fmt).
+// Los buffers tienen ceil(n_blocks * N / HALF_LANES) palabras completas.
+//=============================================================================
+
+inline unsigned int half_words(unsigned int n_blocks) {
+#pragma HLS INLINE
+    return (n_blocks * N + HALF_LANES - 1) / HALF_LANES;
+}
+
+// Lectura de un operando; si no se usa (A en RCP) el stream recibe ceros
+// sin tocar memoria
+inline void half_read_words(const half_word_t* in, half_stream_t& s, unsigned int n_words, bool enable) {
+#pragma HLS INLINE off
+READ_WORDS:
+    for (unsigned int i = 0; i < n_words; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2048 avg=128
+        s.write(enable ? in[i] : half_word_t(0));
+    }
+}
+
+template<class Fmt>
+uint16_t half_lane_op(unsigned int op, uint16_t a, uint16_t b) {
+#pragma HLS INLINE
+    switch (op) {
+        case OP_SUB: return half_sub<Fmt>(a, b);
+        case OP_MUL: return half_mul<Fmt>(a, b);
+        case OP_DIV: return half_div<Fmt>(a, b);
+        case OP_RCP: return half_rcp<Fmt>(b);
+        default:     return half_add<Fmt>(a, b);
+    }
+}
+
+template<class Fmt>
+void half_compute_words(unsigned int op, half_stream_t& sa, half_stream_t& sb, half_stream_t& sz,
+                        unsigned int n_words) {
+#pragma HLS INLINE off
+COMPUTE_WORDS:
+    for (unsigned int i = 0; i < n_words; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2048 avg=128
+        const half_word_t a = sa.read(), b = sb.read();
+        half_word_t z = 0;
+
+    COMPUTE_LANES:
+        for (int l = 0; l < HALF_LANES; l++) {
+#pragma HLS UNROLL
+            const uint16_t ha = uint16_t(a.range(16 * l + 15, 16 * l));
+            const uint16_t hb = uint16_t(b.range(16 * l + 15, 16 * l));
+            z.range(16 * l + 15, 16 * l) = half_lane_op<Fmt>(op, ha, hb);
+        }
+        sz.write(z);
+    }
+}
+
+inline void half_write_words(half_stream_t& s, half_word_t* out, unsigned int n_words) {
+#pragma HLS INLINE off
+WRITE_WORDS:
+    for (unsigned int i = 0; i < n_words; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2048 avg=128
+        out[i] = s.read();
+    }
+}
+
+#endif // HALF_KERNEL_HLS_H
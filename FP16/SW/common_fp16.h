@@ -0,0 +1,101 @@
+#ifndef COMMON_FP16_H
+#define COMMON_FP16_H
+
+#include <cstdint>
+#include <cstring>
+
+// 16-bit baseline configuration - Same block structure as FP32 / BFP
+#define N 16
+
+// Kernel ports - Must match FP16/HW/half_kernel_hls.h: 512-bit words of HALF_LANES elements
+#define HALF_LANES           32
+#define HALF_KERNEL_FREQ_MHZ 200.0
+#define HALF_PORT_GBPS       (64.0 * HALF_KERNEL_FREQ_MHZ / 1000.0)   // one 512-bit word per cycle
+
+// Operation codes - Same as BFP / FP32 for consistency
+typedef enum : unsigned int {
+    OP_ADD = 2,
+    OP_SUB = 3,
+    OP_MUL = 4,
+    OP_DIV = 5,
+    OP_RCP = 6
+} half_op_t;
+
+// Operation names for display
+static const char* HALF_OP_NAMES[] = {
+    "ADD",
+    "SUB",
+    "MUL",
+    "DIV",
+    "RCP"
+};
+
+// 512-bit words for n_blocks blocks (the buffers are padded to whole words)
+inline unsigned int half_words(unsigned int n_blocks) {
+    return (n_blocks * N + HALF_LANES - 1) / HALF_LANES;
+}
+
+// FP32 <-> 16-bit conversions (RNE) - Must match FP16/HW/fp16_ops_hls.h
+inline uint32_t f32_to_bits(float f) { uint32_t u; std::memcpy(&u, &f, 4); return u; }
+inline float bits_to_f32(uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+// bfloat16: 1-8-7, the upper half of an FP32
+struct bf16_fmt {
+    static constexpr const char* name = "BF16";
+    static constexpr const char* kernel = "bf16_kernel";
+
+    static float to_float(uint16_t h) { return bits_to_f32(uint32_t(h) << 16); }
+    static uint16_t from_float(float f) {
+        const uint32_t u = f32_to_bits(f);
+        if ((u & 0x7FFFFFFFu) > 0x7F800000u) return uint16_t((u >> 16) | 0x0040u);
+        return uint16_t((u + 0x7FFFu + ((u >> 16) & 1u)) >> 16);
+    }
+};
+
+// IEEE binary16: 1-5-10 with subnormals, |x| >= 65520 -> Inf
+struct fp16_fmt {
+    static constexpr const char* name = "FP16";
+    static constexpr const char* kernel = "fp16_kernel";
+
+    static float to_float(uint16_t h) {
+        const uint32_t sign = uint32_t(h & 0x8000u) << 16;
+        const uint32_t e = (h >> 10) & 0x1Fu, m = h & 0x3FFu;
+        if (e == 0x1F) return bits_to_f32(sign | 0x7F800000u | (m << 13));
+        if (e == 0) { const float v = float(m) * (1.0f / 16777216.0f); return sign ? -v : v; }
+        return bits_to_f32(sign | ((e + 112u) << 23) | (m << 13));
+    }
+    static uint16_t from_float(float f) {
+        const uint32_t u = f32_to_bits(f);
+        const uint16_t sign = uint16_t((u >> 16) & 0x8000u);
+        const uint32_t a = u & 0x7FFFFFFFu;
+        if (a > 0x7F800000u) return sign | 0x7E00u;
+        if (a >= 0x477FF000u) return sign | 0x7C00u;
+        if (a < 0x38800000u) {
+            const int e = int(a >> 23);
+            if (e < 102) return sign;
+            const uint32_t mant = (a & 0x7FFFFFu) | 0x800000u;
+            const int shift = 126 - e;
+            uint32_t q = mant >> shift;
+            const uint32_t rem = mant & ((1u << shift) - 1u), half = 1u << (shift - 1);
+            if (rem > half || (rem == half && (q & 1u))) q++;
+            return sign | uint16_t(q);
+        }
+        const uint32_t r = a - 0x38000000u;
+        return sign | uint16_t((r + 0xFFFu + ((r >> 13) & 1u)) >> 13);
+    }
+};
+
+// One element as the kernel computes it: FP32 op, one rounding to the format
+template<class Fmt>
+inline uint16_t half_host_op(unsigned int op, uint16_t a, uint16_t b) {
+    const float fa = Fmt::to_float(a), fb = Fmt::to_float(b);
+    switch (op) {
+        case OP_SUB: return Fmt::from_float(fa - fb);
+        case OP_MUL: return Fmt::from_float(fa * fb);
+        case OP_DIV: return Fmt::from_float(fb == 0.0f ? ((fa >= 0) ? (1.0f/0.0f) : (-1.0f/0.0f)) : fa / fb);
+        case OP_RCP: return Fmt::from_float(fb == 0.0f ? (1.0f/0.0f) : 1.0f / fb);
+        default:     return Fmt::from_float(fa + fb);
+    }
+}
+
+#endif // COMMON_FP16_H
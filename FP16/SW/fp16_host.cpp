@@ -0,0 +1,248 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <string>
+
+// XRT includes
+#include "experimental/xrt_bo.h"
+#include "experimental/xrt_device.h"
+#include "experimental/xrt_kernel.h"
+
+// Profiler
+#include "timer.hpp"
+
+// FP16 / BF16 common definitions
+#include "common_fp16.h"
+
+// Same input tensors as SW/bfp_host and FP32/SW/fp32_host
+#include "../../SW/test_patterns.h"
+
+// Helper to compute metrics (MAE, MAPE and max relative error)
+void compute_metrics(const float* ref, const float* got, unsigned int len,
+                     double& mae, double& mape, double& max_rel) {
+    double abs_sum = 0.0, ape_sum = 0.0;
+    unsigned int mape_cnt = 0;
+    max_rel = 0.0;
+    for (unsigned int i = 0; i < len; ++i) {
+        const double r = ref[i], g = got[i];
+        const double ae = std::fabs(g - r);
+        abs_sum += ae;
+        if (std::fabs(r) > 1e-12) {
+            ape_sum += ae / std::fabs(r);
+            max_rel = std::max(max_rel, ae / std::fabs(r));
+            ++mape_cnt;
+        }
+    }
+    mae = abs_sum / double(len);
+    mape = (mape_cnt ? (ape_sum / double(mape_cnt)) * 100.0 : 0.0);
+}
+
+// FP32 golden: the same reference as FP32/SW/fp32_host
+float fp32_golden(unsigned int op, float a, float b) {
+    switch (op) {
+        case OP_ADD: return a + b;
+        case OP_SUB: return a - b;
+        case OP_MUL: return a * b;
+        case OP_DIV:
+            if (b == 0.0f) return (a >= 0.0f) ? std::numeric_limits<float>::infinity()
+                                               : -std::numeric_limits<float>::infinity();
+            return a / b;
+        default:
+            return (b == 0.0f) ? std::numeric_limits<float>::infinity() : 1.0f / b;
+    }
+}
+
+template<class Fmt>
+int run(unsigned int operation, unsigned int n_blocks) {
+    INIT_PROFILER(half_profiler)
+    int device_index = 0;
+    static std::string binaryFile = "../HW/package.hw/half_kernels.xclbin";
+
+    std::cout << "========================================" << std::endl;
+    std::cout << Fmt::name << " Accelerator Test" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "Operation: " << HALF_OP_NAMES[operation-2]
+              << " (" << operation << ")" << std::endl;
+    std::cout << "Number of blocks: " << n_blocks << std::endl;
+    std::cout << "Block size (N): " << N << std::endl;
+    std::cout << std::endl;
+
+    // Compute sizes: whole 512-bit words of HALF_LANES elements
+    const unsigned int size = n_blocks * N;
+    const unsigned int n_words = half_words(n_blocks);
+    const unsigned int size_padded = n_words * HALF_LANES;
+
+    GET_PROFILE_INSTANCE(setup_time, half_profiler);
+    setup_time->reset();
+
+    std::cout << "Opening device " << device_index << "..." << std::endl;
+    auto device = xrt::device(device_index);
+
+    std::cout << "Loading xclbin: " << binaryFile << "..." << std::endl;
+    auto uuid = device.load_xclbin(binaryFile);
+
+    std::cout << "Creating kernel handle (" << Fmt::kernel << ")..." << std::endl;
+    auto half_kernel = xrt::kernel(device, uuid, Fmt::kernel);
+
+    setup_time->tick();
+
+    std::cout << "Allocating buffers in global memory..." << std::endl;
+
+    // Kernel arguments (fp16_kernel / bf16_kernel)
+    //   0: operation (scalar)
+    //   1: n_blocks (scalar)
+    //   2: in_a -> gmem0 (n_words x 512 bits)
+    //   3: in_b -> gmem1
+    //   4: out  -> gmem2
+    const size_t bytes_buf = size_t(size_padded) * sizeof(uint16_t);
+    auto bo_in_a = xrt::bo(device, bytes_buf, half_kernel.group_id(2));
+    auto bo_in_b = xrt::bo(device, bytes_buf, half_kernel.group_id(3));
+    auto bo_out  = xrt::bo(device, bytes_buf, half_kernel.group_id(4));
+
+    auto bo_in_a_map = bo_in_a.map<uint16_t*>();
+    auto bo_in_b_map = bo_in_b.map<uint16_t*>();
+    auto bo_out_map  = bo_out.map<uint16_t*>();
+    std::fill(bo_in_a_map, bo_in_a_map + size_padded, uint16_t(0));
+    std::fill(bo_in_b_map, bo_in_b_map + size_padded, uint16_t(0));
+    std::fill(bo_out_map, bo_out_map + size_padded, uint16_t(0));
+
+    // Same FP32 tensors as bfp_host / fp32_host, rounded to the format
+    std::cout << "Preparing test data..." << std::endl;
+    std::vector<float> A_fp(size), B_fp(size), golden_ref(size);
+    std::vector<uint16_t> ref_bits(size);
+    for (unsigned int i = 0; i < size; ++i) {
+        A_fp[i] = test_pattern_a(i);
+        B_fp[i] = test_pattern_b(i);
+        bo_in_a_map[i] = Fmt::from_float(A_fp[i]);
+        bo_in_b_map[i] = Fmt::from_float(B_fp[i]);
+        golden_ref[i] = fp32_golden(operation, A_fp[i], B_fp[i]);
+        ref_bits[i] = half_host_op<Fmt>(operation, bo_in_a_map[i], bo_in_b_map[i]);
+    }
+
+    std::cout << "Syncing input buffers to device..." << std::endl;
+
+    START_PROFILE(kernel_execution, half_profiler, 10)
+
+    if (operation != OP_RCP) bo_in_a.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+    bo_in_b.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+
+    std::cout << "Executing kernel: " << HALF_OP_NAMES[operation-2] << "..." << std::endl;
+    auto run = half_kernel(operation, n_blocks, bo_in_a, bo_in_b, bo_out);
+    run.wait();
+    std::cout << "Kernel completed!" << std::endl;
+
+    std::cout << "Reading output buffers from device..." << std::endl;
+    bo_out.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+
+    END_PROFILE(kernel_execution);
+
+    // Kernel alone (inputs already on the device): the throughput figures
+    START_PROFILE(kernel_only, half_profiler, 10)
+    half_kernel(operation, n_blocks, bo_in_a, bo_in_b, bo_out).wait();
+    END_PROFILE(kernel_only);
+
+    std::vector<float> got(size);
+    unsigned int bit_mismatches = 0;
+    for (unsigned int i = 0; i < size; ++i) {
+        got[i] = Fmt::to_float(bo_out_map[i]);
+        if (bo_out_map[i] != ref_bits[i]) ++bit_mismatches;
+    }
+
+    // Display results
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Results" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::cout << "\nFirst block - " << HALF_OP_NAMES[operation-2]
+              << " result (first 8 elements):" << std::endl;
+    for (int i = 0; i < 8; ++i) {
+        std::cout << "  [" << i << "] ";
+        if (operation == OP_RCP) {
+            std::cout << "1 / " << B_fp[i] << " = " << got[i];
+        } else {
+            std::cout << A_fp[i];
+            switch(operation) {
+                case OP_ADD: std::cout << " + "; break;
+                case OP_SUB: std::cout << " - "; break;
+                case OP_MUL: std::cout << " * "; break;
+                case OP_DIV: std::cout << " / "; break;
+            }
+            std::cout << B_fp[i] << " = " << got[i];
+        }
+        std::cout << " (FP32: " << golden_ref[i] << ", " << Fmt::name << ": 0x"
+                  << std::hex << std::setw(4) << std::setfill('0') << bo_out_map[i]
+                  << std::dec << std::setfill(' ') << ")" << std::endl;
+    }
+
+    // Error against FP32 (inputs and result rounded to 16 bits)
+    double mae = 0.0, mape = 0.0, max_rel = 0.0;
+    compute_metrics(golden_ref.data(), got.data(), size, mae, mape, max_rel);
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Accuracy Metrics (vs FP32)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "MAE:  " << mae << std::endl;
+    std::cout << "MAPE: " << mape << "%" << std::endl;
+    std::cout << "Max relative error: " << max_rel * 100.0 << "%" << std::endl;
+    std::cout << "Bit mismatches vs host " << Fmt::name << ": " << bit_mismatches << std::endl;
+
+    // Kernel bit-exact with the host model; error bounded by the format precision
+    const double mape_limit = (std::strcmp(Fmt::name, "FP16") == 0) ? 0.1 : 1.0;
+    bool passed = (bit_mismatches == 0 && mape < mape_limit);
+    std::cout << "\n" << (passed ? "✓ TEST PASSED" : "✗ TEST FAILED") << std::endl;
+
+    // Throughput of the kernel alone (printing the profiler consumes the samples)
+    double kernel_s = 0.0;
+    for (double t : kernel_only->samples) kernel_s += t;
+    if (!kernel_only->samples.empty()) kernel_s /= kernel_only->samples.size();
+
+    const unsigned int streams = (operation == OP_RCP) ? 2 : 3;   // RCP does not read A
+    const double bytes = double(streams) * n_words * 64.0;
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Throughput (kernel only, " << HALF_LANES << " lanes x 512-bit ports)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  time:        " << kernel_s * 1e6 << " us" << std::endl;
+    std::cout << "  bytes moved: " << bytes << " (" << streams << " x " << n_words
+              << " words of 64 B; FP32 moves 2x)" << std::endl;
+    std::cout << "  bandwidth:   " << (kernel_s > 0 ? bytes / kernel_s / 1e9 : 0.0) << " GB/s" << std::endl;
+    std::cout << "  ops/s:       " << (kernel_s > 0 ? double(size) / kernel_s : 0.0)
+              << " (" << size << " ops)" << std::endl;
+    std::cout << "  roofline:    " << streams * HALF_PORT_GBPS << " GB/s ("
+              << streams << " ports x " << HALF_PORT_GBPS << " GB/s @ " << HALF_KERNEL_FREQ_MHZ
+              << " MHz)" << std::endl;
+
+    std::cout << "\n" << half_profiler << std::endl;
+    std::cout << "\n========================================" << std::endl;
+
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <format> <operation> <n_blocks>" << std::endl;
+        std::cerr << "  format: fp16 or bf16" << std::endl;
+        std::cerr << "  operation: 2=ADD, 3=SUB, 4=MUL, 5=DIV, 6=RCP" << std::endl;
+        std::cerr << "  n_blocks: number of blocks (e.g., 2)" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Get input parameters
+    const std::string format = argv[1];
+    unsigned int operation = std::stoi(argv[2]);
+    unsigned int n_blocks  = std::stoi(argv[3]);
+
+    if (operation < 2 || operation > 6) {
+        std::cerr << "Error: Invalid operation code. Must be 2-6" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (format == "fp16") return run<fp16_fmt>(operation, n_blocks);
+    if (format == "bf16") return run<bf16_fmt>(operation, n_blocks);
+
+    std::cerr << "Error: Invalid format '" << format << "' (expected fp16 or bf16)" << std::endl;
+    return EXIT_FAILURE;
+}
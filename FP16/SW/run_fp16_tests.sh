@@ -0,0 +1,47 @@
+#!/bin/bash
+# Test script for FP16 / BF16 baseline Accelerators
+
+set -e
+
+# Colors for output
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m'
+
+EXECUTABLE="./fp16_host"
+# Número de bloques por defecto (puedes cambiarlo)
+N_BLOCKS=${N_BLOCKS:-4}
+
+echo "========================================"
+echo "FP16 / BF16 Accelerator Test Suite"
+echo "========================================"
+echo ""
+
+# Temporary file for capturing output
+TMPFILE=$(mktemp)
+
+# Same data set and operations for both formats
+for fmt in fp16 bf16; do
+    for op in 2 3 4 5 6; do
+        case $op in
+            2) opname="ADD" ;;
+            3) opname="SUB" ;;
+            4) opname="MUL" ;;
+            5) opname="DIV" ;;
+            6) opname="RCP" ;;
+        esac
+
+        echo "========================================"
+        echo -e "${BLUE}Testing ${fmt} ${opname} (op=$op) with $N_BLOCKS blocks${NC}"
+        echo "========================================"
+        $EXECUTABLE $fmt $op $N_BLOCKS | tee $TMPFILE
+        echo -e "${GREEN}${fmt} ${opname}:$(grep "bandwidth:" $TMPFILE | cut -d: -f2),$(grep "ops/s:" $TMPFILE | cut -d: -f2), MAPE$(grep "MAPE:" $TMPFILE | cut -d: -f2)${NC}"
+        echo ""
+    done
+done
+
+rm -f $TMPFILE
+
+echo "========================================"
+echo -e "${GREEN}✓ All FP16 / BF16 tests completed!${NC}"
+echo "========================================"
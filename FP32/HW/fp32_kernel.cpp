@@ -1,10 +1,15 @@
 #include <ap_int.h>
+#include <hls_stream.h>
 #include "fp32_ops_hls.h"
 
 // Configuration
 #define N 16
+#define FP32_LANES 16      // Floats por palabra de 512 bits (un bloque de N por beat)
 
-using blk_t = float[N];
+static_assert(N % FP32_LANES == 0, "N debe ser multiplo de FP32_LANES");
+
+typedef ap_uint<512> fp32_word_t;
+typedef hls::stream<fp32_word_t> fp32_stream_t;
 
 // Operation codes
 typedef enum : unsigned int {
@@ -15,6 +20,75 @@ typedef enum : unsigned int {
     OP_RCP = 6
 } fp32_op_t;
 
+//=============================================================================
+// ARQUITECTURA: linea base FP32 para comparar con BFP en el techo de memoria
+//   READ A --+
+//            +--> COMPUTE (FP32_LANES ops por ciclo) --> WRITE Z
+//   READ B --+
+// Cuatro procesos en DATAFLOW unidos por streams. Cada puerto m_axi es de
+// 512 bits (16 floats por beat), tiene su propio bundle y hace bursts largos.
+// Todos los bucles tienen II=1, asi que el kernel mueve una palabra por puerto
+// y ciclo y su tiempo lo fija el ancho de banda, no la aritmetica.
+// La semantica por elemento es la de fp32_*_blocks (x/0 = +-Inf, 1/0 = +Inf).
+//=============================================================================
+
+// Lectura de un operando; si no se usa (A en RCP) el stream recibe ceros
+// sin tocar memoria
+void read_words(const fp32_word_t* in, fp32_stream_t& s, unsigned int n_words, bool enable) {
+#pragma HLS INLINE off
+READ_WORDS:
+    for (unsigned int i = 0; i < n_words; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096 avg=256
+        s.write(enable ? in[i] : fp32_word_t(0));
+    }
+}
+
+// Operacion de un lane (misma semantica que fp32_ops_hls.h)
+float fp32_lane_op(unsigned int op, float a, float b) {
+#pragma HLS INLINE
+    switch (op) {
+        case OP_SUB: return a - b;
+        case OP_MUL: return a * b;
+        case OP_DIV: return (b == 0.0f) ? ((a >= 0) ? (1.0f/0.0f) : (-1.0f/0.0f)) : a / b;
+        case OP_RCP: return (b == 0.0f) ? (1.0f/0.0f) : 1.0f / b;
+        default:     return a + b;
+    }
+}
+
+void compute_words(unsigned int op, fp32_stream_t& sa, fp32_stream_t& sb, fp32_stream_t& sz,
+                   unsigned int n_words) {
+#pragma HLS INLINE off
+COMPUTE_WORDS:
+    for (unsigned int i = 0; i < n_words; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096 avg=256
+        float a[FP32_LANES], b[FP32_LANES], z[FP32_LANES];
+#pragma HLS ARRAY_PARTITION variable=a complete
+#pragma HLS ARRAY_PARTITION variable=b complete
+#pragma HLS ARRAY_PARTITION variable=z complete
+        word_to_lanes<FP32_LANES>(sa.read(), a);
+        word_to_lanes<FP32_LANES>(sb.read(), b);
+
+    COMPUTE_LANES:
+        for (int l = 0; l < FP32_LANES; l++) {
+#pragma HLS UNROLL
+            z[l] = fp32_lane_op(op, a[l], b[l]);
+        }
+        sz.write(lanes_to_word<FP32_LANES, fp32_word_t>(z));
+    }
+}
+
+void write_words(fp32_stream_t& s, fp32_word_t* out, unsigned int n_words) {
+#pragma HLS INLINE off
+WRITE_WORDS:
+    for (unsigned int i = 0; i < n_words; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=4096 avg=256
+        out[i] = s.read();
+    }
+}
+
 //=============================================================================
 // MAIN FP32 KERNEL
 //=============================================================================
@@ -22,59 +96,36 @@ extern "C" {
 void fp32_kernel(
     const unsigned int operation,
     const unsigned int n_blocks,
-    const float* in_fp32_a,
-    const float* in_fp32_b,
-    float* out_fp32
+    const fp32_word_t* in_fp32_a,     // n_blocks * N floats, 16 por palabra
+    const fp32_word_t* in_fp32_b,
+    fp32_word_t* out_fp32
 ) {
 
 #pragma HLS INTERFACE s_axilite port=operation
 #pragma HLS INTERFACE s_axilite port=n_blocks
 #pragma HLS INTERFACE s_axilite port=return
 
-  // Interface pragmas
+  // Interface pragmas: 512-bit ports, one bundle each, long bursts
     #pragma HLS INTERFACE m_axi port=in_fp32_a offset=slave bundle=gmem0 \
-        depth=64 max_read_burst_length=16 num_read_outstanding=4
+        depth=4 max_read_burst_length=64 num_read_outstanding=16
 
     #pragma HLS INTERFACE m_axi port=in_fp32_b offset=slave bundle=gmem1 \
-        depth=64 max_read_burst_length=16 num_read_outstanding=4
+        depth=4 max_read_burst_length=64 num_read_outstanding=16
 
     #pragma HLS INTERFACE m_axi port=out_fp32 offset=slave bundle=gmem2 \
-        depth=64 max_write_burst_length=16 num_write_outstanding=4
-
-    const unsigned int total = n_blocks * N;
-
-    // ==================== LOAD A ====================
-    float A[N];
-    float B[N];
-    float Z[N];
-
-LOAD_A:
-    for (int blk = 0; blk < n_blocks; blk++) {
-        const unsigned int offset = blk * N;
-
-        for (int i = 0; i < N; i++) {
-#pragma HLS PIPELINE II=1
-            A[i] = in_fp32_a[offset + i];
-        }
+        depth=4 max_write_burst_length=64 num_write_outstanding=16
 
-        for (int i = 0; i < N; i++) {
-#pragma HLS PIPELINE II=1
-            B[i] = in_fp32_b[offset + i];
-        }
+    const unsigned int n_words = n_blocks * (N / FP32_LANES);
 
-        switch (operation) {
-            case OP_ADD: fp32_add_blocks<N>(A, B, Z); break;
-            case OP_SUB: fp32_sub_blocks<N>(A, B, Z); break;
-            case OP_MUL: fp32_mul_blocks<N>(A, B, Z); break;
-            case OP_DIV: fp32_div_blocks<N>(A, B, Z); break;
-            case OP_RCP: fp32_rcp_blocks<N>(B, Z); break;
-            default:     fp32_add_blocks<N>(A, B, Z); break;
-        }
+    fp32_stream_t sa("sa"), sb("sb"), sz("sz");
+#pragma HLS STREAM variable=sa depth=64
+#pragma HLS STREAM variable=sb depth=64
+#pragma HLS STREAM variable=sz depth=64
 
-        for (int i = 0; i < N; i++) {
-#pragma HLS PIPELINE II=1
-            out_fp32[offset + i] = Z[i];
-        }
-    }
+#pragma HLS DATAFLOW
+    read_words(in_fp32_a, sa, n_words, operation != OP_RCP);
+    read_words(in_fp32_b, sb, n_words, true);
+    compute_words(operation, sa, sb, sz, n_words);
+    write_words(sz, out_fp32, n_words);
 }
 }
@@ -111,4 +111,32 @@ RCP_ELEMENTS:
     }
 }
 
+//=============================================================================
+// FP32 <-> PALABRA DE 512 BITS (lane i en los bits [32*i + 31 : 32*i])
+//=============================================================================
+template<std::size_t Lanes, class Word>
+void word_to_lanes(const Word& w, float x[Lanes]) {
+#pragma HLS INLINE
+UNPACK_LANES:
+    for (std::size_t i = 0; i < Lanes; ++i) {
+#pragma HLS UNROLL
+        union {uint32_t u; float f;} c;
+        c.u = uint32_t(w.range(32 * int(i) + 31, 32 * int(i)));
+        x[i] = c.f;
+    }
+}
+
+template<std::size_t Lanes, class Word>
+Word lanes_to_word(const float x[Lanes]) {
+#pragma HLS INLINE
+    Word w = 0;
+PACK_LANES:
+    for (std::size_t i = 0; i < Lanes; ++i) {
+#pragma HLS UNROLL
+        union {float f; uint32_t u;} c = {x[i]};
+        w.range(32 * int(i) + 31, 32 * int(i)) = c.u;
+    }
+    return w;
+}
+
 #endif // FP32_OPS_HLS_H
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <cmath>
 #include <limits>
+#include <ap_int.h>
 
 // Incluimos las mismas operaciones de referencia
 #include "fp32_ops_hls.h"
@@ -15,14 +16,17 @@
 // =============================
 // Prototipo del kernel HLS
 // (usa EXACTAMENTE la misma firma que en fp32_kernel.cpp)
+// Puertos de 512 bits: 16 floats por palabra
 // =============================
+typedef ap_uint<512> fp32_word_t;
+
 extern "C" {
 void fp32_kernel(
     const unsigned int operation,
     const unsigned int n_blocks,
-    const float* in_fp32_a,
-    const float* in_fp32_b,
-    float* out_fp32
+    const fp32_word_t* in_fp32_a,
+    const fp32_word_t* in_fp32_b,
+    fp32_word_t* out_fp32
 );
 }
 
@@ -39,10 +43,11 @@ typedef enum : unsigned int {
 
 // =============================
 // Buffers globales para que HLS los vea claros
+// (alineados a la palabra de 512 bits del kernel)
 // =============================
-static float A[TOTAL_ELEMS];
-static float B[TOTAL_ELEMS];
-static float Z_hw[TOTAL_ELEMS];   // salida del kernel
+alignas(64) static float A[TOTAL_ELEMS];
+alignas(64) static float B[TOTAL_ELEMS];
+alignas(64) static float Z_hw[TOTAL_ELEMS];   // salida del kernel
 static float Z_sw[TOTAL_ELEMS];   // salida de referencia en C
 
 // =============================
@@ -168,7 +173,8 @@ bool run_test(unsigned int op, unsigned int n_blocks) {
     compute_reference(op, n_blocks);
 
     // 3) Llamar al kernel HLS
-    fp32_kernel(op, n_blocks, A, B, Z_hw);
+    fp32_kernel(op, n_blocks, reinterpret_cast<const fp32_word_t*>(A),
+                reinterpret_cast<const fp32_word_t*>(B), reinterpret_cast<fp32_word_t*>(Z_hw));
 
     // 4) Comparar HW vs SW
     return check_results(op, n_blocks);
@@ -187,22 +193,27 @@ int main() {
     // ADD
     all_ok &= run_test(OP_ADD, n_blocks1);
     all_ok &= run_test(OP_ADD, n_blocks2);
+    all_ok &= run_test(OP_ADD, MAX_BLOCKS);
 
     // SUB
     all_ok &= run_test(OP_SUB, n_blocks1);
     all_ok &= run_test(OP_SUB, n_blocks2);
+    all_ok &= run_test(OP_SUB, MAX_BLOCKS);
 
     // MUL
     all_ok &= run_test(OP_MUL, n_blocks1);
     all_ok &= run_test(OP_MUL, n_blocks2);
+    all_ok &= run_test(OP_MUL, MAX_BLOCKS);
 
     // DIV
     all_ok &= run_test(OP_DIV, n_blocks1);
     all_ok &= run_test(OP_DIV, n_blocks2);
+    all_ok &= run_test(OP_DIV, MAX_BLOCKS);
 
     // RCP
     all_ok &= run_test(OP_RCP, n_blocks1);
     all_ok &= run_test(OP_RCP, n_blocks2);
+    all_ok &= run_test(OP_RCP, MAX_BLOCKS);
 
     if (all_ok) {
         std::cout << "========================================\n";
@@ -9,6 +9,11 @@
 // For consistency with BFP interface
 #define FP32_BLOCK_SIZE N
 
+// Kernel ports - Must match fp32_kernel.cpp: 512-bit words of FP32_LANES floats
+#define FP32_LANES           16
+#define FP32_KERNEL_FREQ_MHZ 200.0
+#define FP32_PORT_GBPS       (64.0 * FP32_KERNEL_FREQ_MHZ / 1000.0)   // one 512-bit word per cycle
+
 // Operation codes - Same as BFP for consistency
 typedef enum : unsigned int {
     OP_ADD = 2,
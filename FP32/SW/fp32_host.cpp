@@ -17,6 +17,9 @@
 // FP32 common definitions
 #include "common_fp32.h"
 
+// Same input tensors as SW/bfp_host
+#include "../../SW/test_patterns.h"
+
 // Helper to compute metrics (MAE and MAPE)
 void compute_metrics(const float* ref, const float* got, unsigned int len,
                      double& mae, double& mape) {
@@ -108,41 +111,14 @@ int main(int argc, char** argv) {
     // Prepare test data
     std::cout << "Preparing test data..." << std::endl;
 
-    float A0[N] = {
-        12.35f,  6.50f, 10.20f,  6.60f,  8.80f,  2.56f, 11.11f,  8.00f,
-         5.45f,  9.99f,  0.15f, 18.00f,  3.80f, 90.10f, 14.00f, 10.00f
-    };
-    float A1[N] = {
-         1.0f,  2.0f,  3.0f,  4.0f,  5.0f,  6.0f,  7.0f,  8.0f,
-         9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f
-    };
-    float B0[N] = {
-        2.0f, 1.0f, 2.0f, 3.0f, 2.0f, 2.0f, 2.0f, 2.0f,
-        3.0f, 3.0f, 5.0f, 3.0f, 6.0f, 3.0f, 8.0f, 2.0f
-    };
-    float B1[N] = {
-        15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f,  9.0f,  8.0f,
-         7.0f,  6.0f,  5.0f,  4.0f,  3.0f,  2.0f,  1.0f,  0.5f
-    };
-
     // Vectores host
     std::vector<float> A_fp(size_fp32), B_fp(size_fp32);
     std::vector<float> golden_ref(size_fp32);
 
-    // Fill data for all blocks
-    for (unsigned int blk = 0; blk < n_blocks; ++blk) {
-        unsigned int offset = blk * N;
-
-        switch (blk % 2) {
-            case 0:
-                std::memcpy(&A_fp[offset], A0, sizeof(float) * N);
-                std::memcpy(&B_fp[offset], B0, sizeof(float) * N);
-                break;
-            case 1:
-                std::memcpy(&A_fp[offset], A1, sizeof(float) * N);
-                std::memcpy(&B_fp[offset], B1, sizeof(float) * N);
-                break;
-        }
+    // Fill data for all blocks: same tensors as bfp_host (SW/test_patterns.h)
+    for (unsigned int i = 0; i < size_fp32; ++i) {
+        A_fp[i] = test_pattern_a(i);
+        B_fp[i] = test_pattern_b(i);
     }
 
     // Compute golden reference (software implementation)
@@ -208,6 +184,11 @@ int main(int argc, char** argv) {
 
     END_PROFILE(kernel_execution);
 
+    // Kernel alone (inputs already on the device): the throughput figures
+    START_PROFILE(kernel_only, fp32_profiler, 10)
+    fp32_kernel(operation, n_blocks, bo_in_fp32_a, bo_in_fp32_b, bo_out_fp32).wait();
+    END_PROFILE(kernel_only);
+
     // Display results
     std::cout << "\n========================================" << std::endl;
     std::cout << "Results" << std::endl;
@@ -250,6 +231,25 @@ int main(int argc, char** argv) {
     bool passed = (mae < 1e-6 && mape < 0.001);
     std::cout << "\n" << (passed ? "✓ TEST PASSED" : "✗ TEST FAILED") << std::endl;
 
+    // Throughput of the kernel alone (printing the profiler consumes the samples)
+    double kernel_s = 0.0;
+    for (double t : kernel_only->samples) kernel_s += t;
+    if (!kernel_only->samples.empty()) kernel_s /= kernel_only->samples.size();
+
+    const unsigned int streams = (operation == OP_RCP) ? 2 : 3;   // RCP does not read A
+    const double bytes = double(streams) * size_fp32 * sizeof(float);
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Throughput (kernel only, " << FP32_LANES << " lanes x 512-bit ports)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  time:      " << kernel_s * 1e6 << " us" << std::endl;
+    std::cout << "  bandwidth: " << (kernel_s > 0 ? bytes / kernel_s / 1e9 : 0.0) << " GB/s ("
+              << bytes << " bytes)" << std::endl;
+    std::cout << "  ops/s:     " << (kernel_s > 0 ? double(size_fp32) / kernel_s : 0.0)
+              << " (" << size_fp32 << " ops)" << std::endl;
+    std::cout << "  roofline:  " << streams * FP32_PORT_GBPS << " GB/s ("
+              << streams << " ports x " << FP32_PORT_GBPS << " GB/s @ " << FP32_KERNEL_FREQ_MHZ
+              << " MHz)" << std::endl;
+
     std::cout << "\n" << fp32_profiler << std::endl;
     std::cout << "\n========================================" << std::endl;
 
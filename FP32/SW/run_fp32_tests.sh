@@ -17,6 +17,9 @@ echo "FP32 Accelerator Test Suite"
 echo "========================================"
 echo ""
 
+# Temporary file for capturing output
+TMPFILE=$(mktemp)
+
 # Test operations
 for op in 2 3 4 5 6; do
     case $op in
@@ -30,10 +33,13 @@ for op in 2 3 4 5 6; do
     echo "========================================"
     echo -e "${BLUE}Testing ${opname} (op=$op) with $N_BLOCKS blocks${NC}"
     echo "========================================"
-    $EXECUTABLE $op $N_BLOCKS
+    $EXECUTABLE $op $N_BLOCKS | tee $TMPFILE
+    echo -e "${GREEN}${opname}:$(grep "bandwidth:" $TMPFILE | cut -d: -f2),$(grep "ops/s:" $TMPFILE | cut -d: -f2)${NC}"
     echo ""
 done
 
+rm -f $TMPFILE
+
 echo "========================================"
 echo -e "${GREEN}✓ All FP32 tests completed!${NC}"
 echo "========================================"
@@ -0,0 +1,204 @@
+#ifndef BFP_ACT_HLS_H
+#define BFP_ACT_HLS_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "bfp_hls.h"
+
+//*============================================================================
+//* ACTIVACIONES POR TABLA SOBRE MANTISAS BFP (GELU, SiLU, tanh, sigmoid, exp)
+//*
+//* Un lane vale (-1)^s * mant * 2^(E - bias - wm). Con p = posicion del 1 mas
+//* alto de mant, |x| esta en la octava [2^e, 2^(e+1)), e = E - bias - wm + p,
+//* y los bits bajo el 1 son la fraccion. La tabla se indexa con (signo, e,
+//* ACT_TABLE_BITS bits altos de la fraccion) y los bits restantes interpolan
+//* linealmente entre dos nodos: no se decodifica el lane a FP32.
+//*   |x| < 2^ACT_E_LO : aproximacion de x pequeño (Taylor de orden 1-2)
+//*   |x| >= 2^ACT_E_HI: valor de saturacion (exp satura a Inf / 0)
+//* Las tablas se generan en tiempo de compilacion (constexpr) para cada
+//* BFP_bias<WE, WM>: con WM < ACT_TABLE_BITS la tabla es exacta.
+//*============================================================================
+enum : unsigned int {
+    ACT_GELU    = 0,
+    ACT_SILU    = 1,
+    ACT_TANH    = 2,
+    ACT_SIGMOID = 3,
+    ACT_EXP     = 4,
+    ACT_KINDS   = 5
+};
+
+static constexpr int ACT_E_LO       = -8;   // octavas tabuladas: [2^-8, 2^4)
+static constexpr int ACT_E_HI       = 4;
+static constexpr int ACT_OCTAVES    = ACT_E_HI - ACT_E_LO;
+static constexpr int ACT_TABLE_BITS = 6;
+
+//----------------------------------------------------------------------------
+// Matematica constexpr para generar las tablas (double)
+//----------------------------------------------------------------------------
+constexpr double act_ce_exp(double x) {
+    constexpr double LN2 = 0.69314718055994530942;
+    if (x > 700.0) return std::numeric_limits<double>::infinity();
+    if (x < -700.0) return 0.0;
+    int k = int(x / LN2 + (x >= 0.0 ? 0.5 : -0.5));
+    const double r = x - double(k) * LN2;   // |r| <= ln2 / 2
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 24; n++) {
+        term *= r / double(n);
+        sum += term;
+    }
+    for (; k > 0; k--) sum *= 2.0;
+    for (; k < 0; k++) sum *= 0.5;
+    return sum;
+}
+
+constexpr double act_ce_erf(double z) {
+    constexpr double SQRT_PI = 1.77245385090551602730;
+    const bool neg = z < 0.0;
+    if (neg) z = -z;
+    double r = 0.0;
+    if (z < 2.5) {
+        // Serie de Taylor: 2/sqrt(pi) * sum (-1)^n z^(2n+1) / (n! (2n+1))
+        double term = z, sum = z;
+        for (int n = 1; n < 64; n++) {
+            term *= -z * z / double(n);
+            sum += term / double(2 * n + 1);
+        }
+        r = 2.0 / SQRT_PI * sum;
+    } else {
+        // Fraccion continua de erfc: z + (1/2)/(z + (2/2)/(z + (3/2)/(z + ...)))
+        double f = z;
+        for (int k = 60; k >= 1; k--) f = z + (double(k) / 2.0) / f;
+        r = 1.0 - act_ce_exp(-z * z) / (SQRT_PI * f);
+    }
+    return neg ? -r : r;
+}
+
+constexpr double act_ce_eval(unsigned int kind, double x) {
+    constexpr double INV_SQRT2 = 0.70710678118654752440;
+    switch (kind) {
+        case ACT_GELU:    return 0.5 * x * (1.0 + act_ce_erf(x * INV_SQRT2));
+        case ACT_SILU:    return x / (1.0 + act_ce_exp(-x));
+        case ACT_TANH:    return 1.0 - 2.0 / (act_ce_exp(2.0 * x) + 1.0);
+        case ACT_SIGMOID: return 1.0 / (1.0 + act_ce_exp(-x));
+        default:          return act_ce_exp(x);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Tabla por funcion y formato: v[signo][octava][nodo]
+// nodo k de la octava e: (1 + k / 2^T) * 2^e,  T = min(WM, ACT_TABLE_BITS)
+//----------------------------------------------------------------------------
+template<class Cfg, unsigned int Kind>
+struct BFP_ActTable {
+    static constexpr int bits = (Cfg::wm < ACT_TABLE_BITS) ? Cfg::wm : ACT_TABLE_BITS;
+    static constexpr int segs = 1 << bits;
+
+    float v[2][ACT_OCTAVES][segs + 1];
+
+    constexpr BFP_ActTable() : v{} {
+        for (int s = 0; s < 2; s++) {
+            for (int o = 0; o < ACT_OCTAVES; o++) {
+                double scale = 1.0;
+                for (int e = ACT_E_LO + o; e > 0; e--) scale *= 2.0;
+                for (int e = ACT_E_LO + o; e < 0; e++) scale *= 0.5;
+                for (int k = 0; k <= segs; k++) {
+                    const double x = (1.0 + double(k) / double(segs)) * scale;
+                    v[s][o][k] = float(act_ce_eval(Kind, s ? -x : x));
+                }
+            }
+        }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Un lane: (signo, mant, exponente compartido) -> f(x) en FP32
+//----------------------------------------------------------------------------
+template<class Cfg, unsigned int Kind>
+float act_lane(uint32_t sign, uint32_t mant, uint32_t exp_shared) {
+#pragma HLS INLINE
+    static constexpr BFP_ActTable<Cfg, Kind> tbl{};
+    constexpr int bits = BFP_ActTable<Cfg, Kind>::bits;
+
+    // f(0)
+    if (mant == 0u) {
+        return (Kind == ACT_SIGMOID) ? 0.5f : (Kind == ACT_EXP) ? 1.0f : 0.0f;
+    }
+
+    int p = Cfg::wm;
+ACT_MSB:
+    while (p > 0 && !((mant >> p) & 1u)) p--;
+    const int e = int(exp_shared) - Cfg::bias_bfp - Cfg::wm + p;
+
+    if (e < ACT_E_LO) {
+        // x pequeño: Taylor
+        const float x  = std::ldexp(sign ? -float(mant) : float(mant),
+                                    int(exp_shared) - Cfg::bias_bfp - Cfg::wm);
+        switch (Kind) {
+            case ACT_GELU:    return 0.5f * x + 0.3989422804f * x * x;
+            case ACT_SILU:    return 0.5f * x + 0.25f * x * x;
+            case ACT_TANH:    return x;
+            case ACT_SIGMOID: return 0.5f + 0.25f * x;
+            default:          return 1.0f + x;
+        }
+    }
+
+    if (e >= ACT_E_HI) {
+        // Saturacion
+        const float x  = std::ldexp(sign ? -float(mant) : float(mant),
+                                    int(exp_shared) - Cfg::bias_bfp - Cfg::wm);
+        switch (Kind) {
+            case ACT_GELU:
+            case ACT_SILU:    return sign ? 0.0f : x;
+            case ACT_TANH:    return sign ? -1.0f : 1.0f;
+            case ACT_SIGMOID: return sign ? 0.0f : 1.0f;
+            default:          return sign ? 0.0f : std::numeric_limits<float>::infinity();
+        }
+    }
+
+    // Fraccion bajo el 1 mas alto (wm bits), indice + resto para interpolar
+    const uint32_t frac = (mant << (Cfg::wm - p)) & ((1u << Cfg::wm) - 1u);
+    const uint32_t idx  = frac >> (Cfg::wm - bits);
+    const uint32_t rem  = frac & ((1u << (Cfg::wm - bits)) - 1u);
+    const float t  = std::ldexp(float(rem), bits - Cfg::wm);
+    const float lo = tbl.v[sign][e - ACT_E_LO][idx];
+    const float hi = tbl.v[sign][e - ACT_E_LO][idx + 1];
+    return lo + (hi - lo) * t;
+}
+
+//*============================================================================
+//* ACTIVACION DE UN BLOQUE: f lane a lane y re-codificacion del bloque
+//*============================================================================
+template<class Cfg, std::size_t Block_size, unsigned int Kind>
+BFP_Global<Cfg, Block_size> act_block(const BFP_Global<Cfg, Block_size>& A,
+                                      BFP_Stats<Cfg>& st,
+                                      BFP_Lfsr& rng) {
+#pragma HLS INLINE off
+    std::array<float, Block_size> ys{};
+
+ACT_LANES:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+        ys[i] = act_lane<Cfg, Kind>(A.sign[i], A.mant[i], A.exp_shared);
+    }
+    return encode_block<Cfg, Block_size>(ys, st, rng);
+}
+
+// Seleccion en tiempo de ejecucion (kind = ACT_*); cada funcion tiene su tabla
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> act_blocks(unsigned int kind,
+                                       const BFP_Global<Cfg, Block_size>& A,
+                                       BFP_Stats<Cfg>& st,
+                                       BFP_Lfsr& rng) {
+#pragma HLS INLINE off
+    switch (kind) {
+        case ACT_GELU:    return act_block<Cfg, Block_size, ACT_GELU>(A, st, rng);
+        case ACT_SILU:    return act_block<Cfg, Block_size, ACT_SILU>(A, st, rng);
+        case ACT_TANH:    return act_block<Cfg, Block_size, ACT_TANH>(A, st, rng);
+        case ACT_SIGMOID: return act_block<Cfg, Block_size, ACT_SIGMOID>(A, st, rng);
+        default:          return act_block<Cfg, Block_size, ACT_EXP>(A, st, rng);
+    }
+}
+
+#endif // BFP_ACT_HLS_H
@@ -0,0 +1,77 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_ops_hls.h"
+#include "bfp_stream_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+// Operation codes (mismos valores que bfp_kernel)
+typedef enum : unsigned int {
+    OP_ADD = 2,
+    OP_SUB = 3,
+    OP_MUL = 4,
+    OP_DIV = 5,
+    OP_RCP = 6
+} bfp_alu_op_t;
+
+//=============================================================================
+// BFP_ALU_S - Kernel libre (sin control): Z = A op B sobre streams BFP
+// Consume siempre un bloque de cada entrada para que el pipeline enlazado
+// avance al mismo ritmo; OP_RCP calcula 1/B y descarta A (igual que el
+// kernel m_axi). 'operation' es un registro AXI-Lite que el host fija antes
+// de arrancar los kernels de borde.
+//=============================================================================
+extern "C" {
+
+void bfp_alu_s(
+    bfp_stream_t& in_a,
+    bfp_stream_t& in_b,
+    bfp_stream_t& out_blk,
+    const unsigned int operation
+) {
+    #pragma HLS INTERFACE axis port=in_a
+    #pragma HLS INTERFACE axis port=in_b
+    #pragma HLS INTERFACE axis port=out_blk
+    #pragma HLS INTERFACE s_axilite port=operation
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+
+    const blk_t A = word_to_bfp<Cfg, N>(in_a.read());
+    const blk_t B = word_to_bfp<Cfg, N>(in_b.read());
+    blk_t Z = blk_t::zero();
+
+    switch (operation) {
+        case OP_ADD:
+            Z = add_blocks<Cfg, N>(A, B);
+            break;
+
+        case OP_SUB:
+            Z = sub_blocks<Cfg, N>(A, B);
+            break;
+
+        case OP_MUL:
+            Z = mul_blocks<Cfg, N>(A, B);
+            break;
+
+        case OP_DIV:
+            Z = div_blocks<Cfg, N>(A, B);
+            break;
+
+        case OP_RCP:
+            Z = rcp_blocks<Cfg, N>(B);
+            break;
+
+        default:
+            Z = A;
+            break;
+    }
+
+    out_blk.write(bfp_to_word<Cfg, N>(Z));
+}
+
+} // extern "C"
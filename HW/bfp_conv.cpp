@@ -0,0 +1,268 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_dot_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+// Limites en chip (line buffers, ventana y pesos). Un lanzamiento con una
+// forma fuera de estos limites (o con la imagen con padding menor que K) no
+// escribe nada.
+#define CONV_K_MAX  5      // kernel K x K, K <= CONV_K_MAX
+#define CONV_W_MAX  66     // ancho con padding: width + 2 * pad <= CONV_W_MAX
+#define CONV_CB_MAX 2      // bloques de canales de entrada (C_in <= 32)
+#define CONV_CO_MAX 32     // canales de salida
+#define CONV_GUARD  24
+
+// mode (flags)
+static constexpr unsigned int CONV_OUT_BFP = 0x1;  // salida en bloques de N canales (out_bfp)
+
+using acc_t = BFP_DotAcc<CONV_GUARD>;
+
+//=============================================================================
+// Layout en memoria (HWC, canales en bloques de N, formato compacto 1 + 2*N):
+//   in_bfp  : pixel (y, x), bloque cb en ((y * width + x) * CB + cb) * 33
+//   weights : bloque (oc, ky, kx, cb) en (((oc * K + ky) * K + kx) * CB + cb) * 33
+//   out_fp32: ((oy * OW + ox) * c_out + oc)
+//   out_bfp : ((oy * OW + ox) * ceil(c_out / N) + ob) * 33
+// Mismo layout que la referencia CPU de C++/bfp_conv.h
+//=============================================================================
+void load_conv_block(const unsigned int* vec, blk_t& blk, unsigned int offset) {
+#pragma HLS INLINE off
+
+    blk.set_exp_word(vec[offset]);
+
+LOAD_CONV_ELEMENTS:
+    for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=2
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+        blk.sign[i]  = vec[offset + 1 + 2 * i];
+        blk.mant[i]  = vec[offset + 2 + 2 * i];
+    }
+}
+
+void store_conv_block(const blk_t& blk, unsigned int* vec, unsigned int offset) {
+#pragma HLS INLINE off
+
+    vec[offset] = blk.exp_word();
+
+STORE_CONV_ELEMENTS:
+    for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=2
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+        vec[offset + 1 + 2 * i] = blk.sign[i];
+        vec[offset + 2 + 2 * i] = blk.mant[i];
+    }
+}
+
+//=============================================================================
+// COMPUTE: todos los canales de salida de un pixel sobre la ventana K x K.
+// La ventana valida ocupa las ultimas K filas/columnas de win.
+//=============================================================================
+void conv_window(const blk_t win[CONV_K_MAX][CONV_K_MAX][CONV_CB_MAX],
+                 const blk_t wbuf[CONV_CO_MAX][CONV_K_MAX * CONV_K_MAX][CONV_CB_MAX],
+                 unsigned int ksize, unsigned int cb_n, unsigned int c_out,
+                 float result[CONV_CO_MAX]) {
+#pragma HLS INLINE off
+
+    const unsigned int k0 = CONV_K_MAX - ksize;
+
+CONV_OUT_CH:
+    for (unsigned int oc = 0; oc < c_out; oc++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=32 avg=16
+        acc_t acc;
+        acc.clear();
+
+    CONV_TAPS:
+        for (unsigned int ky = 0; ky < ksize; ky++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=5 avg=3
+            for (unsigned int kx = 0; kx < ksize; kx++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=5 avg=3
+                for (unsigned int cb = 0; cb < cb_n; cb++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2 avg=1
+                    bfp_pe_mac<Cfg, N, CONV_GUARD>(win[k0 + ky][k0 + kx][cb],
+                                                   wbuf[oc][ky * ksize + kx][cb], acc);
+                }
+            }
+        }
+        result[oc] = acc.to_float<Cfg>();
+    }
+}
+
+//=============================================================================
+// MAIN KERNEL - convolucion 2D con line buffers y ventana deslizante
+//=============================================================================
+extern "C" {
+
+void bfp_conv(
+    // Control
+    const unsigned int mode,
+    const unsigned int height,
+    const unsigned int width,
+    const unsigned int c_in,
+    const unsigned int c_out,
+    const unsigned int ksize,
+    const unsigned int stride,
+    const unsigned int pad,
+    // Inputs (compact BFP)
+    const unsigned int* in_bfp,
+    const unsigned int* weights,
+    // Outputs
+    float* out_fp32,
+    unsigned int* out_bfp
+) {
+    #pragma HLS INTERFACE m_axi port=in_bfp offset=slave bundle=gmem0 \
+        max_read_burst_length=64 num_read_outstanding=4
+    #pragma HLS INTERFACE m_axi port=weights offset=slave bundle=gmem1 \
+        max_read_burst_length=64 num_read_outstanding=4
+    #pragma HLS INTERFACE m_axi port=out_fp32 offset=slave bundle=gmem2 \
+        max_write_burst_length=16 num_write_outstanding=4
+    #pragma HLS INTERFACE m_axi port=out_bfp offset=slave bundle=gmem2 \
+        max_write_burst_length=64 num_write_outstanding=4
+
+    #pragma HLS INTERFACE s_axilite port=mode
+    #pragma HLS INTERFACE s_axilite port=height
+    #pragma HLS INTERFACE s_axilite port=width
+    #pragma HLS INTERFACE s_axilite port=c_in
+    #pragma HLS INTERFACE s_axilite port=c_out
+    #pragma HLS INTERFACE s_axilite port=ksize
+    #pragma HLS INTERFACE s_axilite port=stride
+    #pragma HLS INTERFACE s_axilite port=pad
+    #pragma HLS INTERFACE s_axilite port=return
+
+    const unsigned int K  = ksize;
+    const unsigned int S  = (stride == 0) ? 1 : stride;
+    const unsigned int cb_n = (c_in + N - 1) / N;
+    const unsigned int co_n = c_out;
+    const unsigned int ob_n = (co_n + N - 1) / N;
+    const unsigned int ph = height + 2 * pad;
+    const unsigned int pw = width + 2 * pad;
+
+    // Validacion de la forma contra los buffers en chip (wbuf, line_buf, win)
+    if (K == 0 || K > CONV_K_MAX) return;
+    if (c_in == 0 || cb_n > CONV_CB_MAX) return;
+    if (co_n == 0 || co_n > CONV_CO_MAX) return;
+    if (pad > CONV_W_MAX || width > CONV_W_MAX || pw > CONV_W_MAX) return;
+    if (height > ph || pw < K || ph < K) return;
+
+    const unsigned int out_w = (pw - K) / S + 1;
+    const bool out_bfp_mode = (mode & CONV_OUT_BFP) != 0;
+
+    blk_t wbuf[CONV_CO_MAX][CONV_K_MAX * CONV_K_MAX][CONV_CB_MAX];
+#pragma HLS ARRAY_PARTITION variable=wbuf complete dim=3
+
+    blk_t line_buf[CONV_K_MAX - 1][CONV_W_MAX][CONV_CB_MAX];
+#pragma HLS ARRAY_PARTITION variable=line_buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=line_buf complete dim=3
+
+    blk_t win[CONV_K_MAX][CONV_K_MAX][CONV_CB_MAX];
+#pragma HLS ARRAY_PARTITION variable=win complete dim=0
+
+    float result[CONV_CO_MAX];
+
+    //=========================================================================
+    // PHASE 0: PESOS PRE-CODIFICADOS -> CHIP (una vez por lanzamiento)
+    //=========================================================================
+LOAD_WEIGHTS:
+    for (unsigned int oc = 0; oc < co_n; oc++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=32 avg=16
+        for (unsigned int t = 0; t < K * K; t++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=25 avg=9
+            for (unsigned int cb = 0; cb < cb_n; cb++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2 avg=1
+                load_conv_block(weights, wbuf[oc][t][cb], ((oc * K * K + t) * cb_n + cb) * BFP_BLOCK_SIZE);
+            }
+        }
+    }
+
+    //=========================================================================
+    // STREAM DE PIXELES (coordenadas con padding, orden raster)
+    //=========================================================================
+ROWS:
+    for (unsigned int py = 0; py < ph; py++) {
+#pragma HLS LOOP_TRIPCOUNT min=3 max=66 avg=18
+    COLS:
+        for (unsigned int px = 0; px < pw; px++) {
+#pragma HLS LOOP_TRIPCOUNT min=3 max=66 avg=18
+
+            // PHASE 1: LOAD del pixel (cero en el borde de padding)
+            blk_t pix[CONV_CB_MAX];
+            const bool inside = (py >= pad) && (py < pad + height) && (px >= pad) && (px < pad + width);
+        LOAD_PIXEL:
+            for (unsigned int cb = 0; cb < CONV_CB_MAX; cb++) {
+                pix[cb] = blk_t::zero();
+                if (inside && cb < cb_n) {
+                    load_conv_block(in_bfp, pix[cb],
+                                    (((py - pad) * width + (px - pad)) * cb_n + cb) * BFP_BLOCK_SIZE);
+                }
+            }
+
+            // Line buffers: la columna px sube una fila y recibe el pixel nuevo.
+            // La ventana se desplaza a la izquierda y su ultima columna es
+            // [line_buf[0..K_MAX-2][px], pixel nuevo].
+        SHIFT_WINDOW:
+            for (int r = 0; r < CONV_K_MAX; r++) {
+#pragma HLS UNROLL
+                for (int c = 0; c < CONV_K_MAX - 1; c++) {
+#pragma HLS UNROLL
+                    for (int cb = 0; cb < CONV_CB_MAX; cb++) {
+#pragma HLS UNROLL
+                        win[r][c][cb] = win[r][c + 1][cb];
+                    }
+                }
+            }
+        UPDATE_LINE_BUF:
+            for (int cb = 0; cb < CONV_CB_MAX; cb++) {
+#pragma HLS UNROLL
+                for (int r = 0; r < CONV_K_MAX - 1; r++) {
+#pragma HLS UNROLL
+                    win[r][CONV_K_MAX - 1][cb] = line_buf[r][px][cb];
+                    line_buf[r][px][cb] = (r == CONV_K_MAX - 2) ? pix[cb] : line_buf[r + 1][px][cb];
+                }
+                win[CONV_K_MAX - 1][CONV_K_MAX - 1][cb] = pix[cb];
+            }
+
+            // Ventana completa y alineada con el stride?
+            if (py + 1 < K || px + 1 < K) continue;
+            if ((py + 1 - K) % S != 0 || (px + 1 - K) % S != 0) continue;
+            const unsigned int oy = (py + 1 - K) / S;
+            const unsigned int ox = (px + 1 - K) / S;
+
+            // PHASE 2: COMPUTE
+            conv_window(win, wbuf, K, cb_n, co_n, result);
+
+            // PHASE 3: STORE
+            if (out_bfp_mode) {
+            STORE_BFP:
+                for (unsigned int ob = 0; ob < ob_n; ob++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2 avg=1
+                    std::array<float, N> xs{};
+                    for (int l = 0; l < N; l++) {
+#pragma HLS UNROLL
+                        const unsigned int oc = ob * N + l;
+                        xs[l] = (oc < co_n) ? result[oc] : 0.0f;
+                    }
+                    store_conv_block(encode_block<Cfg, N>(xs), out_bfp,
+                                     ((oy * out_w + ox) * ob_n + ob) * BFP_BLOCK_SIZE);
+                }
+            } else {
+            STORE_FP32:
+                for (unsigned int oc = 0; oc < co_n; oc++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=32 avg=16
+                    out_fp32[(oy * out_w + ox) * c_out + oc] = result[oc];
+                }
+            }
+        }
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,31 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_stream_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+//=============================================================================
+// BFP_DECODE_S - Kernel libre (sin control): BFP stream -> FP32 stream
+//=============================================================================
+extern "C" {
+
+void bfp_decode_s(
+    bfp_stream_t& in_blk,
+    bfp_stream_t& out_blk
+) {
+    #pragma HLS INTERFACE axis port=in_blk
+    #pragma HLS INTERFACE axis port=out_blk
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+
+    const blk_t A = word_to_bfp<Cfg, N>(in_blk.read());
+    const std::array<float, N> xs = decode_block<Cfg, N>(A);
+    out_blk.write(fp32_to_word<N>(xs));
+}
+
+} // extern "C"
@@ -0,0 +1,307 @@
+#ifndef BFP_DOT_HLS_H
+#define BFP_DOT_HLS_H
+
+#include <cmath>
+#include <cstdint>
+#include "bfp_hls.h"
+#include "bfp_ops_hls.h"
+
+//*============================================================================
+//* PRODUCTO PUNTO BFP PARA GEMM
+//*
+//* El valor de un elemento es  (-1)^s * mant * 2^(E - bias - wm)  (mant ya
+//* esta alineada al exponente compartido).
+//* Por eso el producto punto de dos bloques es un producto punto entero de
+//* mantisas (DSPs) con exponente Ea + Eb, sumado una sola vez por par de
+//* bloques.
+//*
+//* El acumulador de cada PE es un entero ancho con exponente propio:
+//*   valor = acc * 2^(acc_e - 2*bias - 2*wm - GuardBits)
+//* Los productos parciales se desplazan GuardBits a la izquierda antes de
+//* alinearse, asi que los corrimientos a la derecha solo pierden bits por
+//* debajo de 2^-GuardBits del LSB del parcial.
+//*============================================================================
+template<int GuardBits = 24>
+struct BFP_DotAcc {
+    static constexpr int guard = GuardBits;
+
+    int64_t acc   = 0;
+    int     acc_e = 0;
+
+    void clear() {
+#pragma HLS INLINE
+        acc = 0;
+        acc_e = 0;
+    }
+
+    // Suma un parcial entero 'dot' con exponente compartido 'e' (= Ea + Eb)
+    void add(int32_t dot, int e) {
+#pragma HLS INLINE
+        if (dot == 0) return;
+
+        const int64_t p = int64_t(dot) * (int64_t(1) << GuardBits);
+        if (acc == 0) {
+            acc = p;
+            acc_e = e;
+        } else if (e > acc_e) {
+            const int d = e - acc_e;
+            acc = ((d >= 63) ? (acc < 0 ? -1 : 0) : (acc >> d)) + p;
+            acc_e = e;
+        } else {
+            const int d = acc_e - e;
+            acc += (d >= 63) ? (p < 0 ? -1 : 0) : (p >> d);
+        }
+    }
+
+    // Reconstruccion a FP32
+    template<class Cfg>
+    float to_float() const {
+#pragma HLS INLINE
+        if (acc == 0) return 0.0f;
+        const int scale = acc_e - 2 * Cfg::bias_bfp - 2 * Cfg::wm - GuardBits;
+        return std::ldexp(float(acc), scale);
+    }
+};
+
+//*============================================================================
+//* PRODUCTO PUNTO ENTERO DE MANTISAS (un par de bloques)
+//*============================================================================
+template<class Cfg, std::size_t Block_size>
+int32_t bfp_block_dot(const BFP_Global<Cfg, Block_size>& a,
+                      const BFP_Global<Cfg, Block_size>& b) {
+#pragma HLS INLINE
+    int32_t dot = 0;
+
+DOT_LANES:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        const int32_t prod = int32_t(a.mant[i]) * int32_t(b.mant[i]);
+        dot += (a.sign[i] ^ b.sign[i]) ? -prod : prod;
+    }
+    return dot;
+}
+
+//*============================================================================
+//* MAC DE UN PE: acc += dot(a, b) * 2^(Ea + Eb)
+//*============================================================================
+template<class Cfg, std::size_t Block_size, int GuardBits>
+void bfp_pe_mac(const BFP_Global<Cfg, Block_size>& a,
+                const BFP_Global<Cfg, Block_size>& b,
+                BFP_DotAcc<GuardBits>& acc) {
+#pragma HLS INLINE
+    acc.add(bfp_block_dot<Cfg, Block_size>(a, b),
+            int(a.exp_shared) + int(b.exp_shared));
+}
+
+//*============================================================================
+//* ACUMULADOR BFP ANCHO POR LANE (reducciones largas y productos punto)
+//*
+//* Un entero ancho por lane y un solo exponente compartido:
+//*   valor_i = acc[i] * 2^(acc_e - bias - wm - GuardBits)
+//* add() alinea el bloque entrante al exponente mayor (solo corrimientos),
+//* sin renormalizar ni redondear a WM bits en cada paso; to_block() hace el
+//* unico redondeo (politica Cfg::round) de vuelta a BFP_Global al final. Con mantisas de WM+1
+//* bits y productos de 2*(WM+1) bits quedan 63 - 2*(WM+1) - GuardBits bits
+//* de margen para sumar sin desbordar (2^22 sumandos con WM=7, G=24).
+//* Los lanes se leen numericamente: los centinelas NaN/Inf no se propagan.
+//*============================================================================
+template<class Cfg, std::size_t Block_size, int GuardBits = 24>
+struct BFP_Accum {
+    static constexpr int guard = GuardBits;
+    static_assert(GuardBits >= 0 && 2 * (Cfg::wm + 1) + GuardBits <= 48,
+                  "BFP_Accum: GuardBits deja menos de 15 bits de margen en int64");
+
+    int64_t acc[Block_size];
+    int     acc_e;
+    bool    empty;
+
+    void clear() {
+#pragma HLS INLINE
+    ACCUM_CLEAR:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+            acc[i] = 0;
+        }
+        acc_e = 0;
+        empty = true;
+    }
+
+    // Suma lanes enteros con signo 'p' cuyo valor es p * 2^(e - bias - wm)
+    void add_lanes(const int64_t p[Block_size], int e) {
+#pragma HLS INLINE
+        int d_acc = 0, d_in = 0;
+        if (empty) {
+            acc_e = e;
+            empty = false;
+        } else if (e > acc_e) {
+            d_acc = e - acc_e;
+            acc_e = e;
+        } else {
+            d_in = acc_e - e;
+        }
+
+    ACCUM_ADD:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+            const int64_t q = p[i] * (int64_t(1) << GuardBits);
+            const int64_t a = (d_acc >= 63) ? (acc[i] < 0 ? -1 : 0) : (acc[i] >> d_acc);
+            const int64_t b = (d_in >= 63) ? (q < 0 ? -1 : 0) : (q >> d_in);
+            acc[i] = a + b;
+        }
+    }
+
+    // acc += B
+    void add(const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+        int64_t p[Block_size];
+    ACCUM_LANES:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+            p[i] = B.sign[i] ? -int64_t(B.mant[i]) : int64_t(B.mant[i]);
+        }
+        add_lanes(p, int(B.exp_shared));
+    }
+
+    // acc -= B
+    void sub(const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+        int64_t p[Block_size];
+    ACCUM_LANES_NEG:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+            p[i] = B.sign[i] ? int64_t(B.mant[i]) : -int64_t(B.mant[i]);
+        }
+        add_lanes(p, int(B.exp_shared));
+    }
+
+    // acc += A * B lane a lane: mant_a * mant_b con exponente Ea + Eb - bias - wm
+    void mac(const BFP_Global<Cfg, Block_size>& A,
+             const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+        int64_t p[Block_size];
+    ACCUM_PROD:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+            const int64_t prod = int64_t(A.mant[i]) * int64_t(B.mant[i]);
+            p[i] = (A.sign[i] ^ B.sign[i]) ? -prod : prod;
+        }
+        add_lanes(p, int(A.exp_shared) + int(B.exp_shared) - Cfg::bias_bfp - Cfg::wm);
+    }
+
+    // Suma de los lanes (producto punto / reduccion completa) en FP32
+    float sum_lanes() const {
+#pragma HLS INLINE
+        int64_t s = 0;
+    ACCUM_HSUM:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+            s += acc[i];
+        }
+        if (s == 0) return 0.0f;
+        return std::ldexp(float(s), acc_e - Cfg::bias_bfp - Cfg::wm - GuardBits);
+    }
+
+    // Un lane en FP32 (sin redondear a WM bits)
+    float to_float(std::size_t i) const {
+#pragma HLS INLINE
+        if (acc[i] == 0) return 0.0f;
+        return std::ldexp(float(acc[i]), acc_e - Cfg::bias_bfp - Cfg::wm - GuardBits);
+    }
+
+    // Unico redondeo final: Cfg::round a WM+1 bits con el exponente del lane mayor
+    BFP_Global<Cfg, Block_size> to_block(BFP_Stats<Cfg>& st) const {
+#pragma HLS INLINE off
+        BFP_Global<Cfg, Block_size> Z = BFP_Global<Cfg, Block_size>::zero();
+        const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1;
+
+        uint64_t max_mag = 0;
+    ACCUM_MAX:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+            const uint64_t m = uint64_t(acc[i] < 0 ? -acc[i] : acc[i]);
+            if (m > max_mag) max_mag = m;
+        }
+        if (max_mag == 0) {
+            Z.exp_shared = 0;
+            Z.sign.fill(0);
+            Z.mant.fill(0);
+            Z.flags = 0;
+            return Z;
+        }
+
+        // Codificador de prioridad de 64 bits (bit mas alto en uno)
+        int msb = 0;
+    ACCUM_MSB:
+        for (int b = 0; b < 64; b++) {
+#pragma HLS UNROLL
+            if ((max_mag >> b) & 1u) msb = b;
+        }
+
+        // Exponente (sesgado) que deja al lane mayor en WM+1 bits; +1 si el
+        // redondeo lo lleva a 2^(WM+1)
+        int E = acc_e - GuardBits + msb - Cfg::wm;
+        if (accum_round64(max_mag, msb - Cfg::wm) > mant_max) E++;
+
+        count_exp_clamp<Cfg>(E - Cfg::bias_bfp, st);
+        Z.exp_shared = clamp_exponent<Cfg>(E - Cfg::bias_bfp);
+        const int shift = int(Z.exp_shared) - (acc_e - GuardBits);
+
+        bool all_zero = true;
+    ACCUM_ROUND:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+            const uint64_t mag = uint64_t(acc[i] < 0 ? -acc[i] : acc[i]);
+            uint64_t m = accum_round64(mag, shift);
+            if (m > mant_max) {
+                m = mant_max;
+                st.mant_sat++;
+            }
+            if (m == 0 && mag != 0) st.flush_zero++;
+            Z.mant[i]  = uint32_t(m);
+            Z.sign[i]  = (m != 0 && acc[i] < 0) ? 1u : 0u;
+            if (m != 0) all_zero = false;
+        }
+        if (all_zero) Z.exp_shared = 0;
+        return Z;
+    }
+
+    BFP_Global<Cfg, Block_size> to_block() const {
+#pragma HLS INLINE
+        BFP_Stats<Cfg> st{};
+        return to_block(st);
+    }
+
+    // Redondeo de 64 bits (Cfg::round); shift < 0 desplaza a la izquierda (saturando)
+    static uint64_t accum_round64(uint64_t x, int shift) {
+#pragma HLS INLINE
+        if (shift <= 0) {
+            const int s = -shift;
+            if (s >= 63 || (x >> (63 - s)) != 0) return ~uint64_t(0) >> 1;
+            return x << s;
+        }
+        return bfp_round_shr<typename Cfg::round>(x, shift);
+    }
+};
+
+//*============================================================================
+//* REDUCCION DE n BLOQUES CON UN SOLO REDONDEO FINAL
+//*============================================================================
+template<class Cfg, std::size_t Block_size, int GuardBits = 24>
+BFP_Global<Cfg, Block_size> bfp_reduce_blocks(const BFP_Global<Cfg, Block_size>* xs,
+                                              unsigned int n,
+                                              BFP_Stats<Cfg>& st) {
+#pragma HLS INLINE off
+    BFP_Accum<Cfg, Block_size, GuardBits> acc;
+    acc.clear();
+REDUCE_BLOCKS:
+    for (unsigned int b = 0; b < n; b++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=1024 avg=64
+        acc.add(xs[b]);
+    }
+    return acc.to_block(st);
+}
+
+#endif // BFP_DOT_HLS_H
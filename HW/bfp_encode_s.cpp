@@ -0,0 +1,33 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_stream_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+//=============================================================================
+// BFP_ENCODE_S - Kernel libre (sin control): FP32 stream -> BFP stream
+// Cada invocacion consume un bloque FP32 y produce un bloque BFP; en HW el
+// kernel se reinicia solo (ap_ctrl_none), en csim el TB lo llama por bloque.
+//=============================================================================
+extern "C" {
+
+void bfp_encode_s(
+    bfp_stream_t& in_blk,
+    bfp_stream_t& out_blk
+) {
+    #pragma HLS INTERFACE axis port=in_blk
+    #pragma HLS INTERFACE axis port=out_blk
+    #pragma HLS INTERFACE ap_ctrl_none port=return
+
+    const std::array<float, N> xs = word_to_fp32<N>(in_blk.read());
+    const blk_t Z = encode_block_1p<Cfg, N>(xs);   // una pasada: bit a bit igual a encode_block
+    out_blk.write(bfp_to_word<Cfg, N>(Z));
+}
+
+} // extern "C"
@@ -0,0 +1,265 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_dot_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+// Arreglo sistolico GEMM_P x GEMM_Q PEs (un PE = un elemento de C)
+#define GEMM_P      4
+#define GEMM_Q      16
+#define GEMM_MAX_KB 64     // bloques de K en chip por lanzamiento (K <= 1024;
+                           // k_blocks mayor: el lanzamiento no escribe nada)
+#define GEMM_GUARD  24
+
+static_assert(GEMM_Q % N == 0, "GEMM_Q debe ser multiplo de N (salida BFP por filas)");
+
+// mode (flags)
+static constexpr unsigned int GEMM_OUT_BFP    = 0x1;  // C en formato compacto (out_bfp)
+static constexpr unsigned int GEMM_ACCUMULATE = 0x2;  // salida FP32: out_fp32 += A * B
+
+using acc_t = BFP_DotAcc<GEMM_GUARD>;
+
+//=============================================================================
+// Layout en memoria (formato compacto 1 + 2*N por bloque):
+//   a_bfp  : A (m x K) por filas, bloque (i, kb) en (i * k_blocks + kb) * 33
+//   bt_bfp : B^T (n_cols x K), bloque (j, kb) en (j * k_blocks + kb) * 33
+//   out_fp32: C (m x n_cols) row-major
+//   out_bfp : filas de C en bloques de N columnas, bloque (i, jb) en
+//             (i * ceil(n_cols / N) + jb) * 33
+//=============================================================================
+void load_gemm_block(const unsigned int* vec, blk_t& blk, unsigned int offset) {
+#pragma HLS INLINE off
+
+    blk.set_exp_word(vec[offset]);
+
+LOAD_GEMM_ELEMENTS:
+    for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=2
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+        blk.sign[i]  = vec[offset + 1 + 2 * i];
+        blk.mant[i]  = vec[offset + 2 + 2 * i];
+    }
+}
+
+void store_gemm_block(const blk_t& blk, unsigned int* vec, unsigned int offset) {
+#pragma HLS INLINE off
+
+    vec[offset] = blk.exp_word();
+
+STORE_GEMM_ELEMENTS:
+    for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=2
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+        vec[offset + 1 + 2 * i] = blk.sign[i];
+        vec[offset + 2 + 2 * i] = blk.mant[i];
+    }
+}
+
+//=============================================================================
+// ARREGLO SISTOLICO: los bloques de A entran por la izquierda (fila p con
+// retardo p) y avanzan un PE a la derecha por paso; los de B entran por
+// arriba (columna q con retardo q) y bajan. El PE (p, q) ve el par
+// (A[p][kb], B[q][kb]) en el paso t = kb + p + q. Fuera de rango entra un
+// bloque nulo, que no modifica el acumulador.
+//=============================================================================
+void systolic_tile(const blk_t a_buf[GEMM_P][GEMM_MAX_KB],
+                   const blk_t b_buf[GEMM_Q][GEMM_MAX_KB],
+                   unsigned int k_blocks,
+                   acc_t acc[GEMM_P][GEMM_Q]) {
+#pragma HLS INLINE off
+
+    blk_t a_reg[GEMM_P][GEMM_Q];
+    blk_t b_reg[GEMM_P][GEMM_Q];
+#pragma HLS ARRAY_PARTITION variable=a_reg complete dim=0
+#pragma HLS ARRAY_PARTITION variable=b_reg complete dim=0
+
+INIT_PE:
+    for (int p = 0; p < GEMM_P; p++) {
+#pragma HLS UNROLL
+        for (int q = 0; q < GEMM_Q; q++) {
+#pragma HLS UNROLL
+            acc[p][q].clear();
+            a_reg[p][q] = blk_t::zero();
+            b_reg[p][q] = blk_t::zero();
+        }
+    }
+
+    const unsigned int n_steps = k_blocks + GEMM_P + GEMM_Q - 2;
+
+SYSTOLIC_STEPS:
+    for (unsigned int t = 0; t < n_steps; t++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=20 max=82 avg=36
+
+        // Recorrido descendente: cada PE lee el registro de su vecino antes
+        // de que este se actualice en el mismo paso (desplazamiento).
+    PE_ROWS:
+        for (int p = GEMM_P - 1; p >= 0; p--) {
+#pragma HLS UNROLL
+        PE_COLS:
+            for (int q = GEMM_Q - 1; q >= 0; q--) {
+#pragma HLS UNROLL
+                blk_t a_in = blk_t::zero(), b_in = blk_t::zero();
+
+                if (q == 0) {
+                    const int kb = int(t) - p;
+                    if (kb >= 0 && kb < int(k_blocks)) a_in = a_buf[p][kb];
+                } else {
+                    a_in = a_reg[p][q - 1];
+                }
+
+                if (p == 0) {
+                    const int kb = int(t) - q;
+                    if (kb >= 0 && kb < int(k_blocks)) b_in = b_buf[q][kb];
+                } else {
+                    b_in = b_reg[p - 1][q];
+                }
+
+                bfp_pe_mac<Cfg, N, GEMM_GUARD>(a_in, b_in, acc[p][q]);
+
+                a_reg[p][q] = a_in;
+                b_reg[p][q] = b_in;
+            }
+        }
+    }
+}
+
+//=============================================================================
+// MAIN KERNEL - C = A * B por teselas de GEMM_P x GEMM_Q
+//=============================================================================
+extern "C" {
+
+void bfp_gemm(
+    // Control
+    const unsigned int mode,
+    const unsigned int m,
+    const unsigned int n_cols,
+    const unsigned int k_blocks,      // K / N (<= GEMM_MAX_KB)
+    // Inputs (compact BFP)
+    const unsigned int* a_bfp,
+    const unsigned int* bt_bfp,
+    // Outputs
+    float* out_fp32,
+    unsigned int* out_bfp
+) {
+    #pragma HLS INTERFACE m_axi port=a_bfp offset=slave bundle=gmem0 \
+        max_read_burst_length=64 num_read_outstanding=4
+    #pragma HLS INTERFACE m_axi port=bt_bfp offset=slave bundle=gmem1 \
+        max_read_burst_length=64 num_read_outstanding=4
+    #pragma HLS INTERFACE m_axi port=out_fp32 offset=slave bundle=gmem2 \
+        max_read_burst_length=16 max_write_burst_length=16 num_write_outstanding=4
+    #pragma HLS INTERFACE m_axi port=out_bfp offset=slave bundle=gmem2 \
+        max_write_burst_length=64 num_write_outstanding=4
+
+    #pragma HLS INTERFACE s_axilite port=mode
+    #pragma HLS INTERFACE s_axilite port=m
+    #pragma HLS INTERFACE s_axilite port=n_cols
+    #pragma HLS INTERFACE s_axilite port=k_blocks
+    #pragma HLS INTERFACE s_axilite port=return
+
+    // K fuera de los buffers en chip: truncarlo daria un C incorrecto con el
+    // stride de k_blocks, asi que se rechaza (el host divide K en trozos de
+    // GEMM_MAX_KB bloques con GEMM_ACCUMULATE)
+    if (k_blocks > GEMM_MAX_KB) return;
+
+    const unsigned int kb_n = k_blocks;
+    const unsigned int out_row_blocks = (n_cols + N - 1) / N;
+    const bool out_bfp_mode = (mode & GEMM_OUT_BFP) != 0;
+    const bool accumulate = (mode & GEMM_ACCUMULATE) != 0;
+
+    blk_t a_buf[GEMM_P][GEMM_MAX_KB];
+    blk_t b_buf[GEMM_Q][GEMM_MAX_KB];
+#pragma HLS ARRAY_PARTITION variable=a_buf complete dim=1
+#pragma HLS ARRAY_PARTITION variable=b_buf complete dim=1
+
+    acc_t acc[GEMM_P][GEMM_Q];
+#pragma HLS ARRAY_PARTITION variable=acc complete dim=0
+
+TILE_ROWS:
+    for (unsigned int i0 = 0; i0 < m; i0 += GEMM_P) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+
+        //=====================================================================
+        // PHASE 1: LOAD A TILE (filas fuera de rango = bloques nulos)
+        //=====================================================================
+    LOAD_A_TILE:
+        for (int p = 0; p < GEMM_P; p++) {
+            for (unsigned int kb = 0; kb < kb_n; kb++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+                if (i0 + p < m) {
+                    load_gemm_block(a_bfp, a_buf[p][kb], ((i0 + p) * k_blocks + kb) * BFP_BLOCK_SIZE);
+                } else {
+                    a_buf[p][kb] = blk_t::zero();
+                }
+            }
+        }
+
+    TILE_COLS:
+        for (unsigned int j0 = 0; j0 < n_cols; j0 += GEMM_Q) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+
+        LOAD_B_TILE:
+            for (int q = 0; q < GEMM_Q; q++) {
+                for (unsigned int kb = 0; kb < kb_n; kb++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+                    if (j0 + q < n_cols) {
+                        load_gemm_block(bt_bfp, b_buf[q][kb], ((j0 + q) * k_blocks + kb) * BFP_BLOCK_SIZE);
+                    } else {
+                        b_buf[q][kb] = blk_t::zero();
+                    }
+                }
+            }
+
+            //=================================================================
+            // PHASE 2: COMPUTE (arreglo sistolico)
+            //=================================================================
+            systolic_tile(a_buf, b_buf, kb_n, acc);
+
+            //=================================================================
+            // PHASE 3: STORE (renormalizacion a FP32 o BFP)
+            //=================================================================
+        STORE_ROWS:
+            for (int p = 0; p < GEMM_P; p++) {
+                const unsigned int i = i0 + p;
+                if (i >= m) continue;
+
+                if (out_bfp_mode) {
+                STORE_BFP_BLOCKS:
+                    for (int qb = 0; qb < GEMM_Q / N; qb++) {
+                        const unsigned int jb = (j0 / N) + qb;
+                        if (jb >= out_row_blocks) continue;
+
+                        std::array<float, N> xs{};
+                        for (int l = 0; l < N; l++) {
+#pragma HLS UNROLL
+                            if (j0 + qb * N + l < n_cols) {
+                                xs[l] = acc[p][qb * N + l].to_float<Cfg>();
+                            }
+                        }
+                        const blk_t z = encode_block<Cfg, N>(xs);
+                        store_gemm_block(z, out_bfp, (i * out_row_blocks + jb) * BFP_BLOCK_SIZE);
+                    }
+                } else {
+                STORE_FP32:
+                    for (int q = 0; q < GEMM_Q; q++) {
+#pragma HLS PIPELINE II=1
+                        const unsigned int j = j0 + q;
+                        if (j >= n_cols) continue;
+                        const float c = acc[p][q].to_float<Cfg>();
+                        out_fp32[i * n_cols + j] = accumulate ? out_fp32[i * n_cols + j] + c : c;
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // extern "C"
@@ -8,14 +8,94 @@
 #include <array>
 #include <cmath>
 
+//*============================================================================
+//* MODOS DE REDONDEO (tercer parametro de BFP_bias)
+//* RNE:       al par mas cercano (por defecto)
+//* TRUNC:     trunca la magnitud (hacia cero)
+//* STOCH:     estocastico, suma 'shift' bits aleatorios uniformes antes de
+//*            truncar: E[q] = x / 2^shift, sin sesgo al acumular. Los bits salen
+//*            de un LFSR por lane (BFP_Lfsr) sembrado por lanzamiento
+//* HALF_AWAY: al mas cercano, empates lejos de cero (sin mirar el LSB)
+//*============================================================================
+enum : int {
+    BFP_RND_RNE       = 0,
+    BFP_RND_TRUNC     = 1,
+    BFP_RND_STOCH     = 2,
+    BFP_RND_HALF_AWAY = 3
+};
+
+//*============================================================================
+//* POLITICAS DE REDONDEO (sin estado)
+//* step(q, cmp) decide el cociente final a partir del cociente truncado q y
+//* de cmp = signo de (resto - medio ulp): -1, 0 (empate) o +1. Sirve igual
+//* para corrimientos (bfp_round_shr) que para divisiones (resto vs divisor/2).
+//* RoundTowardZero no compara nada: es el camino corto en LUTs y latencia.
+//*============================================================================
+struct RoundNearestEven {
+    static constexpr int id = BFP_RND_RNE;
+    template<class T>
+    static T step(T q, int cmp) {
+#pragma HLS INLINE
+        return (cmp > 0 || (cmp == 0 && (q & 1u))) ? T(q + 1) : q;
+    }
+};
+
+struct RoundTowardZero {
+    static constexpr int id = BFP_RND_TRUNC;
+    template<class T>
+    static T step(T q, int) {
+#pragma HLS INLINE
+        return q;
+    }
+};
+
+struct RoundHalfAway {
+    static constexpr int id = BFP_RND_HALF_AWAY;
+    template<class T>
+    static T step(T q, int cmp) {
+#pragma HLS INLINE
+        return (cmp >= 0) ? T(q + 1) : q;
+    }
+};
+
+// Politica de cada modo; STOCH cae a RNE en los caminos sin LFSR (cociente
+// del reciproco, acumulador ancho)
+template<int RND> struct BFP_round_policy               { using type = RoundNearestEven; };
+template<>        struct BFP_round_policy<BFP_RND_TRUNC>     { using type = RoundTowardZero; };
+template<>        struct BFP_round_policy<BFP_RND_HALF_AWAY> { using type = RoundHalfAway; };
+
+// x / 2^shift redondeado con la politica P (magnitudes; shift <= 0 no desplaza)
+template<class P, class T>
+static inline T bfp_round_shr(T x, int shift) {
+#pragma HLS INLINE
+    if (shift <= 0) return x;
+    if (shift >= int(8 * sizeof(T))) return T(0);
+
+    const T q    = x >> shift;
+    const T rem  = x & ((T(1) << shift) - T(1));
+    const T half = T(1) << (shift - 1);
+    return P::step(q, (rem > half) ? 1 : (rem == half) ? 0 : -1);
+}
+
 //*============================================================================
 //* CONFIGURACION DE BIAS PARA FORMATO BFP 
 //*============================================================================
-template<int WE, int WM>
+template<int WE, int WM, int RND = BFP_RND_RNE>
 struct BFP_bias {
     static constexpr int we = WE;                      
     static constexpr int wm = WM;                      
     static constexpr int bias_bfp = (1 << (WE - 1)) - 1;
+    static constexpr int rnd = RND;
+    using round = typename BFP_round_policy<RND>::type;
+
+    // Tipos de ancho exacto: campos del bloque e intermedios de las ops
+    using exp_t  = ap_uint<WE>;               // Exponente compartido (sesgado)
+    using sign_t = ap_uint<1>;                // Signo por lane
+    using mant_t = ap_uint<WM + 1>;           // Mantisa alineada (<= mant_max)
+    using sum_t  = ap_uint<WM + 2>;           // |Ma +- Mb| y acarreo del redondeo
+    using ssum_t = ap_int<WM + 3>;            // Ma +- Mb con signo
+    using prod_t = ap_uint<2 * (WM + 1)>;     // Producto exacto de mantisas
+    using eint_t = ap_int<WE + 2>;            // Exponente sin sesgo por lane (rcp)
 };
 
 //*============================================================================
@@ -31,39 +111,84 @@ static inline uint32_t helper_rne(uint32_t x, int shift) {
         return (s == 0) ? x : (x << s);
     }
 
-    // SHIFT RIGHT
-    if (shift >= 32) return 0u;
+    // SHIFT RIGHT: NEAREST / TIES-TO-EVEN
+    return bfp_round_shr<RoundNearestEven>(x, shift);
+}
 
-    uint32_t q    = x >> shift;
-    uint32_t rem  = x & ((1u << shift) - 1u);
-    uint32_t half = 1u << (shift - 1);
+//*============================================================================
+//* FLAGS DE BLOQUE
+//* Viajan en la palabra de exponente del formato compacto: [15:0] = exp_shared,
+//* [31:16] = flags. BFP_FLAG_SPECIAL indica que el bloque contiene NaN/Inf:
+//* solo entonces mant_max es Inf y mant_max - 1 es NaN, y los lanes finitos se
+//* recortan a mant_max - 2. Sin el flag todas las mantisas son finitas.
+//*============================================================================
+static constexpr uint32_t BFP_FLAG_SHIFT   = 16;
+static constexpr uint32_t BFP_EXP_MASK     = (1u << BFP_FLAG_SHIFT) - 1u;
+static constexpr uint32_t BFP_FLAG_SPECIAL = 0x1u;
+static constexpr int      BFP_FLAG_BITS    = 1;    // Flags definidos en chip
 
-    // RNE: NEAREST / TIES-TO-EVEN
-    if (rem > half || (rem == half && (q & 1u))) {
-        ++q;
-    }
-    return q;
-}
+typedef ap_uint<BFP_FLAG_BITS> bfp_flag_t;
 
 //*============================================================================
 //* REPRESENTACION DE BLOQUE BFP CON EXPONENTE GLOBAL
+//* Representacion canonica sin delta: las mantisas ya estan alineadas al
+//* exponente compartido, valor = (-1)^s * mant * 2^(E - bias - wm).
+//* Campos de ancho exacto (WE, 1, WM+1 bits): un bloque de 16 lanes ocupa
+//* 5 + 16*9 + 1 = 150 bits en vez de 34 palabras de 32. Los ap_uint no se
+//* ponen a cero con {}: un bloque nulo se construye con zero().
 //*============================================================================
 template<class Cfg, std::size_t Block_size>
 struct BFP_Global {
-    uint32_t exp_shared;                        // Exponente compartido E 
-    std::array<uint32_t, Block_size> sign;      // Signos por elemento
-    std::array<uint32_t, Block_size> mant;      // Mantissas (sin 1 implícito)
-    std::array<uint32_t, Block_size> delta;    // NUEVO DELTA
+    typedef typename Cfg::exp_t  exp_t;
+    typedef typename Cfg::sign_t sign_t;
+    typedef typename Cfg::mant_t mant_t;
+
+    exp_t exp_shared;                           // Exponente compartido E 
+    std::array<sign_t, Block_size> sign;        // Signos por elemento
+    std::array<mant_t, Block_size> mant;        // Mantissas (sin 1 implícito)
+    bfp_flag_t flags;                           // Flags de bloque (BFP_FLAG_*)
+
+    static constexpr uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1;
+
+    // Bloque a cero (exponente, lanes y flags)
+    static BFP_Global zero() {
+#pragma HLS INLINE
+        BFP_Global z;
+        z.exp_shared = 0;
+        z.sign.fill(0);
+        z.mant.fill(0);
+        z.flags = 0;
+        return z;
+    }
+
+    // Centinelas NaN/Inf: solo en bloques con BFP_FLAG_SPECIAL
+    bool is_inf(std::size_t i) const {
+#pragma HLS INLINE
+        return (flags & BFP_FLAG_SPECIAL) && mant[i] == mant_max;
+    }
+    bool is_nan(std::size_t i) const {
+#pragma HLS INLINE
+        return (flags & BFP_FLAG_SPECIAL) && mant[i] == mant_max - 1;
+    }
+
+    // Palabra de exponente del formato compacto y su inversa
+    uint32_t exp_word() const {
+#pragma HLS INLINE
+        return (uint32_t(exp_shared) & BFP_EXP_MASK) | (uint32_t(flags) << BFP_FLAG_SHIFT);
+    }
+    void set_exp_word(uint32_t w) {
+#pragma HLS INLINE
+        exp_shared = w & BFP_EXP_MASK;        // Se queda con los WE bits bajos
+        flags      = w >> BFP_FLAG_SHIFT;     // y con los BFP_FLAG_BITS definidos
+    }
 
     // RECONSTRUIR VALORES A FP32 PARA VALIDACION 
     float rebuid_FP32(std::size_t i) const {
 #pragma HLS INLINE
         if (i >= Block_size) return 0.0f;
 
-        const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1;
-    
         // Detectar NaN
-        if (mant[i] == (mant_max - 1) && delta[i] == 0) {
+        if (is_nan(i)) {
             // Construir NaN en FP32
             union {float f; uint32_t u;} nan_val;
             nan_val.u = 0x7FC00000;  // NaN canónico
@@ -71,7 +196,7 @@ struct BFP_Global {
         }
         
         // Detectar Infinito
-        if (mant[i] == mant_max && delta[i] == 0) {
+        if (is_inf(i)) {
             // Construir Inf en FP32
             union {float f; uint32_t u;} inf_val;
             inf_val.u = sign[i] ? 0xFF800000 : 0x7F800000;  // -Inf : +Inf
@@ -80,28 +205,191 @@ struct BFP_Global {
         // Detectar cero
         if (exp_shared == 0 && mant[i] == 0) return 0.0f;
 
-        // Etapa de reconstruccion
+        // Etapa de reconstruccion (mantisa alineada al exponente compartido)
         int   exp_shared_unbiased = int(exp_shared) - Cfg::bias_bfp;
-        int   exp_real = exp_shared_unbiased - int(delta[i]); //  RECONSTRUCCION CON DELTA
-
-        uint32_t mant_unshifted = mant[i] << delta[i];
 
-        float mant_val     = float(mant_unshifted) / float(1u << Cfg::wm);
-        float value        = std::ldexp(mant_val, exp_real); 
-        //float value = std::ldexp(mant_val, exp_shared_unbiased);    
+        float mant_val     = float(mant[i]) / float(1u << Cfg::wm);
+        float value        = std::ldexp(mant_val, exp_shared_unbiased);
         return sign[i] ? -value : value;
     }
 };
 
+//*============================================================================
+//* LFSR POR LANE (redondeo estocastico)
+//* xorshift32 por lane: solo XOR y desplazamientos, un paso por redondeo, los
+//* lanes avanzan en paralelo. El estado se guarda XOR una constante por lane,
+//* asi un contexto a cero ({}) arranca con lanes distintos y nunca en el punto
+//* fijo 0. seed() lo hace reproducible por lanzamiento. Va aparte de
+//* BFP_Stats: solo las funciones que redondean (helper_round) lo reciben.
+//*============================================================================
+static constexpr std::size_t BFP_RND_LANES = 64;
+
+static inline uint32_t bfp_lane_key(std::size_t lane) {
+#pragma HLS INLINE
+    return 0x9E3779B9u * uint32_t(lane + 1);   // != 0 para lane < 2^32 - 1
+}
+
+struct BFP_Lfsr {
+    uint32_t state[BFP_RND_LANES];
+
+    // Un lane por ciclo: un solo fmix32 (2 multiplicadores) en vez de uno
+    // por lane; 64 ciclos al inicio del lanzamiento
+    void seed(uint32_t s) {
+#pragma HLS INLINE
+    SEED_LFSR:
+        for (std::size_t i = 0; i < BFP_RND_LANES; i++) {
+#pragma HLS PIPELINE II=1
+            // fmix32 de murmur3: semillas vecinas dan lanes sin correlacion
+            uint32_t x = s ^ bfp_lane_key(i);
+            x ^= x >> 16; x *= 0x85EBCA6Bu;
+            x ^= x >> 13; x *= 0xC2B2AE35u;
+            x ^= x >> 16;
+            state[i] = (x == 0u ? 1u : x) ^ bfp_lane_key(i);
+        }
+    }
+
+    uint32_t next(std::size_t lane) {
+#pragma HLS INLINE
+        const std::size_t l = lane % BFP_RND_LANES;
+        uint32_t x = state[l] ^ bfp_lane_key(l);
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state[l] = x ^ bfp_lane_key(l);
+        return x;
+    }
+};
+
+//*============================================================================
+//* CONTADORES DE SALUD NUMERICA (acumulados por lanzamiento)
+//* Permiten saber si el formato (WE, WM) se queda corto sin decodificar
+//* todo en el host.
+//*============================================================================
+template<class Cfg>
+struct BFP_Stats {
+    static constexpr int n_exp = 1 << Cfg::we;
+
+    uint32_t blocks;            // Bloques BFP producidos
+    uint32_t exp_overflow;      // Exponente compartido saturado a 2^WE - 1
+    uint32_t exp_underflow;     // Exponente compartido saturado a 0
+    uint32_t mant_sat;          // Mantisas recortadas a mant_max
+    uint32_t flush_zero;        // Elementos no nulos cuantizados a 0
+    uint32_t nan_count;         // Lanes NaN en los bloques producidos
+    uint32_t inf_count;         // Lanes Inf en los bloques producidos
+    uint32_t exp_hist[n_exp];   // Histograma de exp_shared
+    uint32_t lane_limit;        // Lanes validos por bloque (0 = todos): los lanes
+                                // de relleno (copias del lane 0) no se cuentan
+
+    // El lane i cuenta en los contadores por elemento
+    bool lane_on(std::size_t i) const {
+#pragma HLS INLINE
+        return lane_limit == 0 || i < lane_limit;
+    }
+
+    // Sumar los contadores de otra copia del datapath (o de un Cfg con el
+    // mismo WE y otro modo de redondeo)
+    template<class O>
+    void merge(const BFP_Stats<O>& o) {
+#pragma HLS INLINE
+        static_assert(BFP_Stats<O>::n_exp == n_exp, "merge: distinto WE");
+        blocks        += o.blocks;
+        exp_overflow  += o.exp_overflow;
+        exp_underflow += o.exp_underflow;
+        mant_sat      += o.mant_sat;
+        flush_zero    += o.flush_zero;
+        nan_count     += o.nan_count;
+        inf_count     += o.inf_count;
+    MERGE_EXP_HIST:
+        for (int e = 0; e < n_exp; e++) {
+#pragma HLS UNROLL
+            exp_hist[e] += o.exp_hist[e];
+        }
+    }
+
+    // Registrar un bloque producido: NaN/Inf (centinelas) e histograma
+    template<std::size_t Block_size>
+    void record_block(const BFP_Global<Cfg, Block_size>& blk) {
+#pragma HLS INLINE
+        blocks++;
+        exp_hist[blk.exp_shared & (n_exp - 1)]++;
+
+    RECORD_SPECIALS:
+        for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+            if (!lane_on(i)) continue;
+            if (blk.is_inf(i)) inf_count++;
+            if (blk.is_nan(i)) nan_count++;
+        }
+    }
+};
+
+//*============================================================================
+//* REDONDEO SEGUN Cfg::rnd (SHIFT RIGHT). shift <= 0: helper_rne (solo
+//* desplaza). Los modos deterministas usan la politica Cfg::round; el
+//* estocastico consume un paso del LFSR del lane solo si descarta bits.
+//*============================================================================
+template<class Cfg>
+static inline uint32_t helper_round(uint32_t x, int shift, BFP_Lfsr& rng, std::size_t lane) {
+#pragma HLS INLINE
+    if (shift <= 0) return helper_rne(x, shift);
+    if (Cfg::rnd != BFP_RND_STOCH) return bfp_round_shr<typename Cfg::round>(x, shift);
+    if (shift >= 32) return 0u;
+
+    const uint32_t r = rng.next(lane) & ((1u << shift) - 1u);
+    return uint32_t((uint64_t(x) + r) >> shift);
+}
+
+// Contar saturacion del exponente compartido (mismo criterio que el clamp)
+template<class Cfg>
+static inline void count_exp_clamp(int E_real, BFP_Stats<Cfg>& st) {
+#pragma HLS INLINE
+    const int E_biased = E_real + Cfg::bias_bfp;
+    if (E_biased < 0) st.exp_underflow++;
+    if (E_biased > (1 << Cfg::we) - 1) st.exp_overflow++;
+}
+
+//*============================================================================
+//* SELLAR LANES ESPECIALES
+//* Si algun lane es NaN/Inf se activa BFP_FLAG_SPECIAL y los lanes finitos se
+//* recortan a mant_max - 2 para no colisionar con los centinelas.
+//*============================================================================
+template<class Cfg, std::size_t Block_size>
+static inline void seal_special_lanes(BFP_Global<Cfg, Block_size>& blk,
+                                      const std::array<bool, Block_size>& special,
+                                      BFP_Stats<Cfg>& st) {
+#pragma HLS INLINE
+    const uint32_t mant_max = BFP_Global<Cfg, Block_size>::mant_max;
+
+    bool any_special = false;
+ANY_SPECIAL:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        if (special[i]) any_special = true;
+    }
+    blk.flags = any_special ? BFP_FLAG_SPECIAL : 0u;
+    if (!any_special) return;
+
+CLAMP_FINITE:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        if (!special[i] && blk.mant[i] > mant_max - 2) {
+            blk.mant[i] = mant_max - 2;
+            st.mant_sat += st.lane_on(i);
+        }
+    }
+}
+
 //*============================================================================
 //* CODIFICACION DE BLOQUE: FP32 ARRAY -> BFP_Global
-//* Calcula Emax y usa RNE para cuantización y DELTA
+//* Calcula Emax y cuantiza con Cfg::rnd; NaN/Inf activan el flag de bloque
 //*============================================================================
 template<class Cfg, std::size_t Block_size>
-BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs) {
+BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs,
+                                         BFP_Stats<Cfg>& st,
+                                         BFP_Lfsr& rng) {
 #pragma HLS INLINE off
     
-    BFP_Global<Cfg, Block_size> out{};
+    BFP_Global<Cfg, Block_size> out = BFP_Global<Cfg, Block_size>::zero();
 
     //*========================================================================
     //* FASE 1: HALLAR EL EXPONENTE MAXIMO (Emax)
@@ -135,7 +423,7 @@ FIND_EMAX:
         out.exp_shared = 0;
         out.sign.fill(0);
         out.mant.fill(0);
-        out.delta.fill(0);
+        out.flags = 0;
         return out;
     }   
     
@@ -143,6 +431,7 @@ FIND_EMAX:
     //* FASE 2: CALCULAR EXPONENTE COMPARTIDO PARA BFP CON BIAS
     //*========================================================================
     int exp_shared_bfp = Emax + Cfg::bias_bfp;
+    count_exp_clamp<Cfg>(Emax, st);
     
     // Clamping para asegurar que cabe en WE bits
     if (exp_shared_bfp < 0) exp_shared_bfp = 0;
@@ -151,10 +440,10 @@ FIND_EMAX:
     out.exp_shared = uint32_t(exp_shared_bfp);
 
     //*========================================================================
-    //* FASE 3: CUANTIZAR CADA ELEMENTO CON EXPONENTE MAX (SHIFT & RNE)
-    //* CALCULO DE DELTAS
+    //* FASE 3: CUANTIZAR CADA ELEMENTO CON EXPONENTE MAX (SHIFT & REDONDEO)
     //*========================================================================
     const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1;
+    std::array<bool, Block_size> special{};
 
 QUANTIZE_ELEMENTS:
     for (std::size_t i = 0; i < Block_size; i++) {
@@ -166,7 +455,6 @@ QUANTIZE_ELEMENTS:
         if (num_fp32 == 0.0f) {
             out.sign[i] = 0;
             out.mant[i] = 0;
-            out.delta[i] = 0; //DELTA
             continue;
         }
         
@@ -180,15 +468,14 @@ QUANTIZE_ELEMENTS:
         // Deteccion de Nan/inf 
         if (exp_fp32 == 0xFF) {
             out.sign[i] = s;
+            special[i] = 1;
             // Distinguir entre Inf y NaN
             if (mant_fp32 == 0) {
-                // Es INFINITO: exp_max, mant_max, delta=0
+                // Es INFINITO: exp_max, mant_max
                 out.mant[i] = mant_max;
-                out.delta[i] = 0;
             } else {
-                // Es NaN: exp_max, mant_max-1 (para diferenciar), delta=0
+                // Es NaN: exp_max, mant_max-1 (para diferenciar)
                 out.mant[i] = mant_max - 1;
-                out.delta[i] = 0;
             }
         
             // Actualizar Emax para que el exponente compartido sea máximo
@@ -201,17 +488,13 @@ QUANTIZE_ELEMENTS:
         if (exp_fp32 == 0) {
             out.sign[i] = 0;
             out.mant[i] = 0;
-            out.delta[i] = 0; //DELTA PARA DESNORMALIZAR
+            st.flush_zero += st.lane_on(i);  // Subnormal FP32 -> 0
             continue;
         }
         
         //* CONSTRUIR MANTISSA DE 24 BITS CON 1 IMPLICITO
         uint32_t mant24 = (u.u & 0x7FFFFF) | (1u << 23);
         int exp_unbiased = exp_fp32 - 127;
-
-        //* CALCULO PARA GUARDAR DELTA 
-        int delta_val = Emax - exp_unbiased;
-        out.delta[i] = uint32_t(delta_val);     //GUARDAR DELTA
         
         //* REDUCCION DE MANTISSA A WM BITS & ALINEAR CON EXPONENTE COMPARTIDO
         int shift_total = (23 - Cfg::wm) + (Emax - exp_unbiased);
@@ -221,7 +504,7 @@ QUANTIZE_ELEMENTS:
         if (shift_total >= 31) {
             mant_reduced = 0u;  // Underflow
         } else if (shift_total >= 0) {
-            mant_reduced = helper_rne(mant24, shift_total);
+            mant_reduced = helper_round<Cfg>(mant24, shift_total, rng, i);
         } else {
             mant_reduced = mant24 << (-shift_total);
         }
@@ -229,16 +512,157 @@ QUANTIZE_ELEMENTS:
         // Saturar si excede el máximo permitido
         if (mant_reduced > mant_max) {
             mant_reduced = mant_max;
+            st.mant_sat += st.lane_on(i);
+        }
+        if (mant_reduced == 0u) {
+            st.flush_zero += st.lane_on(i);
         }
         
         //* GUARDAR SIGNO Y MANTISSA
         out.sign[i] = s;
         out.mant[i] = mant_reduced;
     }
-    
+
+    seal_special_lanes<Cfg, Block_size>(out, special, st);
+    return out;
+}
+
+// Version sin contadores
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> encode_block(const std::array<float, Block_size>& xs) {
+#pragma HLS INLINE
+    BFP_Stats<Cfg> st{};
+    BFP_Lfsr rng{};
+    return encode_block<Cfg, Block_size>(xs, st, rng);
+}
+
+//*============================================================================
+//* CODIFICACION DE UNA PASADA (ESPECULATIVA): FP32 ARRAY -> BFP_Global
+//* Cada elemento se cuantiza al llegar contra el Emax parcial (E_run) y se
+//* guarda con Guard bits extra y un bit sticky en el LSB (OR de lo que el
+//* corrimiento descarto). Al cerrar el bloque, un solo corrimiento por lane
+//* de T = (23 - WM) + Guard + (Emax - E_run al llegar) deja la mantisa en WM
+//* bits. Con T >= 2 el resto frente a medio ulp se conserva, asi que el
+//* resultado (y los contadores) es bit a bit el de encode_block con las
+//* politicas deterministas. La entrada se lee una vez (bs ciclos a II=1) y
+//* el ajuste es un paso desenrollado, frente a las dos pasadas FIND_EMAX +
+//* QUANTIZE_ELEMENTS. STOCH usa encode_block: sus sorteos dependen del shift.
+//*============================================================================
+template<class Cfg, std::size_t Block_size, int Guard = 2>
+BFP_Global<Cfg, Block_size> encode_block_1p(const std::array<float, Block_size>& xs,
+                                            BFP_Stats<Cfg>& st,
+                                            BFP_Lfsr& rng) {
+#pragma HLS INLINE off
+    static_assert(Guard >= 0 && 24 + Guard <= 31, "encode_block_1p: Guard debe dejar la mantisa en 31 bits");
+    if (Cfg::rnd == BFP_RND_STOCH) return encode_block<Cfg, Block_size>(xs, st, rng);
+
+    BFP_Global<Cfg, Block_size> out = BFP_Global<Cfg, Block_size>::zero();
+    const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1;
+
+    std::array<ap_uint<24 + Guard>, Block_size> spec;   // Mantisa especulativa (Guard + sticky)
+    std::array<ap_int<9>, Block_size> e_arr;            // E_run (exponente FP32) al llegar el lane
+    std::array<bool, Block_size> live{};        // Lane finito no nulo
+    std::array<bool, Block_size> subn{};        // Subnormal FP32 (cuenta como flush)
+    std::array<bool, Block_size> special{};
+#pragma HLS ARRAY_PARTITION variable=spec complete
+#pragma HLS ARRAY_PARTITION variable=e_arr complete
+
+    int E_run = std::numeric_limits<int>::min();
+
+    //*========================================================================
+    //* PASADA UNICA: EMAX PARCIAL + CUANTIZACION ESPECULATIVA
+    //*========================================================================
+ENCODE_ONE_PASS:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+
+        union {float f; uint32_t u;} u = {xs[i]};
+        const uint32_t s = (u.u >> 31) & 0x1;
+        const int exp_fp32 = int((u.u >> 23) & 0xFF);
+        const uint32_t mant_fp32 = u.u & 0x7FFFFF;
+
+        out.sign[i] = 0;
+        out.mant[i] = 0;
+        live[i] = 0;
+        special[i] = 0;
+        subn[i] = (exp_fp32 == 0 && mant_fp32 != 0) ? 1 : 0;
+        if (exp_fp32 == 0) continue;  // Cero o subnormal: no entra en Emax
+
+        // NaN/Inf entran con exponente 128, igual que en FIND_EMAX
+        const int e = exp_fp32 - 127;
+        if (e > E_run) E_run = e;
+
+        if (exp_fp32 == 0xFF) {
+            out.sign[i] = s;
+            out.mant[i] = (mant_fp32 == 0) ? mant_max : mant_max - 1;
+            special[i] = 1;
+            continue;
+        }
+
+        // Alinear a E_run con Guard bits; lo descartado queda como sticky
+        const uint32_t m = (mant_fp32 | (1u << 23)) << Guard;
+        const int d = E_run - e;
+        if (d >= 31) {
+            spec[i] = 1u;
+        } else {
+            const uint32_t lost = m & ((1u << d) - 1u);
+            spec[i] = (m >> d) | (lost != 0u ? 1u : 0u);
+        }
+        e_arr[i] = E_run;
+        out.sign[i] = s;
+        live[i] = 1;
+    }
+
+    //*========================================================================
+    //* BLOQUE DE CEROS (los subnormales no se cuentan, como en encode_block)
+    //*========================================================================
+    if (E_run == std::numeric_limits<int>::min()) {
+        out.exp_shared = 0;
+        out.sign.fill(0);
+        out.mant.fill(0);
+        out.flags = 0;
+        return out;
+    }
+
+    count_exp_clamp<Cfg>(E_run, st);
+    int exp_shared_bfp = E_run + Cfg::bias_bfp;
+    if (exp_shared_bfp < 0) exp_shared_bfp = 0;
+    if (exp_shared_bfp > (1 << Cfg::we) - 1) exp_shared_bfp = (1 << Cfg::we) - 1;
+    out.exp_shared = uint32_t(exp_shared_bfp);
+
+    //*========================================================================
+    //* AJUSTE FINAL: UN CORRIMIENTO POR LANE CON EL EMAX DEFINITIVO
+    //*========================================================================
+ENCODE_FIXUP:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        if (subn[i]) st.flush_zero += st.lane_on(i);
+        if (!live[i]) continue;
+
+        const int T = (23 - Cfg::wm) + Guard + (E_run - e_arr[i]);
+        uint32_t m = bfp_round_shr<typename Cfg::round>(uint32_t(spec[i]), T);
+        if (m > mant_max) {
+            m = mant_max;
+            st.mant_sat += st.lane_on(i);
+        }
+        if (m == 0u) st.flush_zero += st.lane_on(i);
+        out.mant[i] = m;
+    }
+
+    seal_special_lanes<Cfg, Block_size>(out, special, st);
     return out;
 }
 
+// Version sin contadores
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> encode_block_1p(const std::array<float, Block_size>& xs) {
+#pragma HLS INLINE
+    BFP_Stats<Cfg> st{};
+    BFP_Lfsr rng{};
+    return encode_block_1p<Cfg, Block_size>(xs, st, rng);
+}
+
 //*============================================================================
 //* DECODIFICACION DE BLOQUE: BFP_Global -> FP32 ARRAY
 //* Reconstruye valores FP32 desde representación BFP
@@ -260,4 +684,79 @@ DECODE_ELEMENTS:
     return result;
 }
 
+//*============================================================================
+//* HELPER: CALCULAR DELTA DESDE MANTISA
+//* Delta = WM - posición_MSB (solo lo usa el formato anterior con delta)
+//*============================================================================
+template<class Cfg>
+static inline uint32_t calculate_delta_from_mant(uint32_t mant) {
+#pragma HLS INLINE
+    
+    if (mant == 0) return 0;
+    
+    // Encontrar el bit más significativo (MSB)
+    int msb_pos = -1;
+    
+    #pragma HLS UNROLL factor=8
+    for (int b = Cfg::wm; b >= 0; --b) {
+        if ((mant >> b) & 0x1) {
+            msb_pos = b;
+            break;
+        }
+    }
+    
+    if (msb_pos < 0) return 0;
+    
+    // Delta = cuántos bits "perdidos" desde la precisión completa
+    int delta = Cfg::wm - msb_pos;
+    
+    return uint32_t(delta);
+}
+
+//*============================================================================
+//* CONVERSION CON EL FORMATO ANTERIOR [exp_shared, (sign, mant, delta) x lanes]
+//* En ese formato delta == 0 con mant_max / mant_max - 1 marcaba Inf / NaN.
+//* Hacia el formato anterior, los lanes finitos con delta 0 se recortan a
+//* mant_max - 2 para que no se lean como centinelas.
+//*============================================================================
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> unpack_delta_block(const uint32_t* words, std::size_t lanes) {
+#pragma HLS INLINE
+    const uint32_t mant_max = BFP_Global<Cfg, Block_size>::mant_max;
+
+    BFP_Global<Cfg, Block_size> blk = BFP_Global<Cfg, Block_size>::zero();
+    std::array<bool, Block_size> special{};
+    BFP_Stats<Cfg> st{};
+
+    blk.exp_shared = words[0];
+UNPACK_DELTA:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS PIPELINE II=1
+        const std::size_t l = (i < lanes) ? i : 0;   // Relleno: copia del lane 0
+        blk.sign[i] = words[1 + 3 * l];
+        blk.mant[i] = words[2 + 3 * l];
+        special[i]  = (words[3 + 3 * l] == 0u && blk.mant[i] >= mant_max - 1) ? 1 : 0;
+    }
+    seal_special_lanes<Cfg, Block_size>(blk, special, st);
+    return blk;
+}
+
+template<class Cfg, std::size_t Block_size>
+void pack_delta_block(const BFP_Global<Cfg, Block_size>& blk, std::size_t lanes, uint32_t* words) {
+#pragma HLS INLINE
+    const uint32_t mant_max = BFP_Global<Cfg, Block_size>::mant_max;
+
+    words[0] = blk.exp_shared;
+PACK_DELTA:
+    for (std::size_t i = 0; i < lanes; i++) {
+#pragma HLS PIPELINE II=1
+        const bool special = blk.is_inf(i) || blk.is_nan(i);
+        uint32_t m = blk.mant[i];
+        if (!special && m > mant_max - 2) m = mant_max - 2;
+        words[1 + 3 * i] = blk.sign[i];
+        words[2 + 3 * i] = m;
+        words[3 + 3 * i] = special ? 0u : calculate_delta_from_mant<Cfg>(m);
+    }
+}
+
 #endif // BFP_H
@@ -1,14 +1,27 @@
 #include <ap_int.h>
+#include <hls_stream.h>
 #include "bfp_hls.h"
 #include "bfp_ops_hls.h"
+#include "bfp_norm_hls.h"
+#include "bfp_act_hls.h"
 
 // Configuration
 #define WE 5
 #define WM 7
-#define N 16
+#define N_MAX 64   // Lanes sintetizados (block_size maximo)
+#define N 16       // block_size por defecto (argumento block_size = 0)
+#ifndef ROUND_MODE
+#define ROUND_MODE BFP_RND_RNE   // BFP_RND_TRUNC / BFP_RND_STOCH / BFP_RND_HALF_AWAY (-DROUND_MODE=...)
+#endif
+#ifndef ENCODE_1P
+#define ENCODE_1P 1              // encode_block_1p; 0 = dos pasadas (FIND_EMAX + QUANTIZE_ELEMENTS)
+#endif
+#ifndef LANES
+#define LANES 1                  // Copias del datapath de COMPUTE (bloques en paralelo, -DLANES=...)
+#endif
 
-using Cfg = BFP_bias<WE, WM>;
-using blk_t = BFP_Global<Cfg, N>;
+using Cfg = BFP_bias<WE, WM, ROUND_MODE>;
+using blk_t = BFP_Global<Cfg, N_MAX>;
 
 // Operation codes
 typedef enum : unsigned int {
@@ -18,50 +31,1060 @@ typedef enum : unsigned int {
     OP_SUB    = 3,
     OP_MUL    = 4,
     OP_DIV    = 5,
-    OP_RCP    = 6
+    OP_RCP    = 6,
+    OP_PROGRAM = 7,    // Ejecuta la lista de comandos en 'program'
+    // Modo fusionado FP32 -> BFP -> FP32: A = in_fp32, B = in_fp32_b
+    OP_ADD_F32 = 8,
+    OP_SUB_F32 = 9,
+    OP_MUL_F32 = 10,
+    OP_DIV_F32 = 11,
+    OP_RCP_F32 = 12,   // 1 / B (lee in_fp32_b, igual que OP_RCP)
+    // Normalizacion por filas de row_blocks bloques: A = in_bfp_a,
+    // gamma = in_fp32, beta = in_fp32_b (un float por canal), salida en out_bfp
+    OP_LAYERNORM = 13,
+    OP_RMSNORM   = 14, // sin media ni beta
+    // Activaciones por tabla sobre A (in_bfp_a -> out_bfp), orden de ACT_*
+    OP_GELU    = 15,
+    OP_SILU    = 16,
+    OP_TANH    = 17,
+    OP_SIGMOID = 18,
+    OP_EXP     = 19,
+    // Operando escalar: Z = A op scalar_b (B no se lee de memoria)
+    OP_ADD_SCALAR = 20,
+    OP_SUB_SCALAR = 21,
+    OP_MUL_SCALAR = 22,
+    OP_DIV_SCALAR = 23,
+    // Broadcast por filas: B = row_blocks bloques de in_bfp_b cacheados en chip,
+    // el bloque i de A usa B[i % row_blocks] (bias por canal, escala por canal)
+    OP_ADD_BCAST = 24,
+    OP_SUB_BCAST = 25,
+    OP_MUL_BCAST = 26,
+    OP_DIV_BCAST = 27,
+    // Operandos mixtos: A = in_bfp_a (BFP), B = in_fp32 (FP32) codificado en el
+    // pipeline (sin pasada ENCODE previa). Salida FP32, o BFP con OP_OUT_BFP
+    OP_ADD_MIX = 28,
+    OP_SUB_MIX = 29,
+    OP_MUL_MIX = 30,
+    OP_DIV_MIX = 31
 } bfp_op_t;
 
+// operation = opcode | flags
+static constexpr unsigned int BFP_OPCODE_MASK = 0xFF;
+static constexpr unsigned int OP_OUT_BFP      = 0x100;  // *_F32 / *_MIX: salida en out_bfp (compacto)
+// In-place: la salida sobrescribe A. A se lee del mismo buffer (y puerto m_axi)
+// donde se escribe el resultado: out_bfp para las ops BFP -> BFP, out_fp32 para
+// *_F32 con salida FP32 (*_MIX solo con OP_OUT_BFP). in_bfp_a / in_fp32 no se usan. Cada bloque (o fila en
+// LAYERNORM/RMSNORM) se lee completo antes de escribirse y nunca se relee, y al
+// ser el mismo puerto HLS conserva el orden lectura -> escritura de los bursts.
+// No aplica a ENCODE / DECODE / RCP (A no existe o cambia de formato).
+static constexpr unsigned int OP_IN_PLACE     = 0x200;
+// Planar: todos los tensores compactos del lanzamiento (A, B, salida) usan el
+// layout por planos en lugar del intercalado (ver bfp_layout_t)
+static constexpr unsigned int OP_PLANAR       = 0x400;
+
 //Constants for compact format
-static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 3 * N;  // 49 para N=16
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+// block_size en tiempo de ejecucion: potencia de 2 en [BFP_MIN_BLOCK, N_MAX]
+static constexpr unsigned int BFP_MIN_BLOCK = 4;
+
+// LayerNorm / RMSNorm: fila completa en chip (hasta 64 bloques de block_size canales;
+// con row_blocks > NORM_MAX_ROW_BLOCKS el lanzamiento no procesa ningun bloque)
+// OP_*_BCAST: el mismo limite para el tensor B cacheado (periodo mayor: rechazado)
+static constexpr unsigned int NORM_MAX_ROW_BLOCKS = 64;
+static constexpr float        BFP_NORM_EPS        = 1e-5f;
+
+// Command list (OP_PROGRAM)
+//   program[0] = numero de pasos
+//   program[1] = slot que se escribe en out_bfp (BFP_PROG_NO_OUTPUT = ninguno)
+//   program[2 + s] = paso s: op | src_a << 8 | src_b << 16 | dst << 24
+// Slot 0 se precarga con in_bfp_a y slot 1 con in_bfp_b (solo si se usan).
+// OP_ENCODE escribe en dst el bloque de in_fp32; OP_DECODE escribe src_a en
+// out_fp32; OP_RCP lee src_b (igual que el kernel de una operacion).
+// Programa invalido (mas de BFP_PROG_MAX_STEPS pasos, slot >= BFP_PROG_SLOTS,
+// opcode fuera de OP_ENCODE..OP_RCP): no se ejecuta ni escribe nada.
+static constexpr unsigned int BFP_PROG_SLOTS     = 8;
+static constexpr unsigned int BFP_PROG_MAX_STEPS = 16;
+static constexpr unsigned int BFP_PROG_HEADER    = 2;
+static constexpr unsigned int BFP_PROG_NO_OUTPUT = 0xFF;
+
+// Numeric health counters (buffer 'stats', escrito al final del lanzamiento)
+//   stats[0..6] = blocks, exp_overflow, exp_underflow, mant_sat, flush_zero,
+//                 nan_count, inf_count
+//   stats[7 + e] = bloques producidos con exp_shared == e  (e < 2^WE)
+static constexpr unsigned int BFP_STATS_COUNTERS = 7;
+static constexpr unsigned int BFP_STATS_WORDS    = BFP_STATS_COUNTERS + (1u << WE);
+
+using stats_t = BFP_Stats<Cfg>;
+
+// Codificacion FP32 -> BFP de todos los caminos del kernel (mismo resultado
+// con las dos variantes; ENCODE_1P solo cambia latencia y area)
+static inline blk_t encode_fp32(const std::array<float, N_MAX>& xs, stats_t& st, BFP_Lfsr& rng) {
+#pragma HLS INLINE
+#if ENCODE_1P
+    return encode_block_1p<Cfg, N_MAX>(xs, st, rng);
+#else
+    return encode_block<Cfg, N_MAX>(xs, st, rng);
+#endif
+}
+
+// OP_*_SCALAR: el escalar se codifica una vez, fuera de las copias, con el
+// redondeo determinista del modo (STOCH usa RNE). Todos los lanes y bloques
+// ven el mismo B, que no depende de LANES ni del seed
+using scalar_cfg_t = BFP_bias<WE, WM, (Cfg::rnd == BFP_RND_STOCH) ? int(BFP_RND_RNE) : Cfg::rnd>;
+
+static blk_t encode_scalar(float s, stats_t& st) {
+#pragma HLS INLINE
+    std::array<float, N_MAX> s_in;
+    s_in.fill(s);
+    BFP_Stats<scalar_cfg_t> s_st{};
+    BFP_Lfsr s_rng{};                   // Sin sorteos: scalar_cfg_t no es STOCH
+    s_st.lane_limit = st.lane_limit;
+#if ENCODE_1P
+    const BFP_Global<scalar_cfg_t, N_MAX> S = encode_block_1p<scalar_cfg_t, N_MAX>(s_in, s_st, s_rng);
+#else
+    const BFP_Global<scalar_cfg_t, N_MAX> S = encode_block<scalar_cfg_t, N_MAX>(s_in, s_st, s_rng);
+#endif
+    st.merge(s_st);
+
+    blk_t B = blk_t::zero();
+    B.exp_shared = S.exp_shared;
+    B.flags      = S.flags;
+SCALAR_LANES:
+    for (std::size_t i = 0; i < N_MAX; i++) {
+#pragma HLS UNROLL
+        B.sign[i] = S.sign[i];
+        B.mant[i] = S.mant[i];
+    }
+    return B;
+}
+
+// Cycle profile (buffer 'profile', palabras de 64 bits, escrito al final)
+//   profile[0] = ciclos totales del lanzamiento
+//   profile[1..3] = ciclos en LOAD / COMPUTE / STORE
+//   profile[4] = ciclos de stall: ciclos de LOAD+STORE que no movieron una
+//                palabra (el puerto ideal mueve 1 palabra/ciclo)
+//   profile[5] = ciclos fuera de las fases (arranque, control)
+//   profile[6] = palabras movidas por LOAD+STORE
+//   profile[7] = n_blocks
+// Los contadores los lleva profile_monitor, un proceso DATAFLOW con II=1
+// que corre en paralelo a bfp_process: un ciclo = una iteracion. En csim
+// los procesos se ejecutan en serie y cada fase cuenta como un ciclo; los
+// valores solo son ciclos reales en cosim / hardware.
+static constexpr unsigned int BFP_PROFILE_WORDS = 8;
+
+static constexpr unsigned int BFP_PHASE_OTHER   = 0;
+static constexpr unsigned int BFP_PHASE_LOAD    = 1;
+static constexpr unsigned int BFP_PHASE_COMPUTE = 2;
+static constexpr unsigned int BFP_PHASE_STORE   = 3;
+static constexpr unsigned int BFP_PHASE_END     = 0xF;  // seguido de las palabras movidas
+
+typedef hls::stream<unsigned int> phase_stream_t;
+
+// Aviso de cambio de fase al monitor
+void mark_phase(phase_stream_t& phase, unsigned int p) {
+#pragma HLS INLINE
+    phase.write(p);
+}
+
+//=============================================================================
+// TAMAÑO DE BLOQUE EN TIEMPO DE EJECUCION (block_size): el datapath se
+// sintetiza para N_MAX lanes y cada lanzamiento usa bs lanes por bloque
+// (4, 8, 16, 32 o 64). En memoria un bloque ocupa 1 + 2*bs palabras en
+// compacto y bs floats en FP32; los lanes >= bs no existen en memoria.
+//
+// TENSORES DE LONGITUD ARBITRARIA (n_elements): el ultimo bloque puede tener
+// menos de bs lanes validos. Se leen y escriben solo los lanes validos (burst
+// mas corto).
+//
+// En ambos casos los lanes invalidos llevan una copia del lane 0 por el
+// datapath. Todas las ops son lane a lane, asi que las copias no cambian Emax
+// ni el resultado de los lanes validos, y los contadores por lane las ignoran
+// (stats_t::lane_limit). Los bucles de computo recorren siempre N_MAX lanes:
+// un bloque pequeño ahorra ancho de banda, no ciclos de COMPUTE.
+//=============================================================================
+
+// block_size del lanzamiento; 0 o un valor no admitido -> N
+unsigned int select_block_size(unsigned int block_size) {
+#pragma HLS INLINE
+    const bool pow2 = (block_size & (block_size - 1)) == 0;
+    return (pow2 && block_size >= BFP_MIN_BLOCK && block_size <= N_MAX) ? block_size : N;
+}
+
+// Palabras de un bloque compacto con 'lanes' lanes validos
+unsigned int bfp_words(unsigned int lanes) {
+#pragma HLS INLINE
+    return 1 + 2 * lanes;
+}
+
+// Lanes validos del bloque blk_idx (bloques de bs lanes, 'total' elementos)
+unsigned int block_lanes(unsigned int total, unsigned int blk_idx, unsigned int bs) {
+#pragma HLS INLINE
+    const unsigned int rest = total - blk_idx * bs;
+    return (rest < bs) ? rest : bs;
+}
+
+// Lanes invalidos <- lane 0
+void fill_tail_lanes(blk_t& blk, unsigned int lanes) {
+#pragma HLS INLINE
+FILL_TAIL_LANES:
+    for (int i = 1; i < N_MAX; i++) {
+#pragma HLS UNROLL
+        if (unsigned(i) >= lanes) {
+            blk.sign[i]  = blk.sign[0];
+            blk.mant[i]  = blk.mant[0];
+        }
+    }
+}
+
+//=============================================================================
+// LAYOUT PLANAR (OP_PLANAR): en vez de intercalar [exp, (sign, mant) x bs]
+// por bloque, un tensor de T bloques se guarda en tres planos contiguos:
+//   [0, T)                    exponentes (exp_word, uno por bloque)
+//   [T, T*(1+sw))             signos, sw = ceil(bs/32) palabras por bloque
+//                             (bit i de la palabra i/32 = signo del lane i)
+//   [T*(1+sw), T*(1+sw+bs))   mantisas, bs palabras por bloque
+// Un bloque ocupa 1 + sw + bs palabras en lugar de 1 + 2*bs y cada plano se
+// mueve con su propio burst, sin desentrelazar campos. T = n_blocks (row_blocks
+// para el B cacheado de OP_*_BCAST).
+//=============================================================================
+struct bfp_layout_t {
+    bool planar;
+    unsigned int blocks;   // T: bloques del tensor (separacion entre planos)
+    unsigned int bs;       // lanes por bloque del lanzamiento
+};
+
+// Palabras del plano de signos para 'lanes' lanes
+unsigned int sign_words(unsigned int lanes) {
+#pragma HLS INLINE
+    return (lanes + 31) / 32;
+}
 
-// Package BFP_Global in vector
-void pack_bfp_block(const blk_t& blk, unsigned int* vec, unsigned int offset) {
+// Palabras movidas por un bloque con 'lanes' lanes validos
+unsigned int block_words(const bfp_layout_t& L, unsigned int lanes) {
+#pragma HLS INLINE
+    return L.planar ? 1 + sign_words(lanes) + lanes : bfp_words(lanes);
+}
+
+// Package BFP_Global in vector (solo los lanes validos)
+void pack_compact_block(const blk_t& blk, unsigned int* vec, unsigned int offset,
+                        unsigned int lanes) {
 #pragma HLS INLINE off
     
-    // Primer elemento: exponente compartido
-    vec[offset] = blk.exp_shared;
+    // Primer elemento: exponente compartido y flags
+    vec[offset] = blk.exp_word();
     unsigned int idx = offset + 1;
     
 PACK_ELEMENTS:
-    for (int i = 0; i < N; i++) {
+    for (unsigned int i = 0; i < lanes; i++) {
 #pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
         vec[idx++] = blk.sign[i];
         vec[idx++] = blk.mant[i];
-        vec[idx++] = blk.delta[i];
     }
 }
 
-// Unpack the BFP block
-void unpack_bfp_block(const unsigned int* vec, blk_t& blk, unsigned int offset) {
+// Unpack the BFP block (burst de los lanes validos, el resto <- lane 0)
+void unpack_compact_block(const unsigned int* vec, blk_t& blk, unsigned int offset,
+                          unsigned int lanes) {
 #pragma HLS INLINE off
     
-    // Primer elemento: exponente compartido
-    blk.exp_shared = vec[offset];
+    // Primer elemento: exponente compartido y flags
+    blk.set_exp_word(vec[offset]);
     unsigned int idx = offset + 1;
     
 UNPACK_ELEMENTS:
-    for (int i = 0; i < N; i++) {
+    for (unsigned int i = 0; i < lanes; i++) {
 #pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
         blk.sign[i]  = vec[idx++];
         blk.mant[i]  = vec[idx++];
-        blk.delta[i] = vec[idx++];
+    }
+    fill_tail_lanes(blk, lanes);
+}
+
+// Bloque blk_idx en layout planar: exponente, palabras de signos y mantisas
+void pack_planar_block(const blk_t& blk, unsigned int* vec, const bfp_layout_t& L,
+                       unsigned int blk_idx, unsigned int lanes) {
+#pragma HLS INLINE off
+
+    const unsigned int sw = sign_words(L.bs);
+    const unsigned int sign_base = L.blocks + blk_idx * sw;
+    const unsigned int mant_base = L.blocks * (1 + sw) + blk_idx * L.bs;
+
+    vec[blk_idx] = blk.exp_word();
+
+PACK_SIGN_PLANE:
+    for (unsigned int w = 0; w < sign_words(lanes); w++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2 avg=1
+        unsigned int bits = 0;
+    PACK_SIGN_BITS:
+        for (unsigned int i = 0; i < 32; i++) {
+#pragma HLS UNROLL
+            const unsigned int l = w * 32 + i;
+            if (l < lanes) bits |= unsigned(blk.sign[l]) << i;
+        }
+        vec[sign_base + w] = bits;
+    }
+
+PACK_MANT_PLANE:
+    for (unsigned int i = 0; i < lanes; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        vec[mant_base + i] = blk.mant[i];
+    }
+}
+
+void unpack_planar_block(const unsigned int* vec, blk_t& blk, const bfp_layout_t& L,
+                         unsigned int blk_idx, unsigned int lanes) {
+#pragma HLS INLINE off
+
+    const unsigned int sw = sign_words(L.bs);
+    const unsigned int sign_base = L.blocks + blk_idx * sw;
+    const unsigned int mant_base = L.blocks * (1 + sw) + blk_idx * L.bs;
+
+    blk.set_exp_word(vec[blk_idx]);
+
+UNPACK_SIGN_PLANE:
+    for (unsigned int w = 0; w < sign_words(lanes); w++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=2 avg=1
+        const unsigned int bits = vec[sign_base + w];
+    UNPACK_SIGN_BITS:
+        for (unsigned int i = 0; i < 32; i++) {
+#pragma HLS UNROLL
+            blk.sign[w * 32 + i] = (bits >> i) & 1u;
+        }
+    }
+
+UNPACK_MANT_PLANE:
+    for (unsigned int i = 0; i < lanes; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        blk.mant[i] = vec[mant_base + i];
+    }
+    fill_tail_lanes(blk, lanes);
+}
+
+// Bloque blk_idx del tensor con el layout del lanzamiento
+void pack_bfp_block(const blk_t& blk, unsigned int* vec, const bfp_layout_t& L,
+                    unsigned int blk_idx, unsigned int lanes) {
+#pragma HLS INLINE
+    if (L.planar) {
+        pack_planar_block(blk, vec, L, blk_idx, lanes);
+    } else {
+        pack_compact_block(blk, vec, blk_idx * bfp_words(L.bs), lanes);
+    }
+}
+
+void unpack_bfp_block(const unsigned int* vec, blk_t& blk, const bfp_layout_t& L,
+                      unsigned int blk_idx, unsigned int lanes) {
+#pragma HLS INLINE
+    if (L.planar) {
+        unpack_planar_block(vec, blk, L, blk_idx, lanes);
+    } else {
+        unpack_compact_block(vec, blk, blk_idx * bfp_words(L.bs), lanes);
+    }
+}
+
+// Carga de A: in_bfp_a, o out_bfp en modo in-place
+void load_a_block(bool in_place, const unsigned int* in_bfp_a, const unsigned int* out_bfp,
+                  blk_t& A, const bfp_layout_t& L, unsigned int blk_idx, unsigned int lanes) {
+#pragma HLS INLINE
+    if (in_place) {
+        unpack_bfp_block(out_bfp, A, L, blk_idx, lanes);
+    } else {
+        unpack_bfp_block(in_bfp_a, A, L, blk_idx, lanes);
+    }
+}
+
+//=============================================================================
+// COMPUTE: una operacion sobre un bloque (compartido por el modo directo y
+// el interprete de OP_PROGRAM para no duplicar el datapath)
+//=============================================================================
+void compute_block(unsigned int op,
+                   const blk_t& A, const blk_t& B,
+                   const std::array<float, N_MAX>& fp_in,
+                   blk_t& Z, std::array<float, N_MAX>& fp_out,
+                   stats_t& st, BFP_Lfsr& rng) {
+#pragma HLS INLINE off
+
+    switch (op) {
+        case OP_ENCODE:
+            Z = encode_fp32(fp_in, st, rng);
+            break;
+            
+        case OP_DECODE:
+            fp_out = decode_block<Cfg, N_MAX>(A);
+            break;
+            
+        case OP_ADD:
+            Z = add_blocks<Cfg, N_MAX>(A, B, st, rng);
+            break;
+            
+        case OP_SUB:
+            Z = sub_blocks<Cfg, N_MAX>(A, B, st, rng);
+            break;
+            
+        case OP_MUL:
+            Z = mul_blocks<Cfg, N_MAX>(A, B, st, rng);
+            break;
+            
+        case OP_DIV:
+            Z = div_blocks<Cfg, N_MAX>(A, B, st, rng);
+            break;
+            
+        case OP_RCP:
+            Z = rcp_blocks<Cfg, N_MAX>(B, st);
+            break;
+
+        case OP_GELU:
+        case OP_SILU:
+        case OP_TANH:
+        case OP_SIGMOID:
+        case OP_EXP:
+            Z = act_blocks<Cfg, N_MAX>(op - OP_GELU, A, st, rng);
+            break;
+            
+        default:
+            Z = A;
+            break;
+    }
+
+    if (op != OP_DECODE) {
+        st.record_block<N_MAX>(Z);
+    }
+}
+
+// COMPUTE de un bloque del modo directo: codifica los operandos FP32
+// (*_F32 / *_MIX), ejecuta la operacion y decodifica la salida FP32. Cada
+// copia del datapath (LANES) es una instancia de esta funcion.
+void compute_lane(unsigned int alu_op, bool fused_f32, bool mixed_op, bool store_fp32,
+                  blk_t& A, blk_t& B,
+                  const std::array<float, N_MAX>& fp_in,
+                  const std::array<float, N_MAX>& fp_b,
+                  blk_t& Z, std::array<float, N_MAX>& fp_out,
+                  stats_t& st, BFP_Lfsr& rng) {
+#pragma HLS INLINE off
+
+    if (fused_f32) {
+        if (alu_op != OP_RCP) {
+            A = encode_fp32(fp_in, st, rng);
+        }
+        B = encode_fp32(fp_b, st, rng);
+    } else if (mixed_op) {
+        B = encode_fp32(fp_b, st, rng);
+    }
+
+    compute_block(alu_op, A, B, fp_in, Z, fp_out, st, rng);
+
+    if ((fused_f32 || mixed_op) && store_fp32) {
+        fp_out = decode_block<Cfg, N_MAX>(Z);
+    }
+}
+
+// Volcado de los contadores al buffer 'stats'
+void write_stats(const stats_t& st, unsigned int* stats) {
+#pragma HLS INLINE off
+
+    stats[0] = st.blocks;
+    stats[1] = st.exp_overflow;
+    stats[2] = st.exp_underflow;
+    stats[3] = st.mant_sat;
+    stats[4] = st.flush_zero;
+    stats[5] = st.nan_count;
+    stats[6] = st.inf_count;
+
+WRITE_EXP_HIST:
+    for (int e = 0; e < stats_t::n_exp; e++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=32 max=32 avg=32
+        stats[BFP_STATS_COUNTERS + e] = st.exp_hist[e];
+    }
+}
+
+// Carga de un bloque FP32 (lanes elementos consecutivos, el resto <- lane 0)
+void load_fp32_block(const float* src, std::array<float, N_MAX>& dst, unsigned int offset,
+                     unsigned int lanes) {
+#pragma HLS INLINE off
+
+LOAD_FP32_BLOCK:
+    for (unsigned int i = 0; i < lanes; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        dst[i] = src[offset + i];
+    }
+
+FILL_FP32_TAIL:
+    for (int i = 1; i < N_MAX; i++) {
+#pragma HLS UNROLL
+        if (unsigned(i) >= lanes) dst[i] = dst[0];
+    }
+}
+
+// Escritura de un bloque FP32 (solo los lanes validos)
+void store_fp32_block(const std::array<float, N_MAX>& src, float* dst, unsigned int offset,
+                      unsigned int lanes) {
+#pragma HLS INLINE off
+
+STORE_FP32_BLOCK:
+    for (unsigned int i = 0; i < lanes; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        dst[offset + i] = src[i];
+    }
+}
+
+//=============================================================================
+// OP_PROGRAM: carga de la lista de comandos (una vez por lanzamiento)
+//=============================================================================
+bool load_program(const unsigned int* program,
+                  unsigned int steps[BFP_PROG_MAX_STEPS],
+                  unsigned int& n_steps,
+                  unsigned int& out_slot,
+                  bool& uses_a, bool& uses_b, bool& uses_fp32) {
+#pragma HLS INLINE off
+
+    n_steps  = program[0];
+    out_slot = program[1];
+
+    uses_a = false;
+    uses_b = false;
+    uses_fp32 = false;
+
+    bool valid = (n_steps <= BFP_PROG_MAX_STEPS) &&
+                 (out_slot < BFP_PROG_SLOTS || out_slot == BFP_PROG_NO_OUTPUT);
+    if (n_steps > BFP_PROG_MAX_STEPS) n_steps = 0;
+
+LOAD_STEPS:
+    for (unsigned int s = 0; s < n_steps; s++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=16 avg=4
+        unsigned int w  = program[BFP_PROG_HEADER + s];
+        unsigned int op = w & 0xFF;
+        unsigned int sa = (w >> 8) & 0xFF;
+        unsigned int sb = (w >> 16) & 0xFF;
+        unsigned int dst = (w >> 24) & 0xFF;
+        steps[s] = w;
+
+        if (op > OP_RCP || sa >= BFP_PROG_SLOTS || sb >= BFP_PROG_SLOTS ||
+            dst >= BFP_PROG_SLOTS) {
+            valid = false;
+        }
+
+        // Solo se leen A/B de memoria si algun paso consume los slots 0/1
+        if (op == OP_ENCODE) {
+            uses_fp32 = true;
+        } else if (op == OP_DECODE) {
+            if (sa == 0) uses_a = true;
+            if (sa == 1) uses_b = true;
+        } else {
+            if (sa == 0 || sb == 0) uses_a = true;
+            if (sa == 1 || sb == 1) uses_b = true;
+        }
+    }
+    if (out_slot == 0) uses_a = true;
+    if (out_slot == 1) uses_b = true;
+
+    if (!valid) {
+        n_steps  = 0;
+        out_slot = BFP_PROG_NO_OUTPUT;
+        uses_a = false;
+        uses_b = false;
+        uses_fp32 = false;
+    }
+    return valid;
+}
+
+//=============================================================================
+// OP_PROGRAM: ejecuta todos los pasos sobre un bloque. Los intermedios
+// viven en el banco de registros 'regs' y nunca regresan a HBM.
+//=============================================================================
+void run_program_block(const unsigned int steps[BFP_PROG_MAX_STEPS],
+                       unsigned int n_steps,
+                       unsigned int out_slot,
+                       bool uses_a, bool uses_b, bool uses_fp32,
+                       bool in_place,
+                       const float* in_fp32,
+                       const unsigned int* in_bfp_a,
+                       const unsigned int* in_bfp_b,
+                       float* out_fp32,
+                       unsigned int* out_bfp,
+                       const bfp_layout_t& L,
+                       unsigned int fp32_offset,
+                       unsigned int blk_idx,
+                       unsigned int lanes,
+                       stats_t& st,
+                       BFP_Lfsr& rng,
+                       phase_stream_t& phase,
+                       unsigned int& mem_words) {
+#pragma HLS INLINE off
+
+    blk_t regs[BFP_PROG_SLOTS];
+    std::array<float, N_MAX> fp_in{}, fp_out{};
+
+    mark_phase(phase, BFP_PHASE_LOAD);
+    if (uses_a) load_a_block(in_place, in_bfp_a, out_bfp, regs[0], L, blk_idx, lanes);
+    if (uses_b) unpack_bfp_block(in_bfp_b, regs[1], L, blk_idx, lanes);
+    if (uses_a) mem_words += block_words(L, lanes);
+    if (uses_b) mem_words += block_words(L, lanes);
+
+    if (uses_fp32) {
+        load_fp32_block(in_fp32, fp_in, fp32_offset, lanes);
+        mem_words += lanes;
+    }
+
+    // Los DECODE intermedios escriben out_fp32 dentro de la fase COMPUTE
+    mark_phase(phase, BFP_PHASE_COMPUTE);
+
+EXEC_STEPS:
+    for (unsigned int s = 0; s < n_steps; s++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=16 avg=4
+        unsigned int w   = steps[s];
+        unsigned int op  = w & 0xFF;
+        // Slots ya validados en load_program (< BFP_PROG_SLOTS)
+        unsigned int sa  = ((w >> 8)  & 0xFF) % BFP_PROG_SLOTS;
+        unsigned int sb  = ((w >> 16) & 0xFF) % BFP_PROG_SLOTS;
+        unsigned int dst = ((w >> 24) & 0xFF) % BFP_PROG_SLOTS;
+
+        blk_t Z = blk_t::zero();
+        compute_block(op, regs[sa], regs[sb], fp_in, Z, fp_out, st, rng);
+
+        if (op == OP_DECODE) {
+            store_fp32_block(fp_out, out_fp32, fp32_offset, lanes);
+            mem_words += lanes;
+        } else {
+            regs[dst] = Z;
+        }
+    }
+
+    if (out_slot < BFP_PROG_SLOTS) {
+        mark_phase(phase, BFP_PHASE_STORE);
+        pack_bfp_block(regs[out_slot], out_bfp, L, blk_idx, lanes);
+        mem_words += block_words(L, lanes);
+    }
+}
+
+//=============================================================================
+// OP_LAYERNORM / OP_RMSNORM: gamma y beta se cargan una vez por lanzamiento
+//=============================================================================
+void load_norm_params(const float* in_fp32, const float* in_fp32_b, bool rms,
+                      unsigned int channels,
+                      float gamma[NORM_MAX_ROW_BLOCKS * N_MAX],
+                      float beta[NORM_MAX_ROW_BLOCKS * N_MAX]) {
+#pragma HLS INLINE off
+
+LOAD_NORM_PARAMS:
+    for (unsigned int c = 0; c < channels; c++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=1024 avg=256
+        gamma[c] = in_fp32[c];
+        beta[c]  = rms ? 0.0f : in_fp32_b[c];
+    }
+}
+
+// Una fila: LOAD de todos sus bloques, estadisticas + escala, STORE
+// (row_elems canales validos; solo el ultimo bloque puede ser parcial)
+void run_norm_row(bool rms,
+                  unsigned int row_start,
+                  unsigned int row_len,
+                  unsigned int row_elems,
+                  const bfp_layout_t& L,
+                  const float gamma[NORM_MAX_ROW_BLOCKS * N_MAX],
+                  const float beta[NORM_MAX_ROW_BLOCKS * N_MAX],
+                  bool in_place,
+                  const unsigned int* in_bfp_a,
+                  unsigned int* out_bfp,
+                  stats_t& st,
+                  BFP_Lfsr& rng,
+                  phase_stream_t& phase,
+                  unsigned int& mem_words) {
+#pragma HLS INLINE off
+
+    blk_t row[NORM_MAX_ROW_BLOCKS], res[NORM_MAX_ROW_BLOCKS];
+
+    mark_phase(phase, BFP_PHASE_LOAD);
+LOAD_NORM_ROW:
+    for (unsigned int b = 0; b < row_len; b++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        const unsigned int lanes = block_lanes(row_elems, b, L.bs);
+        load_a_block(in_place, in_bfp_a, out_bfp, row[b], L, row_start + b, lanes);
+        mem_words += block_words(L, lanes);
+    }
+
+    mark_phase(phase, BFP_PHASE_COMPUTE);
+    bfp_norm_row<Cfg, N_MAX, NORM_MAX_ROW_BLOCKS>(row, row_len, row_elems, L.bs, gamma, beta, rms,
+                                                  BFP_NORM_EPS, res, st, rng);
+
+    mark_phase(phase, BFP_PHASE_STORE);
+STORE_NORM_ROW:
+    for (unsigned int b = 0; b < row_len; b++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        const unsigned int lanes = block_lanes(row_elems, b, L.bs);
+        pack_bfp_block(res[b], out_bfp, L, row_start + b, lanes);
+        mem_words += block_words(L, lanes);
     }
 }
 
 //=============================================================================
-// MAIN KERNEL - Simplified without DATAFLOW for stable synthesis
+// PROCESS: datapath completo del kernel (carga, computo, escritura). Emite
+// un evento por cambio de fase hacia profile_monitor.
+//
+// MULTI-LANE (Lanes = LANES): el modo directo recorre los bloques en grupos
+// de Lanes. El bloque blk_idx + c va a la copia c (reparto round-robin):
+// LOAD y STORE del grupo comparten los puertos m_axi (bloques consecutivos,
+// un burst tras otro) y COMPUTE ejecuta las Lanes copias en paralelo, cada
+// una con sus contadores. Un grupo cuesta ~Lanes * (LOAD + STORE) + COMPUTE
+// ciclos en vez de Lanes * (LOAD + COMPUTE + STORE): escala con Lanes hasta
+// que LOAD + STORE domina. OP_PROGRAM y LAYERNORM / RMSNORM siguen con una
+// sola copia. Con STOCH la copia c siembra su LFSR con seed + c: el bloque
+// blk_idx se redondea con los sorteos de la copia blk_idx % Lanes, asi que el
+// resultado estocastico (y sus contadores) cambia con LANES. Solo es
+// reproducible para el mismo seed y el mismo LANES.
+//=============================================================================
+template<unsigned int Lanes>
+void bfp_process(const unsigned int operation,
+                 const unsigned int n_blocks,
+                 const float* in_fp32,
+                 const unsigned int* in_bfp_a,
+                 const unsigned int* in_bfp_b,
+                 float* out_fp32,
+                 unsigned int* out_bfp,
+                 const unsigned int* program,
+                 const float* in_fp32_b,
+                 unsigned int* stats,
+                 const unsigned int row_blocks,
+                 const float scalar_b,
+                 const unsigned int n_elements,
+                 const unsigned int block_size,
+                 const unsigned int seed,
+                 phase_stream_t& phase) {
+#pragma HLS INLINE off
+
+    // Decodificacion de la operacion (opcode + flags)
+    const unsigned int opcode = operation & BFP_OPCODE_MASK;
+    const bool fused_f32 = (opcode >= OP_ADD_F32) && (opcode <= OP_RCP_F32);
+    const bool scalar_op = (opcode >= OP_ADD_SCALAR) && (opcode <= OP_DIV_SCALAR);
+    const bool bcast_op  = (opcode >= OP_ADD_BCAST) && (opcode <= OP_DIV_BCAST);
+    const bool mixed_op  = (opcode >= OP_ADD_MIX) && (opcode <= OP_DIV_MIX);
+    const unsigned int alu_op = fused_f32 ? (opcode - OP_ADD_F32 + OP_ADD)
+                              : scalar_op ? (opcode - OP_ADD_SCALAR + OP_ADD)
+                              : bcast_op  ? (opcode - OP_ADD_BCAST + OP_ADD)
+                              : mixed_op  ? (opcode - OP_ADD_MIX + OP_ADD)
+                              : opcode;
+    const bool store_fp32 = (opcode == OP_DECODE) ||
+                            ((fused_f32 || mixed_op) && !(operation & OP_OUT_BFP));
+    const bool norm_op = (opcode == OP_LAYERNORM) || (opcode == OP_RMSNORM);
+    const bool rms = (opcode == OP_RMSNORM);
+    const bool in_place = (operation & OP_IN_PLACE) &&
+                          (fused_f32 ? (store_fp32 && alu_op != OP_RCP)
+                         : mixed_op  ? !store_fp32
+                                     : (opcode != OP_ENCODE && opcode != OP_DECODE && opcode != OP_RCP));
+
+    // Lanes por bloque del lanzamiento y layout de los tensores compactos
+    const unsigned int bs = select_block_size(block_size);
+    const bool planar = (operation & OP_PLANAR) != 0;
+    const bfp_layout_t L = {planar, n_blocks, bs};
+
+    // Elementos validos (n_elements = 0: n_blocks bloques completos) y bloques
+    // que los contienen; el ultimo puede ser parcial
+    const unsigned int total = (n_elements == 0 || n_elements > n_blocks * bs) ? n_blocks * bs
+                                                                                : n_elements;
+    const unsigned int n_used = (total + bs - 1) / bs;
+
+    unsigned int steps[BFP_PROG_MAX_STEPS];
+    unsigned int n_steps = 0, out_slot = BFP_PROG_NO_OUTPUT;
+    bool uses_a = false, uses_b = false, uses_fp32 = false, prog_ok = false;
+
+    // Contadores y LFSR por copia; la copia 0 tambien lleva OP_PROGRAM, norm
+    // y B constante
+    stats_t st_lane[Lanes];
+    BFP_Lfsr rng_lane[Lanes];
+#pragma HLS ARRAY_PARTITION variable=st_lane complete dim=1
+#pragma HLS ARRAY_PARTITION variable=rng_lane complete dim=1
+INIT_LANE_STATS:
+    for (unsigned int c = 0; c < Lanes; c++) {
+#pragma HLS UNROLL
+        st_lane[c] = stats_t{};
+        st_lane[c].lane_limit = bs;
+    }
+    // Sin desenrollar: las copias comparten el fmix32 de seed()
+SEED_LANE_RNG:
+    for (unsigned int c = 0; c < Lanes; c++) {
+        rng_lane[c].seed(seed + c);   // STOCH: mismo seed y mismo LANES -> mismo resultado
+    }
+    stats_t& st = st_lane[0];
+    BFP_Lfsr& rng = rng_lane[0];
+    unsigned int mem_words = 0;
+
+    if (opcode == OP_PROGRAM) {
+        mark_phase(phase, BFP_PHASE_LOAD);
+        prog_ok = load_program(program, steps, n_steps, out_slot, uses_a, uses_b, uses_fp32);
+        mem_words += BFP_PROG_HEADER + n_steps;
+    }
+
+    // Filas de row_blocks bloques (la ultima puede quedar incompleta);
+    // en OP_*_BCAST es el periodo del tensor B. Una fila que no cabe en chip
+    // se rechaza: recortarla normalizaria con media/varianza parciales, y en
+    // BCAST repetiria B con el periodo equivocado
+    const bool rows_ok = !(norm_op || bcast_op) || row_blocks <= NORM_MAX_ROW_BLOCKS;
+    const unsigned int rb = (row_blocks == 0) ? 1
+                          : (row_blocks > NORM_MAX_ROW_BLOCKS) ? NORM_MAX_ROW_BLOCKS : row_blocks;
+    float gamma[NORM_MAX_ROW_BLOCKS * N_MAX], beta[NORM_MAX_ROW_BLOCKS * N_MAX];
+    unsigned int row_start = 0;
+
+    if (norm_op && rows_ok) {
+        mark_phase(phase, BFP_PHASE_LOAD);
+        load_norm_params(in_fp32, in_fp32_b, rms, rb * bs, gamma, beta);
+        mem_words += (rms ? 1 : 2) * rb * bs;
+    }
+
+    // Operando B constante: escalar replicado en todos los lanes, codificado una vez
+    blk_t B_const = blk_t::zero();
+    if (scalar_op) {
+        B_const = encode_scalar(scalar_b, st);
+    }
+
+    // Operando B por broadcast: rb bloques leidos una vez y reusados en chip
+    // (tensor propio de rb bloques: en planar sus planos van cada rb palabras)
+    blk_t B_cache[NORM_MAX_ROW_BLOCKS];
+    unsigned int b_idx = 0;
+    if (bcast_op && rows_ok) {
+        const bfp_layout_t LB = {planar, rb, bs};
+        mark_phase(phase, BFP_PHASE_LOAD);
+    LOAD_BCAST:
+        for (unsigned int b = 0; b < rb; b++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=4
+            unpack_bfp_block(in_bfp_b, B_cache[b], LB, b, bs);
+        }
+        mem_words += rb * block_words(LB, bs);
+    }
+
+    // Main processing loop: un bloque por iteracion en OP_PROGRAM / norm,
+    // Lanes bloques (un grupo) en el modo directo
+    // (programa invalido o fila demasiado larga: ningun bloque)
+    const unsigned int blk_step = (opcode == OP_PROGRAM || norm_op) ? 1 : Lanes;
+    const bool launch_ok = (opcode != OP_PROGRAM || prog_ok) && rows_ok;
+    const unsigned int n_run = launch_ok ? n_used : 0;
+    process_blocks: for (unsigned int blk_idx = 0; blk_idx < n_run; blk_idx += blk_step) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=128 avg=32
+       
+        const unsigned int fp32_offset = blk_idx * bs;
+        const unsigned int lanes = block_lanes(total, blk_idx, bs);
+        st.lane_limit = lanes;
+
+        if (opcode == OP_PROGRAM) {
+            run_program_block(steps, n_steps, out_slot, uses_a, uses_b, uses_fp32, in_place,
+                              in_fp32, in_bfp_a, in_bfp_b, out_fp32, out_bfp,
+                              L, fp32_offset, blk_idx, lanes, st, rng, phase, mem_words);
+            continue;
+        }
+
+        if (norm_op) {
+            if (blk_idx == row_start) {
+                const unsigned int len = (n_used - row_start < rb) ? (n_used - row_start) : rb;
+                const unsigned int elems = (total - fp32_offset < len * bs) ? (total - fp32_offset)
+                                                                            : len * bs;
+                run_norm_row(rms, row_start, len, elems, L, gamma, beta, in_place, in_bfp_a, out_bfp,
+                             st, rng, phase, mem_words);
+                row_start += rb;
+            }
+            continue;
+        }
+
+        // Grupo de Lanes bloques: la copia c procesa el bloque blk_idx + c
+        blk_t A[Lanes], B[Lanes], Z[Lanes];
+        std::array<float, N_MAX> fp_in[Lanes] = {}, fp_out[Lanes] = {}, fp_b[Lanes] = {};
+#pragma HLS ARRAY_PARTITION variable=A complete dim=1
+#pragma HLS ARRAY_PARTITION variable=B complete dim=1
+#pragma HLS ARRAY_PARTITION variable=Z complete dim=1
+#pragma HLS ARRAY_PARTITION variable=fp_in complete dim=1
+#pragma HLS ARRAY_PARTITION variable=fp_out complete dim=1
+#pragma HLS ARRAY_PARTITION variable=fp_b complete dim=1
+        const unsigned int group = (n_used - blk_idx < Lanes) ? (n_used - blk_idx) : Lanes;
+
+        //=====================================================================
+        // PHASE 1: LOAD DATA (los bloques del grupo, uno tras otro)
+        //=====================================================================
+        mark_phase(phase, BFP_PHASE_LOAD);
+
+    LOAD_GROUP:
+        for (unsigned int c = 0; c < group; c++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=8 avg=4
+            const unsigned int idx = blk_idx + c;
+            const unsigned int offset = idx * bs;
+            const unsigned int n = block_lanes(total, idx, bs);
+            A[c] = blk_t::zero();
+            B[c] = blk_t::zero();
+            Z[c] = blk_t::zero();
+
+            if (fused_f32) {
+                // Fused mode: raw FP32 A/B, encoded in the compute phase
+                if (alu_op != OP_RCP) {
+                    if (in_place) {
+                        load_fp32_block(out_fp32, fp_in[c], offset, n);
+                    } else {
+                        load_fp32_block(in_fp32, fp_in[c], offset, n);
+                    }
+                    mem_words += n;
+                }
+                load_fp32_block(in_fp32_b, fp_b[c], offset, n);
+                mem_words += n;
+
+            } else if (mixed_op) {
+                // Mixed mode: A in BFP, raw FP32 B (encoded in the compute phase)
+                load_a_block(in_place, in_bfp_a, out_bfp, A[c], L, idx, n);
+                load_fp32_block(in_fp32, fp_b[c], offset, n);
+                mem_words += block_words(L, n) + n;
+
+            } else if (opcode == OP_ENCODE) {
+                // Load FP32 for encoding
+                load_fp32_block(in_fp32, fp_in[c], offset, n);
+                mem_words += n;
+
+            } else if (opcode == OP_DECODE || (opcode >= OP_GELU && opcode <= OP_EXP)) {
+
+                // Load BFP A for decoding / activations
+                load_a_block(in_place, in_bfp_a, out_bfp, A[c], L, idx, n);
+                mem_words += block_words(L, n);
+
+            } else if (scalar_op || bcast_op) {
+
+                // Load only A; B is on chip (scalar or cached broadcast block)
+                load_a_block(in_place, in_bfp_a, out_bfp, A[c], L, idx, n);
+                mem_words += block_words(L, n);
+                if (scalar_op) {
+                    B[c] = B_const;
+                } else {
+                    B[c] = B_cache[b_idx];
+                    fill_tail_lanes(B[c], n);
+                    b_idx = (b_idx + 1 == rb) ? 0 : b_idx + 1;
+                }
+
+            } else if (opcode == OP_RCP) {
+
+                // Load only B for reciprocal
+                unpack_bfp_block(in_bfp_b, B[c], L, idx, n);
+                mem_words += block_words(L, n);
+
+            } else {
+                // Binary operations: Load both A and B
+                load_a_block(in_place, in_bfp_a, out_bfp, A[c], L, idx, n);
+                unpack_bfp_block(in_bfp_b, B[c], L, idx, n);
+                mem_words += 2 * block_words(L, n);
+            }
+        }
+
+        //=====================================================================
+        // PHASE 2: COMPUTE (Lanes copias en paralelo)
+        //=====================================================================
+        mark_phase(phase, BFP_PHASE_COMPUTE);
+
+    COMPUTE_GROUP:
+        for (unsigned int c = 0; c < Lanes; c++) {
+#pragma HLS UNROLL
+            if (c < group) {
+                st_lane[c].lane_limit = block_lanes(total, blk_idx + c, bs);
+                compute_lane(alu_op, fused_f32, mixed_op, store_fp32, A[c], B[c],
+                             fp_in[c], fp_b[c], Z[c], fp_out[c], st_lane[c], rng_lane[c]);
+            }
+        }
+
+        //=====================================================================
+        // PHASE 3: STORE RESULTS
+        //=====================================================================
+        mark_phase(phase, BFP_PHASE_STORE);
+
+    STORE_GROUP:
+        for (unsigned int c = 0; c < group; c++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=8 avg=4
+            const unsigned int idx = blk_idx + c;
+            const unsigned int n = block_lanes(total, idx, bs);
+
+            if (store_fp32) {
+                // Write FP32 output (valid lanes only)
+                store_fp32_block(fp_out[c], out_fp32, idx * bs, n);
+                mem_words += n;
+
+            } else {
+                // Write BFP output (valid lanes only)
+                pack_bfp_block(Z[c], out_bfp, L, idx, n);
+                mem_words += block_words(L, n);
+            }
+        }
+    }
+
+    // Contadores de las copias 1..Lanes-1 sobre los de la copia 0
+MERGE_LANE_STATS:
+    for (unsigned int c = 1; c < Lanes; c++) {
+#pragma HLS UNROLL
+        st.merge(st_lane[c]);
+    }
+
+    mark_phase(phase, BFP_PHASE_STORE);
+    write_stats(st, stats);
+    mem_words += BFP_STATS_WORDS;
+
+    mark_phase(phase, BFP_PHASE_END);
+    phase.write(mem_words);
+}
+
+//=============================================================================
+// MONITOR: contador libre de ciclos por fase. Cada iteracion del bucle con
+// II=1 es un ciclo; la fase actual cambia al llegar un evento (read_nb no
+// bloquea, asi el contador nunca se detiene). Los ciclos de la fase actual se
+// cuentan en un registro (run) y se suman a cycles[] solo al cambiar de fase:
+// el incremento de cada ciclo no lee ni escribe el array.
+//=============================================================================
+void profile_monitor(phase_stream_t& phase,
+                     const unsigned int n_blocks,
+                     unsigned long long* profile) {
+#pragma HLS INLINE off
+
+    unsigned long long cycles[4] = {0, 0, 0, 0};
+#pragma HLS ARRAY_PARTITION variable=cycles complete
+
+    unsigned int current = BFP_PHASE_OTHER;
+    unsigned long long run = 0;     // Ciclos de 'current' aun no sumados a cycles[]
+    bool done = false;
+
+MONITOR_CYCLES:
+    while (!done) {
+#pragma HLS PIPELINE II=1
+        unsigned int ev;
+        unsigned int next = current;
+        if (phase.read_nb(ev)) {
+            if (ev == BFP_PHASE_END) {
+                done = true;
+            } else {
+                next = ev & 0x3;
+            }
+        }
+        if (next != current) {
+            cycles[current] += run;
+            current = next;
+            run = 1;                // Este ciclo ya es de la fase nueva
+        } else {
+            run++;
+        }
+    }
+    cycles[current] += run;
+
+    const unsigned long long mem_words = phase.read();
+    const unsigned long long mem_cycles = cycles[BFP_PHASE_LOAD] + cycles[BFP_PHASE_STORE];
+    const unsigned long long total = cycles[0] + cycles[1] + cycles[2] + cycles[3];
+
+    profile[0] = total;
+    profile[1] = cycles[BFP_PHASE_LOAD];
+    profile[2] = cycles[BFP_PHASE_COMPUTE];
+    profile[3] = cycles[BFP_PHASE_STORE];
+    profile[4] = (mem_cycles > mem_words) ? mem_cycles - mem_words : 0;
+    profile[5] = cycles[BFP_PHASE_OTHER];
+    profile[6] = mem_words;
+    profile[7] = n_blocks;
+}
+
+//=============================================================================
+// MAIN KERNEL - bfp_process (secuencial) + profile_monitor en DATAFLOW
 //=============================================================================
 extern "C" {
 
@@ -69,7 +1092,7 @@ void bfp_kernel(
     // Control
     const unsigned int operation,
     const unsigned int n_blocks,
-    // Input FP32
+    // Input FP32 (B for the mixed *_MIX operations)
     const float* in_fp32,
     // Input/Output BFP
     const unsigned int* in_bfp_a,     // Vector compacto A
@@ -77,7 +1100,25 @@ void bfp_kernel(
     // Output fp32 for decode
     float* out_fp32,
     // Output BFP
-    unsigned int* out_bfp
+    unsigned int* out_bfp,
+    // Command list for OP_PROGRAM
+    const unsigned int* program,
+    // Input FP32 B for the fused *_F32 operations
+    const float* in_fp32_b,
+    // Numeric health counters (BFP_STATS_WORDS words)
+    unsigned int* stats,
+    // Cycle profile (BFP_PROFILE_WORDS x 64 bits)
+    unsigned long long* profile,
+    // Blocks per row for OP_LAYERNORM / OP_RMSNORM, B period for OP_*_BCAST
+    const unsigned int row_blocks,
+    // Operand B for OP_*_SCALAR
+    const float scalar_b,
+    // Valid elements (0 = n_blocks * block_size); the last block may be partial
+    const unsigned int n_elements,
+    // Lanes per block: 4, 8, 16, 32 or 64 (0 = N)
+    const unsigned int block_size,
+    // Seed of the per-lane LFSRs (stochastic rounding, ROUND_MODE = BFP_RND_STOCH)
+    const unsigned int seed
 
 ) {
     // FP32 I/O
@@ -85,6 +1126,7 @@ void bfp_kernel(
         max_read_burst_length=16 num_read_outstanding=4
     
     #pragma HLS INTERFACE m_axi port=out_fp32 offset=slave bundle=gmem0 \
+        max_read_burst_length=16 num_read_outstanding=4 \
         max_write_burst_length=16 num_write_outstanding=4
 
     // BFP Input A 
@@ -95,108 +1137,45 @@ void bfp_kernel(
     #pragma HLS INTERFACE m_axi port=in_bfp_b offset=slave bundle=gmem1 \
         max_read_burst_length=64 num_read_outstanding=4
 
-    // BFP Output 
+    // BFP Output (also read as A in OP_IN_PLACE)
     #pragma HLS INTERFACE m_axi port=out_bfp offset=slave bundle=gmem2 \
+        max_read_burst_length=64 num_read_outstanding=4 \
         max_write_burst_length=64 num_write_outstanding=4
 
+    // Command list (small, read once per launch)
+    #pragma HLS INTERFACE m_axi port=program offset=slave bundle=gmem1 \
+        max_read_burst_length=16 num_read_outstanding=1
+
+    // FP32 Input B (fused mode), own bundle so A and B stream in parallel
+    #pragma HLS INTERFACE m_axi port=in_fp32_b offset=slave bundle=gmem3 \
+        max_read_burst_length=16 num_read_outstanding=4
+
+    // Stats (written once at the end of the launch)
+    #pragma HLS INTERFACE m_axi port=stats offset=slave bundle=gmem2 \
+        max_write_burst_length=64 num_write_outstanding=1
+
+    // Profile (written once at the end of the launch, by profile_monitor)
+    #pragma HLS INTERFACE m_axi port=profile offset=slave bundle=gmem4 \
+        max_write_burst_length=8 num_write_outstanding=1
+
     // Interface pragmas
     #pragma HLS INTERFACE s_axilite port=operation 
     #pragma HLS INTERFACE s_axilite port=n_blocks 
+    #pragma HLS INTERFACE s_axilite port=row_blocks
+    #pragma HLS INTERFACE s_axilite port=scalar_b
+    #pragma HLS INTERFACE s_axilite port=n_elements
+    #pragma HLS INTERFACE s_axilite port=block_size
+    #pragma HLS INTERFACE s_axilite port=seed
     #pragma HLS INTERFACE s_axilite port=return
 
-    // Main processing loop - Simplified sequential design
-    process_blocks: for (unsigned int blk_idx = 0; blk_idx < n_blocks; blk_idx++) {
-#pragma HLS LOOP_TRIPCOUNT min=1 max=128 avg=32
-       
-        const unsigned int fp32_offset = blk_idx * N;
-        const unsigned int bfp_offset = blk_idx * BFP_BLOCK_SIZE;
-
-        blk_t A{}, B{}, Z{};
-        std::array<float, N> fp_in{}, fp_out{};
-        
-        //=====================================================================
-        // PHASE 1: LOAD DATA
-        //=====================================================================
-        if (operation == OP_ENCODE) {
-            // Load FP32 for encoding
-        load_fp32: 
-            for (int i = 0; i < N; i++) {
-#pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-                fp_in[i] = in_fp32[fp32_offset + i];
-            }
-            
-        } else if (operation == OP_DECODE) {
+    phase_stream_t phase("phase");
+#pragma HLS STREAM variable=phase depth=16
 
-            // Load BFP A for decoding
-            unpack_bfp_block(in_bfp_a, A, bfp_offset);
-           
-            
-        } else if (operation == OP_RCP) {
-
-            // Load only B for reciprocal
-            unpack_bfp_block(in_bfp_b, B, bfp_offset);
-            
-        } else {
-            // Binary operations: Load both A and B
-            unpack_bfp_block(in_bfp_a, A, bfp_offset);
-            unpack_bfp_block(in_bfp_b, B, bfp_offset);
-        }
-        
-        //=====================================================================
-        // PHASE 2: COMPUTE
-        //=====================================================================
-        switch (operation) {
-            case OP_ENCODE:
-                Z = encode_block<Cfg, N>(fp_in);
-                break;
-                
-            case OP_DECODE:
-                fp_out = decode_block<Cfg, N>(A);
-                break;
-                
-            case OP_ADD:
-                Z = add_blocks<Cfg, N>(A, B);
-                break;
-                
-            case OP_SUB:
-                Z = sub_blocks<Cfg, N>(A, B);
-                break;
-                
-            case OP_MUL:
-                Z = mul_blocks<Cfg, N>(A, B);
-                break;
-                
-            case OP_DIV:
-                Z = div_blocks<Cfg, N>(A, B);
-                break;
-                
-            case OP_RCP:
-                Z = rcp_blocks<Cfg, N>(B);
-                break;
-                
-            default:
-                Z = A;
-                break;
-        }
-        
-        //=====================================================================
-        // PHASE 3: STORE RESULTS
-        //=====================================================================
-        if (operation == OP_DECODE) {
-            // Write FP32 output
-        store_fp32: 
-            for (int i = 0; i < N; i++) {
-#pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-                out_fp32[fp32_offset + i] = fp_out[i];
-            }
-            
-        } else {
-            // Write BFP output
-            pack_bfp_block(Z, out_bfp, bfp_offset);
-        }
-    }
+#pragma HLS DATAFLOW
+    bfp_process<LANES>(operation, n_blocks, in_fp32, in_bfp_a, in_bfp_b, out_fp32, out_bfp,
+                       program, in_fp32_b, stats, row_blocks, scalar_b, n_elements, block_size, seed,
+                       phase);
+    profile_monitor(phase, n_blocks, profile);
 }
 
 } // extern "C"
@@ -0,0 +1,70 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_stream_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+//=============================================================================
+// BFP_MM2S - Lector de borde: HBM -> AXI-Stream (un bloque por beat)
+//   mode = BFP_STREAM_FP32    : lee N floats por bloque (entrada de encode_s)
+//   mode = BFP_STREAM_COMPACT : lee el formato compacto 1 + 2*N de bfp_kernel
+//=============================================================================
+extern "C" {
+
+void bfp_mm2s(
+    const unsigned int* in,
+    bfp_stream_t& out_blk,
+    const unsigned int mode,
+    const unsigned int n_blocks
+) {
+    #pragma HLS INTERFACE m_axi port=in offset=slave bundle=gmem0 \
+        max_read_burst_length=64 num_read_outstanding=4
+    #pragma HLS INTERFACE axis port=out_blk
+
+    #pragma HLS INTERFACE s_axilite port=mode
+    #pragma HLS INTERFACE s_axilite port=n_blocks
+    #pragma HLS INTERFACE s_axilite port=return
+
+    read_blocks: for (unsigned int blk_idx = 0; blk_idx < n_blocks; blk_idx++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=128 avg=32
+
+        if (mode == BFP_STREAM_COMPACT) {
+            const unsigned int offset = blk_idx * BFP_BLOCK_SIZE;
+            blk_t blk = blk_t::zero();
+            blk.set_exp_word(in[offset]);
+
+        read_compact:
+            for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=2
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+                blk.sign[i]  = in[offset + 1 + 2 * i];
+                blk.mant[i]  = in[offset + 2 + 2 * i];
+            }
+            out_blk.write(bfp_to_word<Cfg, N>(blk));
+
+        } else {
+            const unsigned int offset = blk_idx * N;
+            std::array<float, N> xs{};
+
+        read_fp32:
+            for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+                union {uint32_t u; float f;} c;
+                c.u = in[offset + i];
+                xs[i] = c.f;
+            }
+            out_blk.write(fp32_to_word<N>(xs));
+        }
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,146 @@
+#ifndef BFP_NORM_HLS_H
+#define BFP_NORM_HLS_H
+
+#include <cmath>
+#include <cstdint>
+#include "bfp_hls.h"
+
+//*============================================================================
+//* LAYERNORM / RMSNORM POR FILAS SOBRE BLOQUES BFP
+//*
+//* Una fila son row_blocks bloques consecutivos. Cada lane se alinea al
+//* exponente compartido maximo de la fila (Emax) con NORM_GUARD bits extra:
+//*   s_i  = mant_i * 2^(G - d_i)      x_i   = s_i  * U,  U = 2^(Emax - bias - wm - G)
+//*   sq_i = mant_i^2 * 2^(G - 2 d_i)  x_i^2 = sq_i * V,  V = 2^G * U^2
+//* con d_i = Emax - E_bloque. Media y varianza salen de sumas enteras (int64);
+//* 1/sqrt usa tabla + un paso de Newton en Q16, y como sqrt(V) = 2^(G/2) * U
+//* la escala U se cancela:  (x_i - mean) / std = (s_i - mean_q) * y * 2^-(16 + e/2 + G/2)
+//*============================================================================
+static constexpr int NORM_GUARD = 20;          // par: G/2 entero
+static constexpr int NORM_RSQRT_FRAC = 16;     // y en Q16
+
+// 1/sqrt(m) en el punto medio de cada tramo de 1/16 de m en [1, 4), Q16
+static const uint32_t NORM_RSQRT_TABLE[48] = {
+    64535, 62664, 60947, 59364, 57898, 56535, 55265, 54076,
+    52961, 51912, 50923, 49989, 49104, 48265, 47467, 46707,
+    45983, 45292, 44630, 43997, 43390, 42808, 42248, 41710,
+    41192, 40693, 40211, 39746, 39297, 38863, 38443, 38036,
+    37642, 37260, 36889, 36529, 36179, 35840, 35509, 35188,
+    34875, 34571, 34274, 33985, 33703, 33427, 33159, 32897,
+};
+
+//*============================================================================
+//* 1/sqrt(v), v > 0 entero:  v = m * 2^e con m en [1, 4) y e par
+//* Devuelve y (Q16) y e:  1/sqrt(v) = y * 2^-(16 + e/2)
+//*============================================================================
+static inline void bfp_rsqrt_q16(uint64_t v, uint32_t& y, int& e) {
+#pragma HLS INLINE
+    int p = 63;
+RSQRT_MSB:
+    while (p > 0 && !((v >> p) & 1u)) p--;
+    e = p & ~1;
+
+    // m en Q16, [2^16, 2^18)
+    const uint64_t m = (e >= NORM_RSQRT_FRAC) ? (v >> (e - NORM_RSQRT_FRAC))
+                                              : (v << (NORM_RSQRT_FRAC - e));
+    const uint64_t y0 = NORM_RSQRT_TABLE[(m >> (NORM_RSQRT_FRAC - 4)) - 16];
+
+    // Newton:  y1 = y0 * (3 - m * y0^2) / 2
+    const uint64_t my2 = (m * ((y0 * y0) >> NORM_RSQRT_FRAC)) >> NORM_RSQRT_FRAC;
+    const int64_t  t   = (int64_t(3) << NORM_RSQRT_FRAC) - int64_t(my2);
+    y = uint32_t((int64_t(y0) * t) >> (NORM_RSQRT_FRAC + 1));
+}
+
+//*============================================================================
+//* NORMALIZA UNA FILA: out = (x - mean) / sqrt(var + eps) * gamma + beta
+//* rms = true: RMSNorm, sin media ni beta:  out = x / sqrt(mean(x^2) + eps) * gamma
+//* n_valid: canales validos de la fila; los lanes c >= n_valid (bloque final
+//* parcial) no entran en las sumas y salen a cero
+//* bs: lanes usados por bloque (<= Block_size); el canal del lane l del bloque
+//* b es c = b * bs + l y los lanes l >= bs se tratan como invalidos
+//*============================================================================
+template<class Cfg, std::size_t Block_size, int MaxBlocks>
+void bfp_norm_row(const BFP_Global<Cfg, Block_size> row[MaxBlocks],
+                  unsigned int row_blocks,
+                  unsigned int n_valid,
+                  unsigned int bs,
+                  const float gamma[MaxBlocks * Block_size],
+                  const float beta[MaxBlocks * Block_size],
+                  bool rms,
+                  float eps,
+                  BFP_Global<Cfg, Block_size> out[MaxBlocks],
+                  BFP_Stats<Cfg>& st,
+                  BFP_Lfsr& rng) {
+#pragma HLS INLINE off
+    constexpr int G = NORM_GUARD;
+
+    //=========================================================================
+    // 1) Exponente maximo de la fila
+    //=========================================================================
+    int Emax = 0;
+NORM_EMAX:
+    for (unsigned int b = 0; b < row_blocks; b++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        if (int(row[b].exp_shared) > Emax) Emax = int(row[b].exp_shared);
+    }
+
+    //=========================================================================
+    // 2) Sumas enteras de x y x^2 alineadas a Emax
+    //=========================================================================
+    int64_t S = 0, SQ = 0;
+NORM_SUMS:
+    for (unsigned int b = 0; b < row_blocks; b++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        const int d = Emax - int(row[b].exp_shared);
+        for (std::size_t l = 0; l < Block_size; l++) {
+#pragma HLS PIPELINE II=1
+            if (l >= bs || b * bs + l >= n_valid) continue;
+            const int64_t m  = row[b].mant[l];
+            const int64_t s  = (d > G + Cfg::wm + 1) ? 0 : ((m << G) >> d);
+            const int64_t sq = (2 * d > G + 2 * Cfg::wm + 2) ? 0 : (((m * m) << G) >> (2 * d));
+            S  += row[b].sign[l] ? -s : s;
+            SQ += sq;
+        }
+    }
+
+    const int64_t n = int64_t(n_valid);
+    const int64_t mean_q = rms ? 0 : S / n;
+    int64_t var_q = SQ / n - ((mean_q * mean_q) >> G);
+    if (var_q < 0) var_q = 0;
+
+    // eps en unidades de V = 2^(2 (Emax - bias - wm) - G)
+    const float eps_v = std::ldexp(eps, G - 2 * (Emax - Cfg::bias_bfp - Cfg::wm));
+    var_q += (eps_v >= 4.0e18f) ? int64_t(4000000000000000000LL) : int64_t(eps_v);
+
+    //=========================================================================
+    // 3) 1 / sqrt(var + eps)
+    //=========================================================================
+    uint32_t y = 0;
+    int e = 0;
+    if (var_q > 0) bfp_rsqrt_q16(uint64_t(var_q), y, e);
+    const int out_shift = -(NORM_RSQRT_FRAC + e / 2 + G / 2);
+
+    //=========================================================================
+    // 4) Escala y desplazamiento por canal, re-codificacion por bloque
+    //=========================================================================
+NORM_OUT:
+    for (unsigned int b = 0; b < row_blocks; b++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=16
+        const int d = Emax - int(row[b].exp_shared);
+        std::array<float, Block_size> ys{};
+        for (std::size_t l = 0; l < Block_size; l++) {
+#pragma HLS PIPELINE II=1
+            const int64_t m = row[b].mant[l];
+            int64_t s = (d > G + Cfg::wm + 1) ? 0 : ((m << G) >> d);
+            if (row[b].sign[l]) s = -s;
+            const float xn = std::ldexp(float((s - mean_q) * int64_t(y)), out_shift);
+            const unsigned int c = b * bs + l;
+            ys[l] = (l >= bs || c >= n_valid) ? 0.0f : rms ? xn * gamma[c] : xn * gamma[c] + beta[c];
+        }
+        out[b] = encode_block<Cfg, Block_size>(ys, st, rng);
+        st.template record_block<Block_size>(out[b]);
+    }
+}
+
+#endif // BFP_NORM_HLS_H
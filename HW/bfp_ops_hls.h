@@ -11,106 +11,165 @@
 //* HELPER: CLAMP EXPONENTE A RANGO VALIDO
 //*============================================================================
 template<class Cfg>
-static inline uint32_t clamp_exponent(int E_real) {
+static inline typename Cfg::exp_t clamp_exponent(int E_real) {
 #pragma HLS INLINE
     int E_biased = E_real + Cfg::bias_bfp;
     if (E_biased < 0) E_biased = 0;
     if (E_biased > (1 << Cfg::we) - 1) E_biased = (1 << Cfg::we) - 1;
-    return uint32_t(E_biased);
+    return typename Cfg::exp_t(E_biased);
 }
 
 //*============================================================================
-//* HELPER: CALCULAR DELTA DESDE MANTISA
-//* Delta = WM - posición_MSB
+//* NORMALIZACION GLOBAL DEL BLOQUE (semantica de C++/bfp_ops.h)
+//* - Overflow en algun lane: E+1 y mantisas / 2 (redondeo Cfg::rnd)
+//* - Si no, "llenado": desplaza a la izquierda hasta que la mayor mantisa
+//*   tenga su MSB en WM (E baja en la misma cantidad)
+//* Los lanes especiales (NaN/Inf) no participan. Devuelve false si el bloque
+//* queda todo a cero.
 //*============================================================================
-template<class Cfg>
-static inline uint32_t calculate_delta_from_mant(uint32_t mant) {
+template<class Cfg, std::size_t Block_size>
+static inline bool normalize_block(std::array<typename Cfg::sum_t, Block_size>& Mag,
+                                   std::array<typename Cfg::sign_t, Block_size>& Sgn,
+                                   const std::array<bool, Block_size>& special,
+                                   int& E,
+                                   BFP_Stats<Cfg>& st,
+                                   BFP_Lfsr& rng) {
 #pragma HLS INLINE
-    
-    if (mant == 0) return 0;
-    
-    // Encontrar el bit más significativo (MSB)
-    int msb_pos = -1;
-    
-    #pragma HLS UNROLL factor=8
+    const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1u;
+
+    bool overflow_any = false;
+    typename Cfg::sum_t max_mag = 0;
+FIND_MAX_MAG:
+    for (std::size_t i = 0; i < Block_size; ++i) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+        if (special[i]) continue;
+        if (Mag[i] > mant_max) overflow_any = true;
+        if (Mag[i] > max_mag) max_mag = Mag[i];
+    }
+
+    if (overflow_any) {
+        ++E;
+NORMALIZE_OVERFLOW:
+        for (std::size_t i = 0; i < Block_size; ++i) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+            if (special[i]) continue;
+            uint32_t m = helper_round<Cfg>(Mag[i], 1, rng, i);
+            if (m > mant_max) {
+                m = mant_max;
+                st.mant_sat += st.lane_on(i);
+            }
+            if (m == 0u && Mag[i] != 0u) st.flush_zero += st.lane_on(i);
+            Mag[i] = m;
+            if (m == 0u) Sgn[i] = 0;
+        }
+        return true;
+    }
+
+    if (max_mag == 0u) return false;
+
+    int msb = 0;
+FIND_MSB:
     for (int b = Cfg::wm; b >= 0; --b) {
-        if ((mant >> b) & 0x1) {
-            msb_pos = b;
-            break;
+#pragma HLS UNROLL
+        if ((max_mag >> b) & 0x1u) { msb = b; break; }
+    }
+    const int shl = Cfg::wm - msb;
+    if (shl > 0) {
+        E -= shl;
+NORMALIZE_FILL:
+        for (std::size_t i = 0; i < Block_size; ++i) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+            if (special[i]) continue;
+            Mag[i] = Mag[i] << shl;   // max_mag << shl <= mant_max: no satura
         }
     }
-    
-    if (msb_pos < 0) return 0;
-    
-    // Delta = cuántos bits "perdidos" desde la precisión completa
-    int delta = Cfg::wm - msb_pos;
-    
-    return uint32_t(delta);
+    return true;
 }
 
 //*============================================================================
-//* SUMA DE BLOQUES BFP: Z = A + B
-//* - Alinea mantissas según diferencia de exponentes
-//* - Suma con signo (complemento a 2)
-//* - Normaliza si hay overflow
-//* USA DELTAS PARA DETERMINAR EXPONENTES REALES
+//* CONSTRUIR BLOQUE DE SALIDA: exponente, signos, mantisas y flag especial
+//* Con NaN/Inf el exponente es el maximo (mismo criterio que encode_block) y
+//* los lanes finitos se realinean a el.
 //*============================================================================
 template<class Cfg, std::size_t Block_size>
-BFP_Global<Cfg, Block_size> add_blocks(
-    const BFP_Global<Cfg, Block_size>& A,
-    const BFP_Global<Cfg, Block_size>& B
-) {
-#pragma HLS INLINE off
-    
-    BFP_Global<Cfg, Block_size> Z{};
-    
-    //*========================================================================
-    //* FASE 1: DETERMINAR EXPONENTE REALES DE LOS BLOQUES
-    //*========================================================================
-    int Ea_shared = int(A.exp_shared) - Cfg::bias_bfp;
-    int Eb_shared = int(B.exp_shared) - Cfg::bias_bfp;
-    
-    //*========================================================================
-    //* FASE 2: ENCONTRAR EXP MAX CONSIDERANDO DELTAS
-    //*========================================================================
-    int Emax = std::numeric_limits<int>::min();
+static inline void finish_block(BFP_Global<Cfg, Block_size>& Z,
+                                const std::array<typename Cfg::sum_t, Block_size>& Mag,
+                                const std::array<typename Cfg::sign_t, Block_size>& Sgn,
+                                const std::array<bool, Block_size>& special,
+                                bool any_finite, int E,
+                                BFP_Stats<Cfg>& st) {
+#pragma HLS INLINE
+    const int E_special = (1 << Cfg::we) - 1 - Cfg::bias_bfp;
+
+    bool any_special = false;
+FIND_SPECIAL:
+    for (std::size_t i = 0; i < Block_size; ++i) {
+#pragma HLS UNROLL
+        if (special[i]) any_special = true;
+    }
+    const int shift = (any_special && E < E_special) ? E_special - E : 0;
 
-FIND_EMAX:
+COPY_LANES:
     for (std::size_t i = 0; i < Block_size; ++i) {
 #pragma HLS PIPELINE II=1
 #pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-        
-        // Exponente real de elemento i en A
-        if (A.mant[i] != 0u) {
-            int exp_A_i = Ea_shared - int(A.delta[i]);
-            if (exp_A_i > Emax) Emax = exp_A_i;
-        }
-        
-        // Exponente real de elemento i en B
-        if (B.mant[i] != 0u) {
-            int exp_B_i = Eb_shared - int(B.delta[i]);
-            if (exp_B_i > Emax) Emax = exp_B_i;
+        uint32_t m = uint32_t(Mag[i]);
+        if (!special[i] && shift > 0) {
+            m = bfp_round_shr<typename Cfg::round>(m, shift);
+            if (m == 0u && Mag[i] != 0u) st.flush_zero += st.lane_on(i);
         }
+        Z.mant[i] = m;
+        Z.sign[i] = (m == 0u) ? typename Cfg::sign_t(0) : Sgn[i];
     }
-    
-    if (Emax == std::numeric_limits<int>::min()) {
-        //[Todos ceros]
+
+    if (any_special) {
+        Z.exp_shared = (1u << Cfg::we) - 1u;   // exp_t a unos
+    } else if (any_finite) {
+        Z.exp_shared = clamp_exponent<Cfg>(E);
+        count_exp_clamp<Cfg>(E, st);
+    } else {
         Z.exp_shared = 0;
-        Z.sign.fill(0);
-        Z.mant.fill(0);
-        Z.delta.fill(0);
-        return Z;
     }
+    seal_special_lanes<Cfg, Block_size>(Z, special, st);
+}
+
+//*============================================================================
+//* SUMA DE BLOQUES BFP: Z = A + B
+//* - Alinea por diferencia de exponentes COMPARTIDOS (las mantisas ya estan
+//*   alineadas a su exponente dentro de cada bloque)
+//* - Suma con signo (complemento a 2)
+//* - Normaliza el bloque (overflow o llenado)
+//*============================================================================
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> add_blocks(
+    const BFP_Global<Cfg, Block_size>& A,
+    const BFP_Global<Cfg, Block_size>& B,
+    BFP_Stats<Cfg>& st,
+    BFP_Lfsr& rng
+) {
+#pragma HLS INLINE off
     
-    Z.exp_shared = clamp_exponent<Cfg>(Emax);
+    BFP_Global<Cfg, Block_size> Z = BFP_Global<Cfg, Block_size>::zero();
     const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1;
-
+    
     //*========================================================================
-    //* FASE 3: SUMA CON ALINEACION POR ELEMENTO USANDO DELTAS
+    //* FASE 1: EXPONENTE BASE ENTRE LOS EXPONENTES COMPARTIDOS
     //*========================================================================
+    const int Ea = int(A.exp_shared) - Cfg::bias_bfp;
+    const int Eb = int(B.exp_shared) - Cfg::bias_bfp;
+    const int E_base = (Ea > Eb) ? Ea : Eb;
+    const int shift_A = E_base - Ea;
+    const int shift_B = E_base - Eb;
 
-    bool overflow_flag = false;
-    std::array<uint32_t, Block_size> M_temp;
+    //*========================================================================
+    //* FASE 2: SUMA CON ALINEACION POR BLOQUE
+    //*========================================================================
+    std::array<typename Cfg::sum_t, Block_size> Mag;    // |Sa + Sb| <= 2 * mant_max
+    std::array<typename Cfg::sign_t, Block_size> Sgn;
+    std::array<bool, Block_size> special;
     
 ADD_ELEMENTS:
     for (std::size_t i = 0; i < Block_size; ++i) {
@@ -121,149 +180,50 @@ ADD_ELEMENTS:
         //* MANEJO DE CASOS ESPECIALES
         //*========================================================================
         // PROPAGACIÓN DE NaN/Inf
-        bool is_inf_A = (A.mant[i] == mant_max) && (A.delta[i] == 0);
-        bool is_inf_B = (B.mant[i] == mant_max) && (B.delta[i] == 0);
-        bool is_nan_A = (A.mant[i] == mant_max - 1) && (A.delta[i] == 0);
-        bool is_nan_B = (B.mant[i] == mant_max - 1) && (B.delta[i] == 0);
-        
-        // Si alguno es NaN, el resultado es NaN
-        if (is_nan_A || is_nan_B) {
-            Z.sign[i] = 0u;
-            M_temp[i] = mant_max - 1;  // NaN
+        const bool is_inf_A = A.is_inf(i);
+        const bool is_inf_B = B.is_inf(i);
+        const bool is_nan_A = A.is_nan(i);
+        const bool is_nan_B = B.is_nan(i);
+        special[i] = 1;
+        
+        // Si alguno es NaN, o Inf - Inf: NaN
+        if (is_nan_A || is_nan_B || (is_inf_A && is_inf_B && A.sign[i] != B.sign[i])) {
+            Sgn[i] = 0;
+            Mag[i] = mant_max - 1;
             continue;
         }
         
-        // Si ambos son Inf con signos opuestos: NaN
-        if (is_inf_A && is_inf_B) {
-            bool same_sign = (A.sign[i] == B.sign[i]);
-            if (!same_sign) {
-                Z.sign[i] = 0u;
-                M_temp[i] = mant_max - 1;  // Inf - Inf = NaN
-                continue;
-            } else {
-                Z.sign[i] = A.sign[i];
-                M_temp[i] = mant_max;  // Inf + Inf = Inf
-                continue;
-            }
-        }
-        
         // Si uno es Inf, el resultado es Inf
-        if (is_inf_A) {
-            Z.sign[i] = A.sign[i];
-            M_temp[i] = mant_max;
-            continue;
-        }
-        if (is_inf_B) {
-            Z.sign[i] = B.sign[i];
-            M_temp[i] = mant_max;
+        if (is_inf_A || is_inf_B) {
+            Sgn[i] = is_inf_A ? A.sign[i] : B.sign[i];
+            Mag[i] = mant_max;
             continue;
         }
-        //*========================================================================
-        //Unshift mantisas para recuperar valores completos
-        int delta_A_i = int(A.delta[i]);
-        int delta_B_i = int(B.delta[i]);
-        
-        uint32_t Ma_full = A.mant[i] << delta_A_i;
-        uint32_t Mb_full = B.mant[i] << delta_B_i;
+        special[i] = 0;
 
-        // Exponente real del elemento i en A y B
-        int exp_A_i = Ea_shared - delta_A_i;
-        int exp_B_i = Eb_shared - delta_B_i;
-        
-        // Shift necesario para alinear cada elemento a Emax
-        int shift_A = Emax - exp_A_i;
-        int shift_B = Emax - exp_B_i;
-        
-        // Alinear mantisas
-        uint32_t Ma = (shift_A > 0) ? helper_rne(Ma_full, shift_A) : Ma_full;
-        uint32_t Mb = (shift_B > 0) ? helper_rne(Mb_full, shift_B) : Mb_full;
-        
-        // Convertir a enteros con signo para la suma
-        int32_t Sa = A.sign[i] ? -int32_t(Ma) : int32_t(Ma);
-        int32_t Sb = B.sign[i] ? -int32_t(Mb) : int32_t(Mb);
-        int32_t S  = Sa + Sb;
-        
-        // Determinar signo y magnitud del resultado
-        uint32_t sign_res = (S < 0) ? 1u : 0u;
-        uint32_t Mag = uint32_t((S < 0) ? -S : S);
-        
-        if (Mag == 0u) {
-            sign_res = 0u;  // Evitar -0
-        }
-        
-        Z.sign[i] = sign_res;
-        M_temp[i] = Mag;
-        
-        if (M_temp[i] > mant_max) {
-            overflow_flag = true;
-        }
-    }
-    
-    //*========================================================================
-    //* FASE 4: NORMALIZAR SI HAY OVERFLOW
-    //*========================================================================
-    if (overflow_flag) {
-        Emax += 1;
-        Z.exp_shared = clamp_exponent<Cfg>(Emax);
-        
-NORMALIZE_OVERFLOW:
-        for (std::size_t i = 0; i < Block_size; ++i) {
-#pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-            
-            uint32_t M_adj = helper_rne(M_temp[i], 1);
-            if (M_adj > mant_max) {
-                M_adj = mant_max;
-            }
-            M_temp[i] = M_adj;
-            if (M_temp[i] == 0u) {
-                Z.sign[i] = 0u;
-            }
-        }
-    } else {
-        // Sin overflow, asegurar saturación
-SATURATE_MANT:
-        for (std::size_t i = 0; i < Block_size; ++i) {
-#pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-            
-            if (M_temp[i] > mant_max) {
-                M_temp[i] = mant_max;
-            }
-            if (M_temp[i] == 0u) {
-                Z.sign[i] = 0u;
-            }
-        }
+        //*========================================================================
+        // Alinear mantisas al exponente base
+        // (shift >= 0: el redondeo no pasa de mant_max, caben en WM+1 bits)
+        const typename Cfg::mant_t Ma = helper_round<Cfg>(A.mant[i], shift_A, rng, i);
+        const typename Cfg::mant_t Mb = helper_round<Cfg>(B.mant[i], shift_B, rng, i);
+        
+        // Convertir a enteros con signo para la suma (WM+3 bits)
+        typedef typename Cfg::ssum_t ssum_t;
+        const ssum_t Sa = A.sign[i] ? ssum_t(-ssum_t(Ma)) : ssum_t(Ma);
+        const ssum_t Sb = B.sign[i] ? ssum_t(-ssum_t(Mb)) : ssum_t(Mb);
+        const ssum_t S  = Sa + Sb;
+        
+        // Determinar signo y magnitud del resultado (sin -0)
+        Mag[i] = (S < 0) ? ssum_t(-S) : S;
+        Sgn[i] = (S < 0) ? 1 : 0;
     }
     
     //*========================================================================
-    //* FASE 5: COPIAR MANTISSAS FINALES Y CALCULO DE DELTAS
+    //* FASE 3: NORMALIZAR Y CONSTRUIR SALIDA
     //*========================================================================
-COPY_AND_SET_DELTA:
-    for (std::size_t i = 0; i < Block_size; ++i) {
-#pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-
-        Z.mant[i] = M_temp[i];
-        Z.delta[i] = calculate_delta_from_mant<Cfg>(M_temp[i]);
-
-    }
-    
-    // Si todos son cero, exponente = 0
-    bool all_zero = true;
-CHECK_ALL_ZERO:
-    for (std::size_t i = 0; i < Block_size; ++i) {
-#pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-        if (M_temp[i] != 0u) {
-            all_zero = false;
-        }
-    }
-    
-    if (all_zero) {
-        Z.exp_shared = 0;
-    }
-    
+    int E = E_base;
+    const bool any_finite = normalize_block<Cfg, Block_size>(Mag, Sgn, special, E, st, rng);
+    finish_block<Cfg, Block_size>(Z, Mag, Sgn, special, any_finite, E, st);
     return Z;
 }
 
@@ -274,7 +234,9 @@ CHECK_ALL_ZERO:
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size> sub_blocks(
     const BFP_Global<Cfg, Block_size>& A,
-    const BFP_Global<Cfg, Block_size>& B
+    const BFP_Global<Cfg, Block_size>& B,
+    BFP_Stats<Cfg>& st,
+    BFP_Lfsr& rng
 ) {
 #pragma HLS INLINE off
     
@@ -286,72 +248,49 @@ NEGATE_B:
 #pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
         
         if (Bneg.mant[i] == 0u) {
-            Bneg.sign[i] = 0u;
+            Bneg.sign[i] = 0;
         } else {
             Bneg.sign[i] = Bneg.sign[i] ^ 1u;  // Invertir signo
         }
     }
     
-    return add_blocks<Cfg, Block_size>(A, Bneg);
+    return add_blocks<Cfg, Block_size>(A, Bneg, st, rng);
 }
 
 //*============================================================================*/
 //* MULTIPLICACION DE BLOQUES BFP: Z = A * B                                   */
-//* - Usa exponentes reales (exp_shared - delta) de cada elemento              */
-//* - Mantissas: producto con RNE para reducir a WM bits                       */
+//* - Exponente del producto por bloque: Ea + Eb (sin exponentes por lane)    */
+//* - Mantissas: producto exacto y un unico redondeo a WM bits (Cfg::rnd),     */
+//*   tambien cuando el mayor producto redondea a 2^(WM+1)                     */
 //* - Signo: XOR                                                               */
-//* - Delta para salidas inline                                                */
+//* - Normalizacion global del bloque (overflow o llenado)                     */
 //*============================================================================*/
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size> mul_blocks(
     const BFP_Global<Cfg, Block_size>& A,
-    const BFP_Global<Cfg, Block_size>& B
+    const BFP_Global<Cfg, Block_size>& B,
+    BFP_Stats<Cfg>& st,
+    BFP_Lfsr& rng
 ) {
 #pragma HLS INLINE off
     
-    BFP_Global<Cfg, Block_size> Z{};
+    BFP_Global<Cfg, Block_size> Z = BFP_Global<Cfg, Block_size>::zero();
+    const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1u;
     
     //*========================================================================*/
-    //* FASE 1: CALCULAR EXPONENTES REALES DE BLOQUES                          */
+    //* FASE 1: EXPONENTE DEL PRODUCTO (CONSTANTE EN EL BLOQUE)                */
     //*========================================================================*/
-    int Ea_shared = int(A.exp_shared) - Cfg::bias_bfp;
-    int Eb_shared = int(B.exp_shared) - Cfg::bias_bfp;
-
-    //*========================================================================*/
-    //* FASE 2: ENCONTRAR EXPONENTE MÁXIMO DEL RESULTADO                       */
-    //*========================================================================*/
-    int Emax = std::numeric_limits<int>::min();
-
-FIND_EMAX_MUL:
-    for (std::size_t i = 0; i < Block_size; ++i) {
-#pragma HLS PIPELINE II=1
-#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-        
-        if (A.mant[i] != 0u && B.mant[i] != 0u) {
-            int exp_A_i = Ea_shared - int(A.delta[i]);
-            int exp_B_i = Eb_shared - int(B.delta[i]);
-            int exp_prod = exp_A_i + exp_B_i;
-            
-            if (exp_prod > Emax) {
-                Emax = exp_prod;
-            }
-        }
-    }
-    
-    if (Emax == std::numeric_limits<int>::min()) {
-        Z.exp_shared = 0;
-        Z.sign.fill(0);
-        Z.mant.fill(0);
-        Z.delta.fill(0);
-        return Z;
-    }
-    
-    Z.exp_shared = clamp_exponent<Cfg>(Emax);
-    const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1u;
+    const int Ea = int(A.exp_shared) - Cfg::bias_bfp;
+    const int Eb = int(B.exp_shared) - Cfg::bias_bfp;
 
     //*========================================================================*/
-    //* FASE 3: MULTIPLICACIÓN ELEMENTO POR ELEMENTO                           */
+    //* FASE 2: MULTIPLICACIÓN ELEMENTO POR ELEMENTO                           */
     //*========================================================================*/
+    std::array<typename Cfg::sum_t, Block_size> Mag;    // Producto a WM+1 bits (+ acarreo)
+    std::array<typename Cfg::sign_t, Block_size> Sgn;
+    std::array<bool, Block_size> special;
+    std::array<typename Cfg::prod_t, Block_size> P;
+    typename Cfg::prod_t max_P = 0;
     
 MUL_ELEMENTS:
     for (std::size_t i = 0; i < Block_size; i++) {
@@ -359,145 +298,112 @@ MUL_ELEMENTS:
 #pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
         
         // Signo = XOR
-        uint32_t sign = A.sign[i] ^ B.sign[i];
+        const typename Cfg::sign_t sign = A.sign[i] ^ B.sign[i];
 
         //*========================================================================
         //* MANEJO DE CASOS ESPECIALES
         //*========================================================================
         // PROPAGACIÓN DE NaN/Inf
-        bool is_inf_A = (A.mant[i] == mant_max) && (A.delta[i] == 0);
-        bool is_inf_B = (B.mant[i] == mant_max) && (B.delta[i] == 0);
-        bool is_nan_A = (A.mant[i] == mant_max - 1) && (A.delta[i] == 0);
-        bool is_nan_B = (B.mant[i] == mant_max - 1) && (B.delta[i] == 0);
-        bool is_zero_A = (A.mant[i] == 0u);
-        bool is_zero_B = (B.mant[i] == 0u);
-        
-        // Si alguno es NaN, resultado es NaN
-        if (is_nan_A || is_nan_B) {
-            Z.sign[i] = 0u;
-            Z.mant[i] = mant_max - 1;
-            Z.delta[i] = 0u;
-            continue;
-        }
-        
-        // Inf * 0 = NaN
-        if ((is_inf_A && is_zero_B) || (is_zero_A && is_inf_B)) {
-            Z.sign[i] = 0u;
-            Z.mant[i] = mant_max - 1;
-            Z.delta[i] = 0u;
+        const bool is_inf_A = A.is_inf(i);
+        const bool is_inf_B = B.is_inf(i);
+        const bool is_nan_A = A.is_nan(i);
+        const bool is_nan_B = B.is_nan(i);
+        const bool is_zero_A = (A.mant[i] == 0u);
+        const bool is_zero_B = (B.mant[i] == 0u);
+        special[i] = 1;
+        
+        // NaN o Inf * 0 = NaN
+        if (is_nan_A || is_nan_B || (is_inf_A && is_zero_B) || (is_zero_A && is_inf_B)) {
+            Sgn[i] = 0;
+            Mag[i] = mant_max - 1;
             continue;
         }
         
         // Inf * (no-cero) = Inf
         if (is_inf_A || is_inf_B) {
-            Z.sign[i] = sign;
-            Z.mant[i] = mant_max;
-            Z.delta[i] = 0u;
+            Sgn[i] = sign;
+            Mag[i] = mant_max;
             continue;
         }
+        special[i] = 0;
 
-        // Cero normal
-        if (is_zero_A || is_zero_B) {
-            Z.sign[i] = 0u;
-            Z.mant[i] = 0u;
-            Z.delta[i] = 0u;
-            continue;
-        }
         //*========================================================================
-        // Unshift las mantisas para recuperar valores completos
-        int delta_A_i = int(A.delta[i]);
-        int delta_B_i = int(B.delta[i]);
-        uint32_t Ma_full = A.mant[i] << delta_A_i;
-        uint32_t Mb_full = B.mant[i] << delta_B_i;
-        
-        // Producto de mantissas (64 bits para evitar overflow)
-        uint64_t P = uint64_t(Ma_full) * uint64_t(Mb_full);
-        
-        // Reducir a escala 2^(WM) con RNE
-        uint64_t q = P >> Cfg::wm;
-        uint64_t rem = P & ((uint64_t(1) << Cfg::wm) - 1);
-        uint64_t half = uint64_t(1) << (Cfg::wm - 1);
-        
-        bool tie = (rem == half);
-        bool gt = (rem > half);
-        bool lsb_odd = (q & 1u) != 0;
-        
-        if (gt || (tie && lsb_odd)) {
-            ++q;
-        }
-        
-        //Calcular exponente del producto y alinear a Emax
-        int exp_A_i = Ea_shared - delta_A_i;
-        int exp_B_i = Eb_shared - delta_B_i;
-        int exp_prod = exp_A_i + exp_B_i;
-
-        // Delta = Emax - exponente del productox
-        int shift = Emax - exp_prod;
-
-        uint64_t M_shifted;
-
-        if (shift > 0) {
-            uint64_t q_shift = q >> shift;
-            uint64_t rem_shift = q & ((1ull << shift) - 1);
-            uint64_t half_shift = 1ull << (shift - 1);
-            
-            bool tie_shift = (rem_shift == half_shift);
-            bool gt_shift = (rem_shift > half_shift);
-            bool lsb_odd_shift = (q_shift & 1ull) != 0;
-            
-            if (gt_shift || (tie_shift && lsb_odd_shift)) {
-                ++q_shift;
-            }
-            M_shifted = q_shift;
-
-        } else if (shift < 0) {
-            // Shift left (caso raro)
-            M_shifted = q << (-shift);
-        } else{
-            M_shifted = q;
-        }
-        
-        uint32_t M;
-        if (M_shifted > mant_max) {
-            M = mant_max;
-        } else {
-            M = uint32_t(M_shifted);
-        }
+        // Producto exacto de mantissas (2*(WM+1) bits); se redondea despues,
+        // una sola vez, a la escala del mayor producto del bloque
+        Sgn[i] = sign;
+        P[i] = A.mant[i] * B.mant[i];
+        if (P[i] > max_P) max_P = P[i];
+    }
 
-        // Calculo de delta
-        if (M == 0u) {
-            sign = 0u;
-        } 
+    //*========================================================================*/
+    //* FASE 3: REDUCIR A WM BITS (RNE, TRUNC O ESTOCASTICO SEGUN Cfg::rnd)     */
+    //* El mayor producto queda con su MSB en WM: shift = msb(max_P) - WM      */
+    //* Si su redondeo puede llegar a 2^(WM+1) (acarreo), shift + 1: todos los */
+    //* lanes se redondean una sola vez con el exponente final y el overflow   */
+    //* de normalize_block no vuelve a redondearlos                            */
+    //*========================================================================*/
+    int msb = Cfg::wm;
+FIND_MSB_MUL:
+    for (int b = 2 * Cfg::wm + 1; b >= 0; --b) {
+#pragma HLS UNROLL
+        if ((max_P >> b) & 0x1u) { msb = b; break; }
+    }
+    int shift = msb - Cfg::wm;
+    if (shift > 0) {
+        const uint32_t top = uint32_t(max_P >> shift);
+        const uint32_t low = uint32_t(max_P) & ((1u << shift) - 1u);
+        // Estocastico: cualquier bit descartado puede redondear hacia arriba
+        const bool carry = (Cfg::rnd == BFP_RND_STOCH)
+                         ? (top == mant_max && low != 0u)
+                         : (bfp_round_shr<typename Cfg::round>(uint32_t(max_P), shift) > mant_max);
+        if (carry) shift++;
+    }
 
-        Z.sign[i] = sign;
-        Z.mant[i] = M;
-        Z.delta[i] = calculate_delta_from_mant<Cfg>(M);
+ROUND_PRODUCTS:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+        if (special[i]) continue;
+        Mag[i] = helper_round<Cfg>(uint32_t(P[i]), shift, rng, i);
+        if (Mag[i] == 0u && P[i] != 0u) {
+            st.flush_zero += st.lane_on(i);  // Producto no nulo perdido al reducir a WM
+        }
     }
-    
+
+    //*========================================================================*/
+    //* FASE 4: NORMALIZAR Y CONSTRUIR SALIDA                                  */
+    //*========================================================================*/
+    int E = Ea + Eb - Cfg::wm + shift;
+    const bool any_finite = normalize_block<Cfg, Block_size>(Mag, Sgn, special, E, st, rng);
+    finish_block<Cfg, Block_size>(Z, Mag, Sgn, special, any_finite, E, st);
     return Z;
 }
 
 //*============================================================================
-//* RECIPROCO DE BLOQUE BFP: R = 1/B CON DELTA
-//* - Usa exponentes reales de cada elemento (exp_shared - delta)
-//* - Calcula 1/B para cada elemento: exp_recip = -exp_B_i
-//* - Mantissa: División (2^(2*WM)) / mant[i] con RNE
+//* RECIPROCO DE BLOQUE BFP: R = 1/B
+//* - Cada lane se normaliza con su propio exponente (Eb - ajuste) y luego
+//*   se alinea al maximo: con exponente constante por bloque los lanes
+//*   pequeños de B saturarian en 1/B
+//* - Mantissa: División (2^(2*WM)) / mant[i] redondeada con Cfg::round
+//* - 1/0 = Inf, 1/Inf = 0, 1/NaN = NaN
 //*============================================================================
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size> rcp_blocks(
-    const BFP_Global<Cfg, Block_size>& B
+    const BFP_Global<Cfg, Block_size>& B,
+    BFP_Stats<Cfg>& st
 ) {
 #pragma HLS INLINE off
     
-    BFP_Global<Cfg, Block_size> R{};
+    BFP_Global<Cfg, Block_size> R = BFP_Global<Cfg, Block_size>::zero();
     
     const int Eb_shared = int(B.exp_shared) - Cfg::bias_bfp;
     const uint32_t mant_max = (1u << (Cfg::wm + 1)) - 1u;
     
-    std::array<uint32_t, Block_size> q{};
-    std::array<int, Block_size> Ei{};
-    std::array<uint8_t, Block_size> is_zero_den{};
-    bool any_nz = false;
+    std::array<typename Cfg::sum_t, Block_size> q;
+    std::array<typename Cfg::sign_t, Block_size> Sgn;
+    std::array<typename Cfg::eint_t, Block_size> Ei;    // -Eb + ajuste <= bias + WM + 1
+    std::array<bool, Block_size> special{};
+    std::array<bool, Block_size> is_zero_out{};
     
     //*========================================================================
     //* FASE 1: CALCULAR RECIPROCO PARA CADA ELEMENTO
@@ -507,115 +413,99 @@ RCP_ELEMENTS:
 #pragma HLS PIPELINE II=1
 #pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
         
+        Sgn[i] = B.sign[i];  // 1/(+) = +, 1/(-) = -
+        special[i] = 0;
+        is_zero_out[i] = 0;
+
+        if (B.is_nan(i)) {
+            Sgn[i] = 0u;
+            q[i] = mant_max - 1;
+            special[i] = 1;
+            continue;
+        }
         if (B.mant[i] == 0u) {
-            R.sign[i] = B.sign[i];
-            q[i] = mant_max;  // Saturar a máximo (representa infinito)
-            Ei[i] = (1 << Cfg::we) - 1 - Cfg::bias_bfp;;
-            is_zero_den[i] = 1;
+            q[i] = mant_max;      // 1/0 = Inf
+            special[i] = 1;
+            continue;
+        }
+        if (B.is_inf(i)) {
+            q[i] = 0u;            // 1/Inf = 0
+            is_zero_out[i] = 1;
             continue;
         }
         
-        is_zero_den[i] = 0;
-        R.sign[i] = B.sign[i];  // 1/(+) = +, 1/(-) = -
-
-        // Recuperar mantisa completa (unshift con delta)
-        int delta_B_i = int(B.delta[i]);
-        uint64_t Mb_full = (uint64_t)B.mant[i] << delta_B_i;
-        
-        // División: (2^(2*WM)) / mant[i]
-        const uint64_t Num = 1ull << (2 * Cfg::wm);
-        const uint64_t Den = Mb_full;
-        
-        uint64_t qq  = Num / Den;
-        uint64_t rem = Num % Den;
+        // División: (2^(2*WM)) / mant[i], cociente de 2*WM+1 bits
+        typedef ap_uint<2 * Cfg::wm + 1> quot_t;
+        const quot_t Num = quot_t(1) << (2 * Cfg::wm);
+        const typename Cfg::mant_t Den = B.mant[i];
         
-        // RNE para el cociente
-        const bool gt = (rem << 1) > Den;
-        const bool tie = (rem << 1) == Den;
-        const bool lsb_odd = (qq & 1ull) != 0ull;
+        quot_t qq  = Num / Den;
+        quot_t rem = Num % Den;
         
-        if (gt || (tie && lsb_odd)) {
-            ++qq;
-        }
+        // Redondeo del cociente con la politica (resto frente a Den / 2)
+        const quot_t rem2 = rem << 1;   // rem < Den: cabe en WM+2 bits
+        qq = Cfg::round::step(qq, (rem2 > Den) ? 1 : (rem2 == Den) ? 0 : -1);
         
-        // Exponente del recíproco = -exponente_real_del_elemento
-        int exp_B_i = Eb_shared - int(B.delta[i]);
-        int Erec = -exp_B_i;
+        // Exponente del recíproco = -exponente compartido
+        int Erec = -Eb_shared;
         
         // Normalizar si la mantissa excede el máximo permitido
         for (int j = 0; j < (int)Cfg::wm + 1; ++j) {
-#pragma HLS LOOP_TRIPCOUNT min=1 max=15 avg=5
+#pragma HLS LOOP_TRIPCOUNT min=1 max=8 avg=4
             if (qq <= mant_max) break;
-            qq = helper_rne((uint32_t)qq, 1);
+            qq = bfp_round_shr<typename Cfg::round>((uint32_t)qq, 1);
             ++Erec;
         }
         
-        if (qq > mant_max) qq = mant_max;
+        if (qq > mant_max) {
+            qq = mant_max;
+            st.mant_sat += st.lane_on(i);
+        }
         
-        q[i] = (uint32_t)qq;
+        q[i] = qq;
         Ei[i] = Erec;
-        any_nz = true;
     }
     
     //*========================================================================
     //* FASE 2: ENCONTRAR EXPONENTE COMPARTIDO MAXIMO
     //*========================================================================
     int Eshared = 0;
+    bool any_finite = false;
     
-    if (any_nz) {
-        bool first = true;
 FIND_MAX_EXP:
-        for (std::size_t i = 0; i < Block_size; ++i) {
+    for (std::size_t i = 0; i < Block_size; ++i) {
 #pragma HLS PIPELINE II=1
 #pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
-            
-            if (is_zero_den[i]) continue;
-            
-            if (first) {
-                Eshared = Ei[i];
-                first = false;
-            } else if (Ei[i] > Eshared) {
-                Eshared = Ei[i];
-            }
+        
+        if (special[i] || is_zero_out[i]) continue;
+        
+        if (!any_finite || Ei[i] > Eshared) {
+            Eshared = Ei[i];
         }
-    } else {
-        // .Todos cero
-        R.exp_shared = clamp_exponent<Cfg>(0);
-        R.sign.fill(0u);
-        R.mant.fill(0u);
-        R.delta.fill(0u);
-        return R;
+        any_finite = true;
     }
     
     //*========================================================================
-    //* FASE 3: ALINEAR MANTISSAS AL EXPONENTE COMPARTIDO Y CALCULO DE DELTA
+    //* FASE 3: ALINEAR MANTISSAS AL EXPONENTE COMPARTIDO
     //*========================================================================
-ALIGN_AND_CALC_DELTA:
+ALIGN_RCP:
     for (std::size_t i = 0; i < Block_size; ++i) {
 #pragma HLS PIPELINE II=1
 #pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
         
-        uint32_t M = q[i];
-        
-        if (!is_zero_den[i]) {
-            int diff = Eshared - Ei[i];
-            // Delta = diferencia de exponentes
-            //R.delta[i] = uint32_t(diff);
-            if (diff > 0) {
-                M = helper_rne(M, diff);
-            }
-        }/*else {
-            R.delta[i] = 0u;
-        }*/
-        
-        if (M > mant_max) M = mant_max;
-        if (M == 0u) R.sign[i] = 0u;
-        
-        R.mant[i] = M;
-        R.delta[i] = calculate_delta_from_mant<Cfg>(M);
+        if (special[i] || is_zero_out[i]) continue;
+
+        const int diff = Eshared - Ei[i];
+        uint32_t M = bfp_round_shr<typename Cfg::round>(uint32_t(q[i]), diff);
+        if (M > mant_max) {
+            M = mant_max;
+            st.mant_sat += st.lane_on(i);
+        }
+        if (M == 0u) st.flush_zero += st.lane_on(i);
+        q[i] = M;
     }
     
-    R.exp_shared = clamp_exponent<Cfg>(Eshared);
+    finish_block<Cfg, Block_size>(R, q, Sgn, special, any_finite, Eshared, st);
     return R;
 }
 
@@ -626,12 +516,60 @@ ALIGN_AND_CALC_DELTA:
 template<class Cfg, std::size_t Block_size>
 BFP_Global<Cfg, Block_size> div_blocks(
     const BFP_Global<Cfg, Block_size>& A,
-    const BFP_Global<Cfg, Block_size>& B
+    const BFP_Global<Cfg, Block_size>& B,
+    BFP_Stats<Cfg>& st,
+    BFP_Lfsr& rng
 ) {
 #pragma HLS INLINE off
     
-    auto R = rcp_blocks<Cfg, Block_size>(B);
-    return mul_blocks<Cfg, Block_size>(A, R);
+    auto R = rcp_blocks<Cfg, Block_size>(B, st);
+    return mul_blocks<Cfg, Block_size>(A, R, st, rng);
+}
+
+//*============================================================================
+//* VERSIONES SIN CONTADORES (interfaz original)
+//*============================================================================
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> add_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                       const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+    BFP_Stats<Cfg> st{};
+    BFP_Lfsr rng{};
+    return add_blocks<Cfg, Block_size>(A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> sub_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                       const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+    BFP_Stats<Cfg> st{};
+    BFP_Lfsr rng{};
+    return sub_blocks<Cfg, Block_size>(A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> mul_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                       const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+    BFP_Stats<Cfg> st{};
+    BFP_Lfsr rng{};
+    return mul_blocks<Cfg, Block_size>(A, B, st, rng);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> rcp_blocks(const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+    BFP_Stats<Cfg> st{};
+    return rcp_blocks<Cfg, Block_size>(B, st);
+}
+
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> div_blocks(const BFP_Global<Cfg, Block_size>& A,
+                                       const BFP_Global<Cfg, Block_size>& B) {
+#pragma HLS INLINE
+    BFP_Stats<Cfg> st{};
+    BFP_Lfsr rng{};
+    return div_blocks<Cfg, Block_size>(A, B, st, rng);
 }
 
 #endif // BFP_OPS_H
@@ -0,0 +1,69 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_stream_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+//=============================================================================
+// BFP_S2MM - Escritor de borde: AXI-Stream -> HBM (un bloque por beat)
+//   mode = BFP_STREAM_FP32    : escribe N floats por bloque (salida de decode_s)
+//   mode = BFP_STREAM_COMPACT : escribe el formato compacto 1 + 2*N
+//=============================================================================
+extern "C" {
+
+void bfp_s2mm(
+    bfp_stream_t& in_blk,
+    unsigned int* out,
+    const unsigned int mode,
+    const unsigned int n_blocks
+) {
+    #pragma HLS INTERFACE axis port=in_blk
+    #pragma HLS INTERFACE m_axi port=out offset=slave bundle=gmem0 \
+        max_write_burst_length=64 num_write_outstanding=4
+
+    #pragma HLS INTERFACE s_axilite port=mode
+    #pragma HLS INTERFACE s_axilite port=n_blocks
+    #pragma HLS INTERFACE s_axilite port=return
+
+    write_blocks: for (unsigned int blk_idx = 0; blk_idx < n_blocks; blk_idx++) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=128 avg=32
+
+        const bfp_word_t w = in_blk.read();
+
+        if (mode == BFP_STREAM_COMPACT) {
+            const unsigned int offset = blk_idx * BFP_BLOCK_SIZE;
+            const blk_t blk = word_to_bfp<Cfg, N>(w);
+            out[offset] = blk.exp_word();
+
+        write_compact:
+            for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=2
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+                out[offset + 1 + 2 * i] = blk.sign[i];
+                out[offset + 2 + 2 * i] = blk.mant[i];
+            }
+
+        } else {
+            const unsigned int offset = blk_idx * N;
+            const std::array<float, N> xs = word_to_fp32<N>(w);
+
+        write_fp32:
+            for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE II=1
+#pragma HLS LOOP_TRIPCOUNT min=16 max=16 avg=16
+                union {float f; uint32_t u;} c = {xs[i]};
+                out[offset + i] = c.u;
+            }
+        }
+    }
+}
+
+} // extern "C"
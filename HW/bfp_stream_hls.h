@@ -0,0 +1,104 @@
+#ifndef BFP_STREAM_HLS_H
+#define BFP_STREAM_HLS_H
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "bfp_hls.h"
+
+//*============================================================================
+//* PALABRA AXI-STREAM DE 512 BITS: UN BLOQUE COMPLETO POR BEAT
+//*
+//* Bloque FP32 (16 lanes):  lane i en bits [32*i+31 : 32*i]
+//* Bloque BFP:              bits [31:0]  = palabra de exponente (exp | flags)
+//*                          lane i en base = 32 + 17*i:
+//*                            [base+15 : base]    = mant
+//*                            [base+16]           = sign
+//*============================================================================
+typedef ap_uint<512> bfp_word_t;
+typedef hls::stream<bfp_word_t> bfp_stream_t;
+
+static constexpr int BFP_WORD_BITS       = 512;
+static constexpr int BFP_WORD_EXP_BITS   = 32;
+static constexpr int BFP_WORD_MANT_BITS  = 16;
+static constexpr int BFP_WORD_LANE_BITS  = 17;
+
+// Modo de los kernels de borde (bfp_mm2s / bfp_s2mm)
+static constexpr unsigned int BFP_STREAM_FP32    = 0;  // 16 floats por bloque
+static constexpr unsigned int BFP_STREAM_COMPACT = 1;  // formato compacto 1 + 2*N
+
+//*============================================================================
+//* BFP_Global -> PALABRA DE 512 BITS
+//*============================================================================
+template<class Cfg, std::size_t Block_size>
+bfp_word_t bfp_to_word(const BFP_Global<Cfg, Block_size>& blk) {
+#pragma HLS INLINE
+    static_assert(BFP_WORD_EXP_BITS + Block_size * BFP_WORD_LANE_BITS <= BFP_WORD_BITS,
+                  "El bloque BFP no cabe en una palabra de 512 bits");
+    static_assert(Cfg::wm + 1 <= BFP_WORD_MANT_BITS, "WM demasiado grande para el lane");
+
+    bfp_word_t w = 0;
+    w.range(BFP_WORD_EXP_BITS - 1, 0) = blk.exp_word();
+
+PACK_WORD:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        const int base = BFP_WORD_EXP_BITS + int(i) * BFP_WORD_LANE_BITS;
+        w.range(base + BFP_WORD_MANT_BITS - 1, base) = blk.mant[i];
+        w.range(base + BFP_WORD_LANE_BITS - 1, base + BFP_WORD_LANE_BITS - 1) = blk.sign[i];
+    }
+    return w;
+}
+
+//*============================================================================
+//* PALABRA DE 512 BITS -> BFP_Global
+//*============================================================================
+template<class Cfg, std::size_t Block_size>
+BFP_Global<Cfg, Block_size> word_to_bfp(const bfp_word_t& w) {
+#pragma HLS INLINE
+    BFP_Global<Cfg, Block_size> blk = BFP_Global<Cfg, Block_size>::zero();
+    blk.set_exp_word(uint32_t(w.range(BFP_WORD_EXP_BITS - 1, 0)));
+
+UNPACK_WORD:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        const int base = BFP_WORD_EXP_BITS + int(i) * BFP_WORD_LANE_BITS;
+        blk.mant[i]  = uint32_t(w.range(base + BFP_WORD_MANT_BITS - 1, base));
+        blk.sign[i]  = uint32_t(w.range(base + BFP_WORD_LANE_BITS - 1, base + BFP_WORD_LANE_BITS - 1));
+    }
+    return blk;
+}
+
+//*============================================================================
+//* FP32 <-> PALABRA DE 512 BITS
+//*============================================================================
+template<std::size_t Block_size>
+bfp_word_t fp32_to_word(const std::array<float, Block_size>& xs) {
+#pragma HLS INLINE
+    static_assert(Block_size * 32 <= BFP_WORD_BITS, "Bloque FP32 demasiado grande");
+    bfp_word_t w = 0;
+
+PACK_FP32_WORD:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        union {float f; uint32_t u;} c = {xs[i]};
+        w.range(32 * int(i) + 31, 32 * int(i)) = c.u;
+    }
+    return w;
+}
+
+template<std::size_t Block_size>
+std::array<float, Block_size> word_to_fp32(const bfp_word_t& w) {
+#pragma HLS INLINE
+    std::array<float, Block_size> xs{};
+
+UNPACK_FP32_WORD:
+    for (std::size_t i = 0; i < Block_size; i++) {
+#pragma HLS UNROLL
+        union {uint32_t u; float f;} c;
+        c.u = uint32_t(w.range(32 * int(i) + 31, 32 * int(i)));
+        xs[i] = c.f;
+    }
+    return xs;
+}
+
+#endif // BFP_STREAM_HLS_H
@@ -0,0 +1,54 @@
+#!/bin/bash
+# Barrido multi-lane: csynth de bfp_kernel por LANES y tabla de LUT / FF /
+# DSP / BRAM, coste por copia del datapath y latencia del peor caso.
+# Uso: ./csynth_lanes.sh   (necesita vitis_hls en el PATH; LANE_SET="1 2 4 8")
+
+set -e
+
+# Colors for output
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m'
+
+LANE_SET=${LANE_SET:-"1 2 4 8"}
+OUT_DIR=${OUT_DIR:-csynth_lanes}
+mkdir -p "$OUT_DIR"
+
+# Valor de un campo del reporte XML de csynth (primera aparicion)
+xml_field() {
+    grep -o "<$2>[^<]*</$2>" "$1" | head -1 | sed -e "s/<[^>]*>//g"
+}
+
+echo "========================================"
+echo "csynth bfp_kernel por LANES"
+echo "========================================"
+
+for l in $LANE_SET; do
+    echo -e "${BLUE}>>> LANES=${l}${NC}"
+    LANES=$l CSYNTH_ONLY=1 vitis_hls -f run_hls.tcl > "$OUT_DIR/lanes_${l}.log" 2>&1
+    cp bfp_proj_fp32/sol1/syn/report/csynth.xml "$OUT_DIR/lanes_${l}.xml"
+done
+
+# dLUT/lane, dFF/lane: coste de cada copia extra frente a la primera fila
+echo ""
+printf "%-6s %10s %10s %6s %8s %12s %12s %14s\n" "LANES" "LUT" "FF" "DSP" "BRAM" "dLUT/lane" "dFF/lane" "latency(cyc)"
+base=""
+for l in $LANE_SET; do
+    rpt="$OUT_DIR/lanes_${l}.xml"
+    lut=$(xml_field "$rpt" LUT)
+    ff=$(xml_field "$rpt" FF)
+    dsp=$(xml_field "$rpt" DSP)
+    bram=$(xml_field "$rpt" BRAM_18K)
+    lat=$(xml_field "$rpt" Worst-caseLatency)
+    if [ -z "$base" ]; then base_lut=$lut; base_ff=$ff; base=$l; fi
+    if [ "$l" -gt "$base" ]; then
+        d_lut=$(( (lut - base_lut) / (l - base) ))
+        d_ff=$(( (ff - base_ff) / (l - base) ))
+    else
+        d_lut="-"; d_ff="-"
+    fi
+    printf "%-6s %10s %10s %6s %8s %12s %12s %14s\n" "$l" "$lut" "$ff" "$dsp" "$bram" "$d_lut" "$d_ff" "$lat"
+done
+
+echo ""
+echo -e "${GREEN}Reportes en ${OUT_DIR}/ (coste por copia frente a LANES=${base})${NC}"
@@ -0,0 +1,48 @@
+#!/bin/bash
+# Barrido de politicas de redondeo: csynth de bfp_kernel por ROUND_MODE y
+# tabla de LUT / FF / DSP / latencia con el delta frente a RNE.
+# Uso: ./csynth_rounding.sh   (necesita vitis_hls en el PATH)
+
+set -e
+
+# Colors for output
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m'
+
+MODES=${MODES:-"BFP_RND_RNE BFP_RND_TRUNC BFP_RND_HALF_AWAY BFP_RND_STOCH"}
+OUT_DIR=${OUT_DIR:-csynth_rounding}
+mkdir -p "$OUT_DIR"
+
+# Valor de un campo del reporte XML de csynth (primera aparicion)
+xml_field() {
+    grep -o "<$2>[^<]*</$2>" "$1" | head -1 | sed -e "s/<[^>]*>//g"
+}
+
+echo "========================================"
+echo "csynth bfp_kernel por politica de redondeo"
+echo "========================================"
+
+for mode in $MODES; do
+    echo -e "${BLUE}>>> ROUND_MODE=${mode}${NC}"
+    ROUND_MODE=$mode CSYNTH_ONLY=1 vitis_hls -f run_hls.tcl > "$OUT_DIR/${mode}.log" 2>&1
+    cp bfp_proj_fp32/sol1/syn/report/csynth.xml "$OUT_DIR/${mode}.xml"
+done
+
+echo ""
+printf "%-20s %10s %10s %8s %14s %10s %10s\n" "ROUND_MODE" "LUT" "FF" "DSP" "latency(cyc)" "dLUT" "dLatency"
+base=""
+for mode in $MODES; do
+    rpt="$OUT_DIR/${mode}.xml"
+    lut=$(xml_field "$rpt" LUT)
+    ff=$(xml_field "$rpt" FF)
+    dsp=$(xml_field "$rpt" DSP)
+    lat=$(xml_field "$rpt" Worst-caseLatency)
+    if [ -z "$base" ]; then base_lut=$lut; base_lat=$lat; base=$mode; fi
+    d_lut=$((lut - base_lut))
+    d_lat=$([ "$lat" -eq "$lat" ] 2>/dev/null && echo $((lat - base_lat)) || echo "-")
+    printf "%-20s %10s %10s %8s %14s %10s %10s\n" "$mode" "$lut" "$ff" "$dsp" "$lat" "$d_lut" "$d_lat"
+done
+
+echo ""
+echo -e "${GREEN}Reportes en ${OUT_DIR}/ (deltas frente a ${base})${NC}"
@@ -10,14 +10,25 @@ set_top bfp_kernel
 # ARCHIVOS FUENTE
 #   (usa tus fuentes actuales del kernel)
 #==============================================================================
-add_files bfp_kernel.cpp
+# Politica de redondeo: ROUND_MODE=BFP_RND_TRUNC vitis_hls -f run_hls.tcl
+# (csim bit-exacto con los modos deterministas; BFP_RND_STOCH no sigue al modelo CPU)
+set round_mode BFP_RND_RNE
+if {[info exists ::env(ROUND_MODE)]} { set round_mode $::env(ROUND_MODE) }
+# Codificador: ENCODE_1P=0 vuelve a las dos pasadas (comparar latencia en csynth.rpt)
+set encode_1p 1
+if {[info exists ::env(ENCODE_1P)]} { set encode_1p $::env(ENCODE_1P) }
+# Multi-lane: LANES=4 replica COMPUTE para 4 bloques (csynth_lanes.sh barre 1/2/4/8)
+set lanes 1
+if {[info exists ::env(LANES)]} { set lanes $::env(LANES) }
+set kernel_cflags "-DROUND_MODE=$round_mode -DENCODE_1P=$encode_1p -DLANES=$lanes"
+add_files bfp_kernel.cpp -cflags $kernel_cflags
 add_files bfp_ops_hls.h
 add_files bfp_hls.h
 
 #==============================================================================
 # Testbench para C simulation (usa el TB que llama al kernel)
 #==============================================================================
-add_files -tb tb_kernel.cc
+add_files -tb tb_kernel.cc -cflags $kernel_cflags
 
 #==============================================================================
 # CONFIGURACION DE LA SOLUCION
@@ -44,7 +55,9 @@ config_export    -format xo -ipname bfp_kernel
 puts "\n=========================================="
 puts "Starting C Simulation (csim)"
 puts "==========================================\n"
-csim_design
+# CSYNTH_ONLY=1 (csynth_rounding.sh, csynth_lanes.sh): solo sintesis, sin csim ni export
+set csynth_only [info exists ::env(CSYNTH_ONLY)]
+if {!$csynth_only} { csim_design }
 
 puts "\n=========================================="
 puts "Starting C Synthesis (csynth)"
@@ -54,7 +67,7 @@ csynth_design
 puts "\n=========================================="
 puts "Exporting XO"
 puts "==========================================\n"
-export_design -format xo -rtl verilog -output bfp_kernel.xo
+if {!$csynth_only} { export_design -format xo -rtl verilog -output bfp_kernel.xo }
 
 #==============================================================================
 # REPORTE FINAL
@@ -62,7 +75,7 @@ export_design -format xo -rtl verilog -output bfp_kernel.xo
 puts "\n=========================================="
 puts "HLS Flow Complete!"
 puts "=========================================="
-puts "Project: bfp_proj"
+puts "Project: bfp_proj (ROUND_MODE=$round_mode, ENCODE_1P=$encode_1p, LANES=$lanes)"
 puts "Reports: bfp_proj/sol1/syn/report/"
 puts "XO     : bfp_proj/sol1/bfp_kernel.xo (y copia local: ./bfp_kernel.xo)"
 puts "\n"
@@ -0,0 +1,51 @@
+# run_hls_conv.tcl - csim + sintesis de la convolucion 2D BFP (top=bfp_conv)
+# Uso: vitis_hls -f run_hls_conv.tcl
+
+#==============================================================================
+# CONFIGURACION DEL PROYECTO
+#==============================================================================
+open_project -reset bfp_proj_conv
+set_top bfp_conv
+
+add_files bfp_conv.cpp
+add_files bfp_dot_hls.h
+add_files bfp_hls.h
+add_files -tb tb_conv.cc -cflags "-std=c++17"
+add_files -tb ../C++/bfp_conv.h
+
+open_solution -reset "sol1"
+set_part {xcu55c-fsvh2892-2L-e}
+create_clock -period 5.0 -name default  ;# 200 MHz
+
+config_compile   -name_max_length 80
+config_interface -m_axi_conservative_mode=1
+config_interface -m_axi_addr64
+config_interface -m_axi_auto_max_ports=0
+config_export    -format xo -ipname bfp_conv
+
+#==============================================================================
+# EJECUCION DEL FLUJO
+#==============================================================================
+puts "\n=========================================="
+puts "Starting C Simulation (csim) - CONV"
+puts "==========================================\n"
+csim_design -ldflags {-pthread}   ;# la referencia CPU usa std::thread
+
+puts "\n=========================================="
+puts "Starting C Synthesis (csynth) - CONV"
+puts "==========================================\n"
+csynth_design
+
+puts "\n=========================================="
+puts "Exporting XO"
+puts "==========================================\n"
+export_design -format xo -rtl verilog -output bfp_conv.xo
+
+puts "\n=========================================="
+puts "HLS CONV Flow Complete!"
+puts "=========================================="
+puts "Reports: bfp_proj_conv/sol1/syn/report/"
+puts "XO     : ./bfp_conv.xo"
+puts "\n"
+
+exit
@@ -0,0 +1,50 @@
+# run_hls_gemm.tcl - csim + sintesis del kernel GEMM sistolico (top=bfp_gemm)
+# Uso: vitis_hls -f run_hls_gemm.tcl
+
+#==============================================================================
+# CONFIGURACION DEL PROYECTO
+#==============================================================================
+open_project -reset bfp_proj_gemm
+set_top bfp_gemm
+
+add_files bfp_gemm.cpp
+add_files bfp_dot_hls.h
+add_files bfp_hls.h
+add_files -tb tb_gemm.cc
+
+open_solution -reset "sol1"
+set_part {xcu55c-fsvh2892-2L-e}
+create_clock -period 5.0 -name default  ;# 200 MHz
+
+config_compile   -name_max_length 80
+config_interface -m_axi_conservative_mode=1
+config_interface -m_axi_addr64
+config_interface -m_axi_auto_max_ports=0
+config_export    -format xo -ipname bfp_gemm
+
+#==============================================================================
+# EJECUCION DEL FLUJO
+#==============================================================================
+puts "\n=========================================="
+puts "Starting C Simulation (csim) - GEMM"
+puts "==========================================\n"
+csim_design
+
+puts "\n=========================================="
+puts "Starting C Synthesis (csynth) - GEMM"
+puts "==========================================\n"
+csynth_design
+
+puts "\n=========================================="
+puts "Exporting XO"
+puts "==========================================\n"
+export_design -format xo -rtl verilog -output bfp_gemm.xo
+
+puts "\n=========================================="
+puts "HLS GEMM Flow Complete!"
+puts "=========================================="
+puts "Reports: bfp_proj_gemm/sol1/syn/report/"
+puts "XO     : ./bfp_gemm.xo"
+puts "\n"
+
+exit
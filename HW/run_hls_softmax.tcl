@@ -0,0 +1,53 @@
+# run_hls_softmax.tcl - csim + sintesis del softmax BFP por filas (top=softmax)
+# Uso: vitis_hls -f run_hls_softmax.tcl
+# Largo de fila / salida BFP: agregar -cflags "-DSOFTMAX_ROW=<cols> -DSOFTMAX_OUT_BFP"
+# a softmax.cpp y tb_softmax.cc (mismos valores en ambos)
+
+#==============================================================================
+# CONFIGURACION DEL PROYECTO
+#==============================================================================
+open_project -reset bfp_proj_softmax
+set_top softmax
+
+add_files softmax.cpp
+add_files bfp_ops_hls.h
+add_files bfp_stream_hls.h
+add_files bfp_hls.h
+add_files -tb tb_softmax.cc -cflags "-std=c++17"
+
+open_solution -reset "sol1"
+set_part {xcu55c-fsvh2892-2L-e}
+create_clock -period 5.0 -name default  ;# 200 MHz
+
+config_compile   -name_max_length 80
+config_interface -m_axi_conservative_mode=1
+config_interface -m_axi_addr64
+config_interface -m_axi_auto_max_ports=0
+config_export    -format xo -ipname softmax
+
+#==============================================================================
+# EJECUCION DEL FLUJO
+#==============================================================================
+puts "\n=========================================="
+puts "Starting C Simulation (csim) - SOFTMAX"
+puts "==========================================\n"
+csim_design
+
+puts "\n=========================================="
+puts "Starting C Synthesis (csynth) - SOFTMAX"
+puts "==========================================\n"
+csynth_design
+
+puts "\n=========================================="
+puts "Exporting XO"
+puts "==========================================\n"
+export_design -format xo -rtl verilog -output softmax.xo
+
+puts "\n=========================================="
+puts "HLS SOFTMAX Flow Complete!"
+puts "=========================================="
+puts "Reports: bfp_proj_softmax/sol1/syn/report/"
+puts "XO     : ./softmax.xo"
+puts "\n"
+
+exit
@@ -0,0 +1,59 @@
+# run_hls_stream.tcl - csim del pipeline AXI-Stream y sintesis de cada kernel
+# Uso: vitis_hls -f run_hls_stream.tcl
+
+set stream_kernels {bfp_mm2s bfp_encode_s bfp_alu_s bfp_decode_s bfp_s2mm}
+
+#==============================================================================
+# C SIMULATION: el TB enlaza los cinco kernels y bfp_kernel como referencia
+#==============================================================================
+open_project -reset bfp_proj_stream
+set_top bfp_alu_s
+foreach k $stream_kernels {
+    add_files $k.cpp
+}
+add_files bfp_kernel.cpp
+add_files -tb tb_stream.cc
+
+open_solution -reset "sol1"
+set_part {xcu55c-fsvh2892-2L-e}
+create_clock -period 5.0 -name default  ;# 200 MHz
+
+puts "\n=========================================="
+puts "Starting C Simulation (csim) - stream pipeline"
+puts "==========================================\n"
+csim_design
+
+#==============================================================================
+# SINTESIS + EXPORT XO: un proyecto por kernel (top = nombre del archivo)
+#==============================================================================
+foreach k $stream_kernels {
+    open_project -reset bfp_proj_$k
+    set_top $k
+    add_files $k.cpp
+    add_files bfp_hls.h
+    add_files bfp_ops_hls.h
+    add_files bfp_stream_hls.h
+
+    open_solution -reset "sol1"
+    set_part {xcu55c-fsvh2892-2L-e}
+    create_clock -period 5.0 -name default
+
+    config_compile   -name_max_length 80
+    config_interface -m_axi_addr64
+    config_export    -format xo -ipname $k
+
+    puts "\n=========================================="
+    puts "Synthesizing $k"
+    puts "==========================================\n"
+    csynth_design
+    export_design -format xo -rtl verilog -output $k.xo
+}
+
+puts "\n=========================================="
+puts "HLS Stream Flow Complete!"
+puts "=========================================="
+puts "XO: [join $stream_kernels {.xo, }].xo"
+puts "Link: v++ -l --config bfp_stream.cfg ... (o make PIPELINE=stream)"
+puts "\n"
+
+exit
@@ -0,0 +1,184 @@
+#include <ap_int.h>
+#include "bfp_hls.h"
+#include "bfp_ops_hls.h"
+#include "bfp_stream_hls.h"
+
+// Configuration
+#define WE 5
+#define WM 7
+#define N 16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+// Largo de fila (el host solo pasa 'size'): -DSOFTMAX_ROW=<cols> en v++ -c
+#ifndef SOFTMAX_ROW
+#define SOFTMAX_ROW 64
+#endif
+#define SOFTMAX_ROW_BLOCKS ((SOFTMAX_ROW + N - 1) / N)
+
+// Salida: FP32 por defecto; con -DSOFTMAX_OUT_BFP cada bloque de N elementos
+// se escribe como una palabra de 512 bits (mismo layout que bfp_stream_hls.h),
+// que ocupa exactamente los N floats del bloque en el buffer de salida.
+#ifdef SOFTMAX_OUT_BFP
+static_assert(SOFTMAX_ROW % N == 0, "SOFTMAX_OUT_BFP requiere SOFTMAX_ROW multiplo de N");
+#endif
+
+//=============================================================================
+// exp(x - max) = 2^t,  t = (x - max) * log2(e) <= 0,  t = n + f,  f en [0, 1)
+// 2^f: tabla lineal a tramos de 32 segmentos en Q16 (2^(i/32) * 65536)
+//=============================================================================
+static constexpr int      SM_FRAC_BITS = 16;
+static constexpr int64_t  SM_LOG2E_Q16 = 94548;             // log2(e) * 2^16
+static constexpr int      SM_SCALE     = Cfg::bias_bfp + Cfg::wm;  // key = x * 2^SM_SCALE
+static constexpr int      SM_SUM_FRAC  = 40;                // acumulador de la suma en Q40
+static constexpr int      SM_EXP_MIN   = -SM_SUM_FRAC;      // terminos menores se descartan
+
+static const uint32_t SM_POW2_TABLE[33] = {
+    65536, 66971, 68438, 69936, 71468, 73032, 74632, 76266,
+    77936, 79642, 81386, 83169, 84990, 86851, 88752, 90696,
+    92682, 94711, 96785, 98905, 101070, 103283, 105545, 107856,
+    110218, 112631, 115098, 117618, 120194, 122825, 125515, 128263,
+    131072,
+};
+
+// Lane BFP -> entero con signo alineado al exponente compartido:
+// x = key * 2^-(bias + wm). Comparar keys = comparar primero E y luego mant.
+static inline int64_t sm_key(const blk_t& blk, int i) {
+#pragma HLS INLINE
+    const int64_t mag = int64_t(blk.mant[i]) << int(blk.exp_shared);
+    return blk.sign[i] ? -mag : mag;
+}
+
+// 2^t con t = d * log2(e), d = key - max_key <= 0. Devuelve p (Q16, [1, 2)) y n.
+static inline void sm_exp2(int64_t d, uint32_t& p, int& n) {
+#pragma HLS INLINE
+    const int64_t t = (d * SM_LOG2E_Q16) >> SM_SCALE;         // Q16, floor
+    n = int(t >> SM_FRAC_BITS);
+    const uint32_t f   = uint32_t(t & ((1 << SM_FRAC_BITS) - 1));
+    const uint32_t idx = f >> (SM_FRAC_BITS - 5);
+    const uint32_t rem = f & ((1u << (SM_FRAC_BITS - 5)) - 1u);
+    const uint32_t lo = SM_POW2_TABLE[idx], hi = SM_POW2_TABLE[idx + 1];
+    p = lo + (((hi - lo) * rem) >> (SM_FRAC_BITS - 5));
+}
+
+//=============================================================================
+// SOFTMAX POR FILAS: c[r, :] = softmax(a[r, :]), filas de SOFTMAX_ROW elementos
+// (la ultima puede ser parcial). Firma de SW/softmax/softmax.cpp.
+//=============================================================================
+extern "C" {
+
+void softmax(
+    const float* a,
+    float* c,
+    int size
+) {
+    #pragma HLS INTERFACE m_axi port=a offset=slave bundle=gmem0 \
+        max_read_burst_length=16 num_read_outstanding=4
+    #pragma HLS INTERFACE m_axi port=c offset=slave bundle=gmem1 \
+        max_write_burst_length=16 num_write_outstanding=4
+
+    #pragma HLS INTERFACE s_axilite port=size
+    #pragma HLS INTERFACE s_axilite port=return
+
+    blk_t row_blk[SOFTMAX_ROW_BLOCKS];
+    uint32_t e_p[SOFTMAX_ROW];
+    int      e_n[SOFTMAX_ROW];
+
+ROWS:
+    for (int r0 = 0; r0 < size; r0 += SOFTMAX_ROW) {
+#pragma HLS LOOP_TRIPCOUNT min=1 max=64 avg=8
+        const int len = (size - r0 < SOFTMAX_ROW) ? (size - r0) : SOFTMAX_ROW;
+
+        //=====================================================================
+        // PHASE 1: LOAD + ENCODE, max por exponente compartido + max entero
+        //=====================================================================
+        int64_t max_key = 0;
+        bool first = true;
+
+    ENCODE_ROW:
+        for (int b = 0; b < SOFTMAX_ROW_BLOCKS; b++) {
+            std::array<float, N> xs{};
+            for (int l = 0; l < N; l++) {
+#pragma HLS PIPELINE II=1
+                const int j = b * N + l;
+                xs[l] = (j < len) ? a[r0 + j] : 0.0f;
+            }
+            row_blk[b] = encode_block<Cfg, N>(xs);
+
+        MAX_LANES:
+            for (int l = 0; l < N; l++) {
+#pragma HLS PIPELINE II=1
+                if (b * N + l >= len) continue;
+                const int64_t k = sm_key(row_blk[b], l);
+                if (first || k > max_key) max_key = k;
+                first = false;
+            }
+        }
+
+        //=====================================================================
+        // PHASE 2: exp(x - max) por tabla + suma en Q40
+        //=====================================================================
+        int64_t sum_q = 0;
+
+    EXP_ROW:
+        for (int j = 0; j < SOFTMAX_ROW; j++) {
+#pragma HLS PIPELINE II=1
+            if (j >= len) break;
+            uint32_t p;
+            int n;
+            sm_exp2(sm_key(row_blk[j / N], j % N) - max_key, p, n);
+            e_p[j] = p;
+            e_n[j] = n;
+
+            if (n >= SM_EXP_MIN) {
+                const int s = n + SM_SUM_FRAC - SM_FRAC_BITS;
+                sum_q += (s >= 0) ? (int64_t(p) << s) : (int64_t(p) >> -s);
+            }
+        }
+
+        //=====================================================================
+        // PHASE 3: 1 / suma con la unidad reciproca BFP
+        // Todos los lanes llevan la suma (un lane en cero saturaria el
+        // exponente compartido). Se lee el lane 0 numericamente: suma >= 1.
+        //=====================================================================
+        std::array<float, N> s_in;
+        s_in.fill(std::ldexp(float(sum_q), -SM_SUM_FRAC));
+        const blk_t R = rcp_blocks<Cfg, N>(encode_block<Cfg, N>(s_in));
+        const uint32_t r_mant = R.mant[0];
+        const int r_exp = int(R.exp_shared) - Cfg::bias_bfp - Cfg::wm;
+
+        //=====================================================================
+        // PHASE 4: NORMALIZAR + STORE
+        //=====================================================================
+    STORE_ROW:
+        for (int b = 0; b < SOFTMAX_ROW_BLOCKS; b++) {
+            std::array<float, N> ys{};
+            for (int l = 0; l < N; l++) {
+#pragma HLS PIPELINE II=1
+                const int j = b * N + l;
+                if (j >= len || e_n[j] < SM_EXP_MIN) continue;
+                ys[l] = std::ldexp(float(uint64_t(e_p[j]) * r_mant), e_n[j] - SM_FRAC_BITS + r_exp);
+            }
+
+#ifdef SOFTMAX_OUT_BFP
+            if (b * N >= len) break;
+            const bfp_word_t w = bfp_to_word<Cfg, N>(encode_block<Cfg, N>(ys));
+            for (int l = 0; l < N; l++) {
+#pragma HLS PIPELINE II=1
+                union {uint32_t u; float f;} cv;
+                cv.u = uint32_t(w.range(32 * l + 31, 32 * l));
+                c[r0 + b * N + l] = cv.f;
+            }
+#else
+            for (int l = 0; l < N; l++) {
+#pragma HLS PIPELINE II=1
+                const int j = b * N + l;
+                if (j < len) c[r0 + j] = ys[l];
+            }
+#endif
+        }
+    }
+}
+
+} // extern "C"
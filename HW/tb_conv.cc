@@ -0,0 +1,170 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <iomanip>
+
+#include "bfp_hls.h"
+#include "../C++/bfp_conv.h"   // referencia CPU multihilo (mismo layout)
+
+// Kernel de convolucion
+extern "C" void bfp_conv(
+    const unsigned int mode,
+    const unsigned int height,
+    const unsigned int width,
+    const unsigned int c_in,
+    const unsigned int c_out,
+    const unsigned int ksize,
+    const unsigned int stride,
+    const unsigned int pad,
+    const unsigned int* in_bfp,
+    const unsigned int* weights,
+    float* out_fp32,
+    unsigned int* out_bfp
+);
+
+//------------------------ Configuración ------------------------
+#define WE 5
+#define WM 7
+#define N  16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+// Debe coincidir con bfp_conv.cpp
+static constexpr unsigned int CONV_OUT_BFP = 0x1;
+
+//------------------------ Helpers ------------------------
+std::vector<unsigned int> to_compact(const std::vector<blk_t>& blks) {
+    std::vector<unsigned int> v(blks.size() * BFP_BLOCK_SIZE);
+    for (size_t b = 0; b < blks.size(); b++) {
+        const size_t off = b * BFP_BLOCK_SIZE;
+        v[off] = blks[b].exp_word();
+        for (int l = 0; l < N; l++) {
+            v[off + 1 + 2 * l] = blks[b].sign[l];
+            v[off + 2 + 2 * l] = blks[b].mant[l];
+        }
+    }
+    return v;
+}
+
+// Valor numerico del lane (sin interpretar centinelas NaN/Inf)
+float bfp_value(const unsigned int* blk, int l) {
+    const float v = std::ldexp(float(blk[2 + 2 * l]), int(blk[0] & BFP_EXP_MASK) - Cfg::bias_bfp - Cfg::wm);
+    return blk[1 + 2 * l] ? -v : v;
+}
+
+// Error maximo relativo al maximo de la salida de referencia
+double max_rel_err(const std::vector<float>& got, const std::vector<float>& ref) {
+    double scale = 1e-30, worst = 0.0;
+    for (float r : ref) scale = std::max(scale, double(std::fabs(r)));
+    for (size_t i = 0; i < ref.size(); i++) {
+        const double e = std::fabs(double(got[i]) - double(ref[i])) / scale;
+        if (!(e == e)) return INFINITY;  // NaN
+        worst = std::max(worst, e);
+    }
+    return worst;
+}
+
+int run_case(const char* name, const Conv2DShape& s, bool bfp_out) {
+    // Mapa de entrada HWC y pesos [oc][ky][kx][ci] deterministas
+    std::vector<float> x(size_t(s.height) * s.width * s.c_in);
+    std::vector<float> w(size_t(s.c_out) * s.ksize * s.ksize * s.c_in);
+    for (size_t i = 0; i < x.size(); i++) x[i] = std::sin(0.37f * float(i) + 0.1f) * (1.0f + float(i % 3));
+    for (size_t i = 0; i < w.size(); i++) w[i] = std::cos(0.19f * float(i)) * 0.5f;
+
+    const auto in_blk = conv_encode_hwc<Cfg, N>(x, s.height * s.width, s.c_in);
+    const auto w_blk  = conv_encode_hwc<Cfg, N>(w, s.c_out * s.ksize * s.ksize, s.c_in);
+    const auto in_c = to_compact(in_blk);
+    const auto w_c  = to_compact(w_blk);
+
+    const std::vector<float> ref = conv2d_bfp_ref<Cfg, N>(in_blk, w_blk, s, 4);
+
+    const int OH = s.out_h(), OW = s.out_w();
+    const int ob_n = (s.c_out + N - 1) / N;
+    std::vector<float> out(size_t(OH) * OW * s.c_out, 0.f);
+    std::vector<unsigned int> out_c(size_t(OH) * OW * ob_n * BFP_BLOCK_SIZE, 0u);
+
+    bfp_conv(bfp_out ? CONV_OUT_BFP : 0u, s.height, s.width, s.c_in, s.c_out,
+             s.ksize, s.stride, s.pad, in_c.data(), w_c.data(), out.data(), out_c.data());
+
+    if (bfp_out) {
+        for (int p = 0; p < OH * OW; p++)
+            for (int oc = 0; oc < s.c_out; oc++)
+                out[size_t(p) * s.c_out + oc] =
+                    bfp_value(&out_c[(size_t(p) * ob_n + oc / N) * BFP_BLOCK_SIZE], oc % N);
+    }
+
+    // FP32: solo redondeo final; BFP: un redondeo a WM bits del bloque de salida
+    const double err = max_rel_err(out, ref);
+    const double tol = bfp_out ? std::ldexp(1.0, -WM) : 1e-6;
+    const bool ok = err <= tol;
+    std::cout << "  " << std::left << std::setw(52) << name << std::right
+              << "max_rel_err=" << std::scientific << std::setprecision(3) << err
+              << std::defaultfloat << "  " << (ok ? "[OK]" : "[FAIL]") << "\n";
+    return ok ? 0 : 1;
+}
+
+// Forma fuera de los limites en chip: el kernel no debe escribir ninguna salida
+int run_reject(const char* name, const Conv2DShape& s) {
+    const unsigned int SENT = 0xDEADBEEFu;
+    const size_t cb_n = (s.c_in + N - 1) / N;
+    const std::vector<unsigned int> in_c(size_t(s.height) * s.width * cb_n * BFP_BLOCK_SIZE, 0u);
+    const std::vector<unsigned int> w_c(size_t(s.c_out) * s.ksize * s.ksize * cb_n * BFP_BLOCK_SIZE, 0u);
+    std::vector<float> out(1u << 16, -3.f);
+    std::vector<unsigned int> out_c(1u << 16, SENT);
+
+    bool ok = true;
+    for (unsigned int mode : {0u, CONV_OUT_BFP}) {
+        bfp_conv(mode, s.height, s.width, s.c_in, s.c_out, s.ksize, s.stride, s.pad,
+                 in_c.data(), w_c.data(), out.data(), out_c.data());
+        for (float v : out) ok = ok && (v == -3.f);
+        for (unsigned int v : out_c) ok = ok && (v == SENT);
+    }
+    std::cout << "  " << std::left << std::setw(52) << name << std::right
+              << (ok ? "sin escrituras  [OK]" : "escribio salida  [FAIL]") << "\n";
+    return ok ? 0 : 1;
+}
+
+int main() {
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "TESTBENCH BFP CONV2D (line buffers) vs referencia CPU multihilo\n";
+    std::cout << "Config: WE=" << WE << ", WM=" << WM << ", N=" << N << "\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    int tb_failures = 0;
+
+    std::cout << "Capas pequenas (H x W x C_in -> C_out, K, stride, pad)\n";
+    std::cout << std::string(80, '-') << "\n";
+    //                                             H  W  Cin Cout K  S  P
+    tb_failures += run_case("8x8x16 -> 8,  K=3 S=1 P=1 (FP32)",  {8, 8, 16, 8,  3, 1, 1}, false);
+    tb_failures += run_case("9x7x20 -> 20, K=5 S=2 P=2 (BFP)",   {9, 7, 20, 20, 5, 2, 2}, true);
+    tb_failures += run_case("6x6x3  -> 4,  K=1 S=1 P=0 (FP32)",  {6, 6, 3,  4,  1, 1, 0}, false);
+    tb_failures += run_case("10x12x32 -> 32, K=3 S=2 P=0 (FP32)", {10, 12, 32, 32, 3, 2, 0}, false);
+    std::cout << "\n";
+
+    std::cout << "Formas fuera de los limites en chip (rechazadas)\n";
+    std::cout << std::string(80, '-') << "\n";
+    //                                                  H  W   Cin Cout K  S  P
+    tb_failures += run_reject("C_in = 48 > 32 (CONV_CB_MAX = 2)",     {8, 8,  48, 8,  3, 1, 1});
+    tb_failures += run_reject("C_out = 40 > CONV_CO_MAX",             {8, 8,  16, 40, 3, 1, 1});
+    tb_failures += run_reject("K = 7 > CONV_K_MAX",                   {8, 8,  16, 8,  7, 1, 3});
+    tb_failures += run_reject("K = 0",                                {8, 8,  16, 8,  0, 1, 0});
+    tb_failures += run_reject("W + 2P = 68 > CONV_W_MAX",             {4, 64, 16, 8,  3, 1, 2});
+    tb_failures += run_reject("W + 2P = 2 < K = 3",                   {8, 2,  16, 8,  3, 1, 0});
+    tb_failures += run_reject("H + 2P = 2 < K = 3",                   {2, 8,  16, 8,  3, 1, 0});
+    std::cout << "\n";
+
+    //======================== RESUMEN FINAL ========================
+    std::cout << std::string(80, '=') << "\n";
+    if (tb_failures) {
+        std::cout << "[FAIL] " << tb_failures << " CONV TEST(S) FAILED!\n";
+        std::cout << std::string(80, '=') << "\n";
+        return 1;
+    }
+    std::cout << "ALL CONV TESTS COMPLETED!\n";
+    std::cout << std::string(80, '=') << "\n";
+    return 0;
+}
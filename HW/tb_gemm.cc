@@ -0,0 +1,299 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <string>
+
+#include "bfp_hls.h"
+#include "bfp_dot_hls.h"
+
+// Kernel GEMM (arreglo sistolico)
+extern "C" void bfp_gemm(
+    const unsigned int mode,
+    const unsigned int m,
+    const unsigned int n_cols,
+    const unsigned int k_blocks,
+    const unsigned int* a_bfp,
+    const unsigned int* bt_bfp,
+    float* out_fp32,
+    unsigned int* out_bfp
+);
+
+//------------------------ Configuración ------------------------
+#define WE 5
+#define WM 7
+#define N  16
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+// Debe coincidir con bfp_gemm.cpp
+static constexpr unsigned int GEMM_OUT_BFP    = 0x1;
+static constexpr unsigned int GEMM_ACCUMULATE = 0x2;
+
+//------------------------ Helpers ------------------------
+// Valor numerico de un lane: (-1)^s * mant * 2^(E - bias - wm). Es lo que usa
+// el PE (sin interpretar los centinelas NaN/Inf de BFP_FLAG_SPECIAL).
+float bfp_value(const blk_t& b, int l) {
+    const float v = std::ldexp(float(b.mant[l]), int(b.exp_shared) - Cfg::bias_bfp - Cfg::wm);
+    return b.sign[l] ? -v : v;
+}
+
+// Codifica una matriz (rows x K, row-major) en bloques de N a lo largo de K.
+// Devuelve tambien la matriz cuantizada (valores BFP decodificados).
+void encode_matrix(const std::vector<float>& x, unsigned rows, unsigned K,
+                   std::vector<unsigned int>& enc, std::vector<float>& quant) {
+    const unsigned kb_n = K / N;
+    enc.assign(rows * kb_n * BFP_BLOCK_SIZE, 0u);
+    quant.assign(rows * K, 0.f);
+    for (unsigned r = 0; r < rows; r++) {
+        for (unsigned kb = 0; kb < kb_n; kb++) {
+            std::array<float, N> xs{};
+            for (int l = 0; l < N; l++) xs[l] = x[r * K + kb * N + l];
+            const blk_t b = encode_block<Cfg, N>(xs);
+            const unsigned off = (r * kb_n + kb) * BFP_BLOCK_SIZE;
+            enc[off] = b.exp_word();
+            for (int l = 0; l < N; l++) {
+                enc[off + 1 + 2 * l] = b.sign[l];
+                enc[off + 2 + 2 * l] = b.mant[l];
+                quant[r * K + kb * N + l] = bfp_value(b, l);
+            }
+        }
+    }
+}
+
+// GEMM de referencia en CPU (double): C = A * B, con B dada como B^T
+std::vector<double> ref_gemm(const std::vector<float>& a, const std::vector<float>& bt,
+                             unsigned m, unsigned n_cols, unsigned K) {
+    std::vector<double> c(m * n_cols, 0.0);
+    for (unsigned i = 0; i < m; i++)
+        for (unsigned j = 0; j < n_cols; j++) {
+            double s = 0.0;
+            for (unsigned k = 0; k < K; k++) s += double(a[i * K + k]) * double(bt[j * K + k]);
+            c[i * n_cols + j] = s;
+        }
+    return c;
+}
+
+// Error relativo maximo normalizado por la norma de la fila de referencia
+double max_rel_err(const std::vector<float>& got, const std::vector<double>& ref,
+                   unsigned m, unsigned n_cols) {
+    double worst = 0.0;
+    for (unsigned i = 0; i < m; i++) {
+        double scale = 1e-30;
+        for (unsigned j = 0; j < n_cols; j++) scale = std::max(scale, std::fabs(ref[i * n_cols + j]));
+        for (unsigned j = 0; j < n_cols; j++) {
+            const double e = std::fabs(double(got[i * n_cols + j]) - ref[i * n_cols + j]) / scale;
+            if (!(e == e)) return INFINITY;  // NaN
+            worst = std::max(worst, e);
+        }
+    }
+    return worst;
+}
+
+void report(const char* name, double err, double tol, int& failures) {
+    const bool ok = err <= tol;
+    std::cout << "  " << std::left << std::setw(44) << name << std::right
+              << "max_rel_err=" << std::scientific << std::setprecision(3) << err
+              << std::defaultfloat << "  " << (ok ? "[OK]" : "[FAIL]") << "\n";
+    if (!ok) failures++;
+}
+
+int main() {
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "TESTBENCH BFP GEMM (arreglo sistolico) vs GEMM de referencia en CPU\n";
+    std::cout << "Config: WE=" << WE << ", WM=" << WM << ", N=" << N << "\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    int tb_failures = 0;
+
+    // Dimensiones que no son multiplo del arreglo (P=4, Q=16)
+    const unsigned m = 7, n_cols = 21, K = 96;
+    std::vector<float> a(m * K), bt(n_cols * K);
+    for (unsigned i = 0; i < m * K; i++)
+        a[i] = std::sin(0.11f * float(i) + 0.3f) * std::ldexp(1.0f, int(i % 5) - 2);
+    for (unsigned i = 0; i < n_cols * K; i++)
+        bt[i] = std::cos(0.07f * float(i)) * 3.0f - 0.5f;
+
+    std::vector<unsigned int> a_enc, bt_enc;
+    std::vector<float> a_q, bt_q;
+    encode_matrix(a, m, K, a_enc, a_q);
+    encode_matrix(bt, n_cols, K, bt_enc, bt_q);
+
+    const std::vector<double> ref_q  = ref_gemm(a_q, bt_q, m, n_cols, K);
+    const std::vector<double> ref_fp = ref_gemm(a, bt, m, n_cols, K);
+
+    std::vector<unsigned int> dummy_bfp(BFP_BLOCK_SIZE, 0u);
+    std::vector<float> dummy_fp32(1, 0.f);
+
+    //======================== TEST 1: SALIDA FP32 ========================
+    std::cout << "TEST 1: C = A * B, salida FP32 (" << m << "x" << K << " * " << K << "x" << n_cols << ")\n";
+    std::cout << std::string(80, '-') << "\n";
+    std::vector<float> c(m * n_cols, 0.f);
+    bfp_gemm(0, m, n_cols, K / N, a_enc.data(), bt_enc.data(), c.data(), dummy_bfp.data());
+    // Contra la GEMM de las entradas cuantizadas: solo redondeo de la salida FP32
+    report("vs CPU GEMM (entradas BFP)", max_rel_err(c, ref_q, m, n_cols), 1e-6, tb_failures);
+    // Contra FP32 puro: error de cuantizacion BFP (WM=7)
+    report("vs CPU GEMM (entradas FP32)", max_rel_err(c, ref_fp, m, n_cols), 2e-2, tb_failures);
+    std::cout << "\n";
+
+    //======================== TEST 2: TESELADO EN K + ACUMULACION ========================
+    // Igual que el host: K en dos mitades, la segunda con GEMM_ACCUMULATE
+    std::cout << "TEST 2: K dividido en dos lanzamientos (GEMM_ACCUMULATE)\n";
+    std::cout << std::string(80, '-') << "\n";
+    {
+        const unsigned K0 = 48, K1 = K - K0;
+        std::vector<float> a0(m * K0), a1(m * K1), b0(n_cols * K0), b1(n_cols * K1);
+        for (unsigned i = 0; i < m; i++)
+            for (unsigned k = 0; k < K; k++) (k < K0 ? a0[i * K0 + k] : a1[i * K1 + k - K0]) = a[i * K + k];
+        for (unsigned j = 0; j < n_cols; j++)
+            for (unsigned k = 0; k < K; k++) (k < K0 ? b0[j * K0 + k] : b1[j * K1 + k - K0]) = bt[j * K + k];
+
+        std::vector<unsigned int> a0e, a1e, b0e, b1e;
+        std::vector<float> tmp;
+        encode_matrix(a0, m, K0, a0e, tmp);
+        encode_matrix(a1, m, K1, a1e, tmp);
+        encode_matrix(b0, n_cols, K0, b0e, tmp);
+        encode_matrix(b1, n_cols, K1, b1e, tmp);
+
+        std::vector<float> ct(m * n_cols, 0.f);
+        bfp_gemm(0, m, n_cols, K0 / N, a0e.data(), b0e.data(), ct.data(), dummy_bfp.data());
+        bfp_gemm(GEMM_ACCUMULATE, m, n_cols, K1 / N, a1e.data(), b1e.data(), ct.data(), dummy_bfp.data());
+        report("K tiles vs una sola pasada", max_rel_err(ct, ref_q, m, n_cols), 1e-6, tb_failures);
+    }
+    std::cout << "\n";
+
+    //======================== TEST 3: SALIDA BFP ========================
+    std::cout << "TEST 3: salida renormalizada a BFP (GEMM_OUT_BFP)\n";
+    std::cout << std::string(80, '-') << "\n";
+    {
+        const unsigned row_blocks = (n_cols + N - 1) / N;
+        std::vector<unsigned int> c_enc(m * row_blocks * BFP_BLOCK_SIZE, 0u);
+        bfp_gemm(GEMM_OUT_BFP, m, n_cols, K / N, a_enc.data(), bt_enc.data(),
+                 dummy_fp32.data(), c_enc.data());
+
+        std::vector<float> c_dec(m * n_cols, 0.f);
+        for (unsigned i = 0; i < m; i++)
+            for (unsigned jb = 0; jb < row_blocks; jb++) {
+                const unsigned off = (i * row_blocks + jb) * BFP_BLOCK_SIZE;
+                blk_t b = blk_t::zero();
+                b.set_exp_word(c_enc[off]);
+                for (int l = 0; l < N; l++) {
+                    b.sign[l]  = c_enc[off + 1 + 2 * l];
+                    b.mant[l]  = c_enc[off + 2 + 2 * l];
+                }
+                for (int l = 0; l < N; l++) {
+                    const unsigned j = jb * N + l;
+                    if (j < n_cols) c_dec[i * n_cols + j] = bfp_value(b, l);
+                }
+            }
+        // Un redondeo a WM bits relativo al maximo del bloque
+        report("BFP(C) vs CPU GEMM (entradas BFP)", max_rel_err(c_dec, ref_q, m, n_cols),
+               std::ldexp(1.0, -WM), tb_failures);
+    }
+    std::cout << "\n";
+
+    //======================== TEST 4: BLOQUES NULOS ========================
+    std::cout << "TEST 4: A = 0 produce C = 0\n";
+    std::cout << std::string(80, '-') << "\n";
+    {
+        std::vector<float> z(m * K, 0.f), zq;
+        std::vector<unsigned int> z_enc;
+        encode_matrix(z, m, K, z_enc, zq);
+        std::vector<float> cz(m * n_cols, 1.f);
+        bfp_gemm(0, m, n_cols, K / N, z_enc.data(), bt_enc.data(), cz.data(), dummy_bfp.data());
+        bool ok = true;
+        for (float v : cz) ok = ok && (v == 0.0f);
+        std::cout << "  " << std::left << std::setw(44) << "zeros" << std::right
+                  << (ok ? "[OK]" : "[FAIL]") << "\n";
+        if (!ok) tb_failures++;
+    }
+    std::cout << "\n";
+
+    //======================== TEST 5: K FUERA DE RANGO ========================
+    // k_blocks > GEMM_MAX_KB (K > 1024): el kernel no escribe C
+    std::cout << "TEST 5: k_blocks > GEMM_MAX_KB no escribe C\n";
+    std::cout << std::string(80, '-') << "\n";
+    {
+        const unsigned kb = 65;
+        std::vector<float> big(m * kb * N, 1.f), big_t(n_cols * kb * N, 1.f), bq;
+        std::vector<unsigned int> a_big, b_big;
+        encode_matrix(big, m, kb * N, a_big, bq);
+        encode_matrix(big_t, n_cols, kb * N, b_big, bq);
+        for (unsigned mode : {0u, GEMM_OUT_BFP}) {
+            std::vector<float> c(m * n_cols, -3.f);
+            std::vector<unsigned int> cb(m * ((n_cols + N - 1) / N) * BFP_BLOCK_SIZE, 0xDEADBEEFu);
+            bfp_gemm(mode, m, n_cols, kb, a_big.data(), b_big.data(), c.data(), cb.data());
+            bool ok = true;
+            for (float v : c) ok = ok && (v == -3.f);
+            for (unsigned int w : cb) ok = ok && (w == 0xDEADBEEFu);
+            const std::string name = "k_blocks = 65, " + std::string(mode ? "salida BFP" : "salida FP32");
+            std::cout << "  " << std::left << std::setw(44) << name << std::right
+                      << (ok ? "[OK]" : "[FAIL]") << "\n";
+            if (!ok) tb_failures++;
+        }
+    }
+    std::cout << "\n";
+
+    //======================== TEST 6: ACUMULADOR ANCHO ========================
+    std::cout << "TEST 6: BFP_Accum (reduccion de 256 bloques, producto punto por lanes)\n";
+    std::cout << std::string(80, '-') << "\n";
+    {
+        const unsigned n_red = 256;
+        std::vector<blk_t> xs(n_red);
+        for (unsigned b = 0; b < n_red; b++) {
+            std::array<float, N> v{};
+            for (int l = 0; l < N; l++)
+                v[l] = std::sin(0.37f * float(b * N + l)) * std::ldexp(1.0f, int(b % 9) - 4) + 0.01f;
+            xs[b] = encode_block<Cfg, N>(v);
+        }
+
+        // sum_b xs[b]  y  sum_b xs[b] * xs[n-1-b] (lane a lane)
+        std::vector<double> ref(N, 0.0), dot_ref(N, 0.0);
+        BFP_Accum<Cfg, N> dot;
+        dot.clear();
+        blk_t chain = xs[0];
+        for (unsigned b = 0; b < n_red; b++) {
+            const blk_t& y = xs[n_red - 1 - b];
+            dot.mac(xs[b], y);
+            if (b > 0) chain = add_blocks<Cfg, N>(chain, xs[b]);
+            for (int l = 0; l < N; l++) {
+                ref[l]     += double(bfp_value(xs[b], l));
+                dot_ref[l] += double(bfp_value(xs[b], l)) * double(bfp_value(y, l));
+            }
+        }
+
+        // Un solo redondeo: error <= 1/2 ulp del bloque (+ bits perdidos bajo la guarda)
+        BFP_Stats<Cfg> st{};
+        const blk_t red = bfp_reduce_blocks<Cfg, N>(xs.data(), n_red, st);
+        double scale = 1e-30, dscale = 1e-30, err_red = 0.0, err_chain = 0.0, err_dot = 0.0;
+        for (int l = 0; l < N; l++) {
+            scale  = std::max(scale, std::fabs(ref[l]));
+            dscale = std::max(dscale, std::fabs(dot_ref[l]));
+        }
+        for (int l = 0; l < N; l++) {
+            err_red   = std::max(err_red, std::fabs(double(bfp_value(red, l)) - ref[l]) / scale);
+            err_chain = std::max(err_chain, std::fabs(double(bfp_value(chain, l)) - ref[l]) / scale);
+            err_dot   = std::max(err_dot, std::fabs(double(dot.to_float(l)) - dot_ref[l]) / dscale);
+        }
+        report("reduccion, 1 redondeo final", err_red, std::ldexp(1.0, -WM), tb_failures);
+        report("producto punto por lanes (FP32)", err_dot, 1e-6, tb_failures);
+        std::cout << "  (cadena de add_blocks, referencia)          max_rel_err=" << std::scientific
+                  << std::setprecision(3) << err_chain << std::defaultfloat << "\n";
+    }
+    std::cout << "\n";
+
+    //======================== RESUMEN FINAL ========================
+    std::cout << std::string(80, '=') << "\n";
+    if (tb_failures) {
+        std::cout << "[FAIL] " << tb_failures << " GEMM TEST(S) FAILED!\n";
+        std::cout << std::string(80, '=') << "\n";
+        return 1;
+    }
+    std::cout << "ALL GEMM TESTS COMPLETED!\n";
+    std::cout << std::string(80, '=') << "\n";
+    return 0;
+}
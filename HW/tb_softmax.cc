@@ -0,0 +1,189 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <iomanip>
+
+#include "bfp_hls.h"
+#include "bfp_stream_hls.h"
+
+// Kernel softmax (misma firma que SW/softmax/softmax.cpp)
+extern "C" void softmax(const float* a, float* c, int size);
+
+//------------------------ Configuración ------------------------
+#define WE 5
+#define WM 7
+#define N  16
+
+#ifndef SOFTMAX_ROW
+#define SOFTMAX_ROW 64   // debe coincidir con softmax.cpp
+#endif
+
+using Cfg = BFP_bias<WE, WM>;
+using blk_t = BFP_Global<Cfg, N>;
+
+//------------------------ Helpers ------------------------
+// Valor numerico del lane (sin interpretar centinelas NaN/Inf)
+double bfp_value(const blk_t& blk, int l) {
+    const double v = std::ldexp(double(blk.mant[l]), int(blk.exp_shared) - Cfg::bias_bfp - Cfg::wm);
+    return blk.sign[l] ? -v : v;
+}
+
+// Entrada cuantizada como la ve el kernel (bloques de N dentro de cada fila)
+std::vector<double> quantize_rows(const std::vector<float>& x, int size) {
+    std::vector<double> q(size, 0.0);
+    for (int r0 = 0; r0 < size; r0 += SOFTMAX_ROW) {
+        const int len = std::min(SOFTMAX_ROW, size - r0);
+        for (int b = 0; b * N < len; b++) {
+            std::array<float, N> xs{};
+            for (int l = 0; l < N; l++) xs[l] = (b * N + l < len) ? x[r0 + b * N + l] : 0.0f;
+            const blk_t blk = encode_block<Cfg, N>(xs);
+            for (int l = 0; l < N && b * N + l < len; l++) q[r0 + b * N + l] = bfp_value(blk, l);
+        }
+    }
+    return q;
+}
+
+std::vector<double> softmax_ref(const std::vector<double>& x, int size) {
+    std::vector<double> y(size);
+    for (int r0 = 0; r0 < size; r0 += SOFTMAX_ROW) {
+        const int len = std::min(SOFTMAX_ROW, size - r0);
+        double m = x[r0], s = 0.0;
+        for (int j = 1; j < len; j++) m = std::max(m, x[r0 + j]);
+        for (int j = 0; j < len; j++) s += std::exp(x[r0 + j] - m);
+        for (int j = 0; j < len; j++) y[r0 + j] = std::exp(x[r0 + j] - m) / s;
+    }
+    return y;
+}
+
+// Salida del kernel como floats (en modo BFP se decodifican los bloques de 512 bits)
+std::vector<double> read_output(const std::vector<float>& c, int size) {
+    std::vector<double> y(size);
+#ifdef SOFTMAX_OUT_BFP
+    for (int b = 0; b * N < size; b++) {
+        bfp_word_t w = 0;
+        for (int l = 0; l < N; l++) {
+            union {float f; uint32_t u;} cv;
+            cv.f = c[b * N + l];
+            w.range(32 * l + 31, 32 * l) = cv.u;
+        }
+        const blk_t blk = word_to_bfp<Cfg, N>(w);
+        for (int l = 0; l < N && b * N + l < size; l++) y[b * N + l] = bfp_value(blk, l);
+    }
+#else
+    for (int i = 0; i < size; i++) y[i] = c[i];
+#endif
+    return y;
+}
+
+// Error maximo relativo al maximo de cada fila de referencia
+double max_row_err(const std::vector<double>& got, const std::vector<double>& ref, int size) {
+    double worst = 0.0;
+    for (int r0 = 0; r0 < size; r0 += SOFTMAX_ROW) {
+        const int len = std::min(SOFTMAX_ROW, size - r0);
+        double scale = 1e-30;
+        for (int j = 0; j < len; j++) scale = std::max(scale, ref[r0 + j]);
+        for (int j = 0; j < len; j++) {
+            const double e = std::fabs(got[r0 + j] - ref[r0 + j]) / scale;
+            if (!(e == e)) return INFINITY;  // NaN
+            worst = std::max(worst, e);
+        }
+    }
+    return worst;
+}
+
+// Peor desviacion de la suma de cada fila respecto a 1
+double max_sum_err(const std::vector<double>& got, int size) {
+    double worst = 0.0;
+    for (int r0 = 0; r0 < size; r0 += SOFTMAX_ROW) {
+        const int len = std::min(SOFTMAX_ROW, size - r0);
+        double s = 0.0;
+        for (int j = 0; j < len; j++) s += got[r0 + j];
+        worst = std::max(worst, std::fabs(s - 1.0));
+    }
+    return worst;
+}
+
+int run_case(const char* name, const std::vector<float>& x) {
+    const int size = int(x.size());
+    std::vector<float> c(size, 0.0f);
+    softmax(x.data(), c.data(), size);
+
+    const auto got   = read_output(c, size);
+    const auto ref_q = softmax_ref(quantize_rows(x, size), size);
+    std::vector<double> xd(x.begin(), x.end());
+    const auto ref_f = softmax_ref(xd, size);
+
+    // Tabla 2^f (error ~1e-4) + reciproco a WM+1 bits; en BFP un redondeo mas
+#ifdef SOFTMAX_OUT_BFP
+    const double tol_q = 3.0 * std::ldexp(1.0, -WM);
+#else
+    const double tol_q = 1.5 * std::ldexp(1.0, -WM);
+#endif
+    const double tol_f = 0.05;   // incluye la cuantizacion BFP de la entrada
+    const double err_q = max_row_err(got, ref_q, size);
+    const double err_f = max_row_err(got, ref_f, size);
+    const double err_s = max_sum_err(got, size);
+
+    const bool ok = err_q <= tol_q && err_f <= tol_f && err_s <= 4.0 * tol_q;
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::scientific
+              << std::setprecision(2) << "err_q=" << err_q << "  err_fp32=" << err_f
+              << "  |sum-1|=" << err_s << std::defaultfloat << "  " << (ok ? "[OK]" : "[FAIL]") << "\n";
+    return ok ? 0 : 1;
+}
+
+int main() {
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "TESTBENCH BFP SOFTMAX (filas de " << SOFTMAX_ROW << ")\n";
+    std::cout << "Config: WE=" << WE << ", WM=" << WM << ", N=" << N;
+#ifdef SOFTMAX_OUT_BFP
+    std::cout << ", salida BFP (512 bits por bloque)\n";
+#else
+    std::cout << ", salida FP32\n";
+#endif
+    std::cout << std::string(80, '=') << "\n\n";
+
+    int tb_failures = 0;
+
+    // Rampa del host (SW/softmax/softmax.cpp): -7.99 + 0.01*i en la primera fila, luego 0.025...
+    std::vector<float> ramp(4 * SOFTMAX_ROW);
+    float as = -7.99f;
+    for (size_t i = 0; i < ramp.size(); i++) {
+        ramp[i] = as;
+        as += 0.01f;
+        if ((i + 1) % SOFTMAX_ROW == 0) as = 0.025f;
+    }
+
+    std::vector<float> mixed(3 * SOFTMAX_ROW);
+    for (size_t i = 0; i < mixed.size(); i++)
+        mixed[i] = 4.0f * std::sin(0.7f * float(i) + 0.3f) + float(i % 5) - 2.0f;
+
+    std::vector<float> wide(2 * SOFTMAX_ROW);
+    for (size_t i = 0; i < wide.size(); i++)
+        wide[i] = (i % 7 == 0) ? 20.0f - float(i % 3) : -15.0f + 0.5f * float(i % 11);
+
+    std::vector<float> flat(SOFTMAX_ROW, 1.5f);
+
+    tb_failures += run_case("Rampa del host (4 filas)", ramp);
+    tb_failures += run_case("Senoidal mixta (3 filas)", mixed);
+    tb_failures += run_case("Rango amplio, picos dominantes", wide);
+    tb_failures += run_case("Fila constante", flat);
+#ifndef SOFTMAX_OUT_BFP
+    // La ultima fila parcial solo aplica a salida FP32 (BFP exige filas completas)
+    std::vector<float> partial(SOFTMAX_ROW + SOFTMAX_ROW / 2 + 3);
+    for (size_t i = 0; i < partial.size(); i++) partial[i] = std::cos(0.31f * float(i)) * 3.0f;
+    tb_failures += run_case("Ultima fila parcial", partial);
+#endif
+    std::cout << "\n";
+
+    //======================== RESUMEN FINAL ========================
+    std::cout << std::string(80, '=') << "\n";
+    if (tb_failures) {
+        std::cout << "[FAIL] " << tb_failures << " SOFTMAX TEST(S) FAILED!\n";
+        std::cout << std::string(80, '=') << "\n";
+        return 1;
+    }
+    std::cout << "ALL SOFTMAX TESTS COMPLETED!\n";
+    std::cout << std::string(80, '=') << "\n";
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <iomanip>
+#include <cstring>
+
+#include "bfp_hls.h"
+#include "bfp_stream_hls.h"
+
+// Kernels de streaming (un archivo por kernel, ver bfp_stream.cfg)
+extern "C" void bfp_mm2s(const unsigned int* in, bfp_stream_t& out_blk,
+                         const unsigned int mode, const unsigned int n_blocks);
+extern "C" void bfp_s2mm(bfp_stream_t& in_blk, unsigned int* out,
+                         const unsigned int mode, const unsigned int n_blocks);
+extern "C" void bfp_encode_s(bfp_stream_t& in_blk, bfp_stream_t& out_blk);
+extern "C" void bfp_decode_s(bfp_stream_t& in_blk, bfp_stream_t& out_blk);
+extern "C" void bfp_alu_s(bfp_stream_t& in_a, bfp_stream_t& in_b,
+                          bfp_stream_t& out_blk, const unsigned int operation);
+
+// Kernel m_axi de referencia
+extern "C" void bfp_kernel(
+    const unsigned int operation,
+    const unsigned int n_blocks,
+    const float* in_fp32,
+    const unsigned int* in_bfp_a,
+    const unsigned int* in_bfp_b,
+    float* out_fp32,
+    unsigned int* out_bfp,
+    const unsigned int* program,
+    const float* in_fp32_b,
+    unsigned int* stats,
+    unsigned long long* profile,
+    const unsigned int row_blocks,
+    const float scalar_b,
+    const unsigned int n_elements,
+    const unsigned int block_size,
+    const unsigned int seed
+);
+
+//------------------------ Configuración ------------------------
+#define WE 5
+#define WM 7
+#define N  16
+
+using Cfg = BFP_bias<WE, WM>;
+
+static constexpr unsigned int BFP_BLOCK_SIZE = 1 + 2 * N;  // 33 para N=16
+
+enum : unsigned {
+    OP_ENCODE = 0,
+    OP_DECODE = 1,
+    OP_ADD    = 2,
+    OP_SUB    = 3,
+    OP_MUL    = 4,
+    OP_DIV    = 5,
+    OP_RCP    = 6
+};
+
+static const char* OP_NAMES[] = {"ENCODE", "DECODE", "ADD", "SUB", "MUL", "DIV", "RCP"};
+
+static unsigned int no_program[2] = {0u, 0xFFu};
+static unsigned int no_stats[7 + (1u << WE)];
+static unsigned long long no_profile[8];
+
+void run_kernel(unsigned op, unsigned n_blocks,
+                const float* in_fp32,
+                const unsigned int* in_bfp_a,
+                const unsigned int* in_bfp_b,
+                float* out_fp32,
+                unsigned int* out_bfp) {
+    bfp_kernel(op, n_blocks, in_fp32, in_bfp_a, in_bfp_b,
+               out_fp32, out_bfp, no_program, nullptr, no_stats, no_profile, 1u, 0.0f, 0u, 0u, 0u);
+}
+
+//=============================================================================
+// PIPELINE enlazado (equivalente en csim a las conexiones sc= de bfp_stream.cfg):
+//   mm2s_x -> enc_x -> alu_0.in_a
+//   mm2s_y -> enc_y -> alu_0.in_b
+//   alu_0 -> dec_0 -> s2mm_z
+// Los kernels libres se invocan una vez por bloque.
+//=============================================================================
+void run_stream_pipeline(unsigned op, unsigned n_blocks,
+                         const std::vector<float>& x,
+                         const std::vector<float>& y,
+                         std::vector<float>& z) {
+    bfp_stream_t s_x("s_x"), s_y("s_y"), s_ex("s_ex"), s_ey("s_ey");
+    bfp_stream_t s_alu("s_alu"), s_dec("s_dec");
+
+    bfp_mm2s(reinterpret_cast<const unsigned int*>(x.data()), s_x, BFP_STREAM_FP32, n_blocks);
+    bfp_mm2s(reinterpret_cast<const unsigned int*>(y.data()), s_y, BFP_STREAM_FP32, n_blocks);
+
+    for (unsigned b = 0; b < n_blocks; b++) {
+        bfp_encode_s(s_x, s_ex);
+        bfp_encode_s(s_y, s_ey);
+        bfp_alu_s(s_ex, s_ey, s_alu, op);
+        bfp_decode_s(s_alu, s_dec);
+    }
+
+    bfp_s2mm(s_dec, reinterpret_cast<unsigned int*>(z.data()), BFP_STREAM_FP32, n_blocks);
+}
+
+int main() {
+    std::cout << std::string(80, '=') << "\n";
+    std::cout << "TESTBENCH BFP STREAM KERNELS (mm2s -> encode_s -> alu_s -> decode_s -> s2mm)\n";
+    std::cout << "Config: WE=" << WE << ", WM=" << WM << ", N=" << N << "\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    const unsigned n_blocks = 8;
+    std::vector<float> x(N * n_blocks), y(N * n_blocks);
+
+    // Datos deterministas con distintos rangos dinamicos por bloque
+    for (unsigned i = 0; i < N * n_blocks; i++) {
+        const float scale = std::ldexp(1.0f, int(i / N) - 3);
+        x[i] = scale * std::sin(0.37f * float(i) + 0.1f) * 10.0f;
+        y[i] = scale * (std::cos(0.21f * float(i)) * 4.0f + 5.0f);
+    }
+    x[5] = 0.0f;                 // cero dentro de un bloque
+    y[N + 3] = -1.0e-3f;         // elemento pequeño (mantisa pequeña)
+
+    int tb_failures = 0;
+
+    //======================== TEST 1: PIPELINE vs bfp_kernel ========================
+    std::cout << "TEST 1: pipeline de streams vs bfp_kernel (m_axi), bit-exacto\n";
+    std::cout << std::string(80, '-') << "\n";
+
+    std::vector<unsigned int> enc_x(BFP_BLOCK_SIZE * n_blocks), enc_y(enc_x), enc_z(enc_x);
+    std::vector<float> dummy_fp32(N * n_blocks, 0.f);
+    std::vector<unsigned int> dummy_bfp(BFP_BLOCK_SIZE * n_blocks, 0u);
+
+    run_kernel(OP_ENCODE, n_blocks, x.data(), dummy_bfp.data(), dummy_bfp.data(),
+               dummy_fp32.data(), enc_x.data());
+    run_kernel(OP_ENCODE, n_blocks, y.data(), dummy_bfp.data(), dummy_bfp.data(),
+               dummy_fp32.data(), enc_y.data());
+
+    for (unsigned op = OP_ADD; op <= OP_RCP; op++) {
+        std::vector<float> ref(N * n_blocks, 0.f), z(N * n_blocks, 0.f);
+
+        run_kernel(op, n_blocks, dummy_fp32.data(), enc_x.data(), enc_y.data(),
+                   dummy_fp32.data(), enc_z.data());
+        run_kernel(OP_DECODE, n_blocks, dummy_fp32.data(), enc_z.data(), dummy_bfp.data(),
+                   ref.data(), dummy_bfp.data());
+
+        run_stream_pipeline(op, n_blocks, x, y, z);
+
+        const bool ok = std::memcmp(z.data(), ref.data(), sizeof(float) * N * n_blocks) == 0;
+        std::cout << "  " << std::left << std::setw(40) << OP_NAMES[op] << std::right
+                  << (ok ? "[OK]" : "[FAIL]") << "\n";
+        if (!ok) tb_failures++;
+    }
+    std::cout << "\n";
+
+    //======================== TEST 2: BORDES EN FORMATO COMPACTO ====================
+    // mm2s/s2mm en modo compacto: permite insertar el pipeline entre lanzamientos
+    // de bfp_kernel sin pasar por FP32.
+    std::cout << "TEST 2: mm2s/s2mm en formato compacto (MUL)\n";
+    std::cout << std::string(80, '-') << "\n";
+    {
+        std::vector<unsigned int> ref(BFP_BLOCK_SIZE * n_blocks), out(ref.size(), 0u);
+        run_kernel(OP_MUL, n_blocks, dummy_fp32.data(), enc_x.data(), enc_y.data(),
+                   dummy_fp32.data(), ref.data());
+
+        bfp_stream_t s_a("s_a"), s_b("s_b"), s_z("s_z");
+        bfp_mm2s(enc_x.data(), s_a, BFP_STREAM_COMPACT, n_blocks);
+        bfp_mm2s(enc_y.data(), s_b, BFP_STREAM_COMPACT, n_blocks);
+        for (unsigned b = 0; b < n_blocks; b++) {
+            bfp_alu_s(s_a, s_b, s_z, OP_MUL);
+        }
+        bfp_s2mm(s_z, out.data(), BFP_STREAM_COMPACT, n_blocks);
+
+        const bool ok = (out == ref);
+        std::cout << "  " << std::left << std::setw(40) << "COMPACT -> MUL -> COMPACT" << std::right
+                  << (ok ? "[OK]" : "[FAIL]") << "\n";
+        if (!ok) tb_failures++;
+    }
+    {
+        // Ida y vuelta compacto -> palabra de 512 bits -> compacto
+        std::vector<unsigned int> out(BFP_BLOCK_SIZE * n_blocks, 0u);
+        bfp_stream_t s("s");
+        bfp_mm2s(enc_y.data(), s, BFP_STREAM_COMPACT, n_blocks);
+        bfp_s2mm(s, out.data(), BFP_STREAM_COMPACT, n_blocks);
+
+        const bool ok = (out == enc_y);
+        std::cout << "  " << std::left << std::setw(40) << "COMPACT round trip (512-bit word)" << std::right
+                  << (ok ? "[OK]" : "[FAIL]") << "\n";
+        if (!ok) tb_failures++;
+    }
+    std::cout << "\n";
+
+    //======================== RESUMEN FINAL ========================
+    std::cout << std::string(80, '=') << "\n";
+    if (tb_failures) {
+        std::cout << "[FAIL] " << tb_failures << " STREAM TEST(S) FAILED!\n";
+        std::cout << std::string(80, '=') << "\n";
+        return 1;
+    }
+    std::cout << "ALL STREAM TESTS COMPLETED!\n";
+    std::cout << std::string(80, '=') << "\n";
+    return 0;
+}
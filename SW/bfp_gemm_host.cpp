@@ -0,0 +1,185 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+// XRT includes
+#include "experimental/xrt_bo.h"
+#include "experimental/xrt_device.h"
+#include "experimental/xrt_kernel.h"
+
+// Profiler
+#include "timer.hpp"
+
+// BFP common definitions
+#include "common_bfp.h"
+
+// Host tile sizes (C tile computed per group of launches)
+#define TILE_M 64
+#define TILE_N 64
+#define TILE_K GEMM_MAX_K
+
+// Encode a (rows x cols) sub-matrix of a row-major matrix into compact BFP
+// row blocks along K. Rows/columns outside the matrix are zero padded.
+void encode_tile(const std::vector<float>& mat, unsigned int mat_rows, unsigned int mat_cols,
+                 unsigned int r0, unsigned int k0, unsigned int rows, unsigned int k_blocks,
+                 uint32_t* compact) {
+    float xs[N];
+    for (unsigned int r = 0; r < rows; ++r) {
+        for (unsigned int kb = 0; kb < k_blocks; ++kb) {
+            for (int l = 0; l < N; ++l) {
+                const unsigned int row = r0 + r, col = k0 + kb * N + l;
+                xs[l] = (row < mat_rows && col < mat_cols) ? mat[size_t(row) * mat_cols + col] : 0.0f;
+            }
+            SimpleBFP blk = encode_fp32_to_bfp(xs, N);
+            pack_bfp_to_compact(blk.exp_shared, blk.flags, blk.sign.data(), blk.mant.data(),
+                                compact, (r * k_blocks + kb) * BFP_BLOCK_SIZE);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    INIT_PROFILER(gemm_profiler)
+    int device_index = 0;
+
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <M> <K> <N_cols>" << std::endl;
+        std::cerr << "  C (M x N_cols) = A (M x K) * B (K x N_cols) on the bfp_gemm systolic array" << std::endl;
+        std::cerr << "  Large matrices are tiled on the host: " << TILE_M << " x " << TILE_N
+                  << " C tiles, K in chunks of " << TILE_K << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    static std::string binaryFile = "../HW/package.hw/kernels.xclbin";
+    const unsigned int M  = std::stoi(argv[1]);
+    const unsigned int K  = std::stoi(argv[2]);
+    const unsigned int NC = std::stoi(argv[3]);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "BFP GEMM (systolic " << GEMM_P << "x" << GEMM_Q << ")" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "C = A * B: " << M << "x" << K << " * " << K << "x" << NC << std::endl;
+    std::cout << "BFP Config: WE=" << WE << ", WM=" << WM << ", N=" << N << std::endl;
+    std::cout << std::endl;
+
+    GET_PROFILE_INSTANCE(setup_time, gemm_profiler);
+    setup_time->reset();
+
+    std::cout << "Opening device " << device_index << "..." << std::endl;
+    auto device = xrt::device(device_index);
+
+    std::cout << "Loading xclbin: " << binaryFile << "..." << std::endl;
+    auto uuid = device.load_xclbin(binaryFile);
+
+    std::cout << "Creating kernel handle..." << std::endl;
+    auto bfp_gemm = xrt::kernel(device, uuid, "bfp_gemm");
+
+    setup_time->tick();
+
+    // Kernel arguments
+    //   0: mode (GEMM_OUT_BFP | GEMM_ACCUMULATE)
+    //   1: m, 2: n_cols, 3: k_blocks
+    //   4: a_bfp    -> gmem0 (TILE_M x TILE_K, compact row blocks)
+    //   5: bt_bfp   -> gmem1 (TILE_N x TILE_K, B^T compact row blocks)
+    //   6: out_fp32 -> gmem2 (TILE_M x TILE_N)
+    //   7: out_bfp  -> gmem2 (unused, FP32 output)
+    const unsigned int tile_kb = TILE_K / N;
+    const size_t a_words = size_t(TILE_M) * tile_kb * BFP_BLOCK_SIZE;
+    const size_t b_words = size_t(TILE_N) * tile_kb * BFP_BLOCK_SIZE;
+
+    std::cout << "Allocating buffers in global memory..." << std::endl;
+    auto bo_a   = xrt::bo(device, a_words * sizeof(uint32_t), bfp_gemm.group_id(4));
+    auto bo_bt  = xrt::bo(device, b_words * sizeof(uint32_t), bfp_gemm.group_id(5));
+    auto bo_c   = xrt::bo(device, size_t(TILE_M) * TILE_N * sizeof(float), bfp_gemm.group_id(6));
+    auto bo_cb  = xrt::bo(device, BFP_BLOCK_SIZE * sizeof(uint32_t), bfp_gemm.group_id(7));
+
+    auto bo_a_map  = bo_a.map<uint32_t*>();
+    auto bo_bt_map = bo_bt.map<uint32_t*>();
+    auto bo_c_map  = bo_c.map<float*>();
+
+    // Test data: A row-major (M x K), B stored transposed (N_cols x K)
+    std::vector<float> A(size_t(M) * K), BT(size_t(NC) * K), C(size_t(M) * NC, 0.0f);
+    for (size_t i = 0; i < A.size(); ++i)
+        A[i] = std::sin(0.013f * float(i) + 0.2f) * float(1 + i % 7);
+    for (size_t i = 0; i < BT.size(); ++i)
+        BT[i] = std::cos(0.029f * float(i)) * 2.0f - 0.25f;
+
+    //=========================================================================
+    // Tiled GEMM: for each C tile, K chunks accumulate on device
+    //=========================================================================
+    unsigned int launches = 0;
+    START_PROFILE(gemm_execution, gemm_profiler, 1)
+
+    for (unsigned int i0 = 0; i0 < M; i0 += TILE_M) {
+        const unsigned int tm = std::min(TILE_M, int(M - i0));
+        for (unsigned int j0 = 0; j0 < NC; j0 += TILE_N) {
+            const unsigned int tn = std::min(TILE_N, int(NC - j0));
+
+            for (unsigned int k0 = 0; k0 < K; k0 += TILE_K) {
+                const unsigned int tk = std::min(TILE_K, int(K - k0));
+                const unsigned int kb = (tk + N - 1) / N;
+
+                encode_tile(A, M, K, i0, k0, tm, kb, bo_a_map);
+                encode_tile(BT, NC, K, j0, k0, tn, kb, bo_bt_map);
+                bo_a.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+                bo_bt.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+
+                const unsigned int mode = (k0 == 0) ? 0u : GEMM_ACCUMULATE;
+                auto run = bfp_gemm(mode, tm, tn, kb, bo_a, bo_bt, bo_c, bo_cb);
+                run.wait();
+                launches++;
+            }
+
+            bo_c.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+            for (unsigned int r = 0; r < tm; ++r) {
+                std::memcpy(&C[size_t(i0 + r) * NC + j0], &bo_c_map[size_t(r) * tn], tn * sizeof(float));
+            }
+        }
+    }
+
+    END_PROFILE(gemm_execution);
+
+    //=========================================================================
+    // Validation against a CPU FP32 GEMM
+    //=========================================================================
+    std::cout << "Computing CPU reference..." << std::endl;
+    double max_rel = 0.0, abs_sum = 0.0;
+    for (unsigned int i = 0; i < M; ++i) {
+        std::vector<double> row(NC, 0.0);
+        double row_max = 1e-30;
+        for (unsigned int j = 0; j < NC; ++j) {
+            double s = 0.0;
+            for (unsigned int k = 0; k < K; ++k) s += double(A[size_t(i) * K + k]) * double(BT[size_t(j) * K + k]);
+            row[j] = s;
+            row_max = std::max(row_max, std::fabs(s));
+        }
+        for (unsigned int j = 0; j < NC; ++j) {
+            const double ae = std::fabs(double(C[size_t(i) * NC + j]) - row[j]);
+            abs_sum += ae;
+            max_rel = std::max(max_rel, ae / row_max);
+        }
+    }
+
+    const double secs = gemm_execution->samples.empty() ? 0.0 : gemm_execution->samples.back();
+    const double gflops = secs > 0.0 ? 2.0 * M * double(NC) * K / secs * 1e-9 : 0.0;
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Results" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  Kernel launches:     " << launches << std::endl;
+    std::cout << "  MAE:                 " << std::scientific << abs_sum / double(size_t(M) * NC) << std::endl;
+    std::cout << "  Max rel. error:      " << max_rel << " (vs row max)" << std::defaultfloat << std::endl;
+    std::cout << "  Throughput:          " << gflops << " GFLOP/s (incl. host encode + sync)" << std::endl;
+
+    // BFP quantization of both operands (WM=7): a few 2^-WM of the row max
+    const bool pass = max_rel < 4.0 * std::ldexp(1.0, -WM);
+    std::cout << "\n" << (pass ? "✓ TEST PASSED" : "✗ TEST FAILED") << std::endl;
+
+    std::cout << "\n" << gemm_profiler << std::endl;
+    std::cout << "\n========================================" << std::endl;
+
+    return pass ? 0 : 1;
+}
@@ -1,20 +1,65 @@
 /**
  * Common definitions for BFP HW/SW interface
- * ADAPTED for compact format with delta (HW: WE=5, WM=7)
+ * ADAPTED for the delta-free compact format (HW: WE=5, WM=7)
  */
 
 #ifndef COMMON_BFP_H
 #define COMMON_BFP_H
 
+#include <algorithm>
 #include <cstdint>
+#include <cmath>
+#include <vector>
 
 // BFP Configuration - Must match HW kernel
 #define WE 5
 #define WM 7
-#define N  16
+#define N  16       // Default block size (kernel block_size = 0)
+#define N_MAX 64     // Lanes synthesized in the kernel
+#define BFP_MIN_BLOCK 4
 
-// Compact format size: 1 exp_shared + 3*N (sign, mant, delta per element)
-#define BFP_BLOCK_SIZE (1 + 3 * N)  // 49 for N=16
+// Compact format size: 1 exp word + 2*N (sign, mant per element)
+#define BFP_BLOCK_SIZE (1 + 2 * N)  // 33 for N=16
+
+// Exp word = exp_shared | flags << 16 (must match HW/bfp_hls.h). With
+// BFP_FLAG_SPECIAL the block holds NaN/Inf: mant_max is Inf, mant_max - 1 NaN
+#define BFP_FLAG_SHIFT   16u
+#define BFP_EXP_MASK     ((1u << BFP_FLAG_SHIFT) - 1u)
+#define BFP_FLAG_SPECIAL 0x1u
+
+// Runtime block size: the kernel takes block_size in {4, 8, 16, 32, 64}
+// (0 = N); a block of bs lanes is 1 + 2*bs compact words and bs floats
+inline bool valid_block_size(unsigned int bs) {
+    return bs >= BFP_MIN_BLOCK && bs <= N_MAX && (bs & (bs - 1)) == 0;
+}
+
+inline unsigned int bfp_block_words(unsigned int bs) {
+    return 1 + 2 * bs;
+}
+
+// Planar layout (OP_PLANAR): a tensor of T blocks is stored as three planes
+// instead of interleaving the fields of each block. Must match bfp_kernel.cpp
+//   [0, T)                    exponent plane (exp word of each block)
+//   [T, T*(1+sw))             sign bitplane, sw = ceil(bs/32) words per block
+//                             (bit i of word i/32 = sign of lane i)
+//   [T*(1+sw), T*(1+sw+bs))   mantissa plane, bs words per block
+// A block takes 1 + sw + bs words instead of 1 + 2*bs, and each plane is a
+// contiguous array the host can process with SIMD loops.
+inline unsigned int bfp_sign_words(unsigned int bs) {
+    return (bs + 31) / 32;
+}
+
+struct BfpLayout {
+    bool planar;
+    unsigned int n_blocks;   // T (blocks of the tensor)
+    unsigned int bs;
+
+    unsigned int words() const {
+        return n_blocks * (planar ? 1 + bfp_sign_words(bs) + bs : bfp_block_words(bs));
+    }
+    unsigned int sign_base(unsigned int blk) const { return n_blocks + blk * bfp_sign_words(bs); }
+    unsigned int mant_base(unsigned int blk) const { return n_blocks * (1 + bfp_sign_words(bs)) + blk * bs; }
+};
 
 // Operation codes - Must match bfp_kernel.cpp enum
 typedef enum : unsigned int {
@@ -24,37 +69,463 @@ typedef enum : unsigned int {
     OP_SUB    = 3,
     OP_MUL    = 4,
     OP_DIV    = 5,
-    OP_RCP    = 6
+    OP_RCP    = 6,
+    OP_PROGRAM = 7,
+    // Fused FP32 in / FP32 out (encode + op + decode on device)
+    OP_ADD_F32 = 8,
+    OP_SUB_F32 = 9,
+    OP_MUL_F32 = 10,
+    OP_DIV_F32 = 11,
+    OP_RCP_F32 = 12,
+    // Row-wise normalization of row_blocks blocks (A in BFP, gamma/beta FP32)
+    OP_LAYERNORM = 13,
+    OP_RMSNORM   = 14,
+    // Table-driven activations on A (in_bfp_a -> out_bfp)
+    OP_GELU    = 15,
+    OP_SILU    = 16,
+    OP_TANH    = 17,
+    OP_SIGMOID = 18,
+    OP_EXP     = 19,
+    // Scalar operand: Z = A op scalar_b (no B buffer traffic)
+    OP_ADD_SCALAR = 20,
+    OP_SUB_SCALAR = 21,
+    OP_MUL_SCALAR = 22,
+    OP_DIV_SCALAR = 23,
+    // Row broadcast: row_blocks blocks of B cached on chip, A block i uses B[i % row_blocks]
+    OP_ADD_BCAST  = 24,
+    OP_SUB_BCAST  = 25,
+    OP_MUL_BCAST  = 26,
+    OP_DIV_BCAST  = 27,
+    // Mixed operands: A in BFP (in_bfp_a), B raw FP32 (in_fp32) encoded on device
+    OP_ADD_MIX    = 28,
+    OP_SUB_MIX    = 29,
+    OP_MUL_MIX    = 30,
+    OP_DIV_MIX    = 31
 } bfp_op_t;
 
+#define OP_LAST         OP_DIV_MIX
+#define BFP_OPCODE_MASK 0xFF
+#define OP_OUT_BFP      0x100   // *_F32 / *_MIX: write compact BFP to out_bfp instead of FP32
+#define OP_IN_PLACE     0x200   // Output overwrites A: A is preloaded in out_bfp (out_fp32 for *_F32)
+#define OP_PLANAR       0x400   // Compact tensors (A, B, out) use the planar layout (BfpLayout)
+
+// Fused op helpers: OP_ADD_F32 -> OP_ADD, ...
+inline bool is_fused_f32_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    return op >= OP_ADD_F32 && op <= OP_RCP_F32;
+}
+inline unsigned int fused_base_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    return is_fused_f32_op(op) ? op - OP_ADD_F32 + OP_ADD : op;
+}
+
+// Scalar / broadcast / mixed helpers: OP_MUL_SCALAR -> OP_MUL, OP_ADD_BCAST -> OP_ADD, ...
+inline bool is_scalar_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    return op >= OP_ADD_SCALAR && op <= OP_DIV_SCALAR;
+}
+inline bool is_bcast_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    return op >= OP_ADD_BCAST && op <= OP_DIV_BCAST;
+}
+inline bool is_mixed_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    return op >= OP_ADD_MIX && op <= OP_DIV_MIX;
+}
+inline unsigned int arith_base_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    if (is_scalar_op(op)) return op - OP_ADD_SCALAR + OP_ADD;
+    if (is_bcast_op(op))  return op - OP_ADD_BCAST + OP_ADD;
+    if (is_mixed_op(op))  return op - OP_ADD_MIX + OP_ADD;
+    return fused_base_op(op);
+}
+
 // Operation names for display
-static const char* OP_NAMES[] = {
+static const char* const OP_NAMES[] = {
     "ENCODE",
     "DECODE",
     "ADD",
     "SUB",
     "MUL",
     "DIV",
-    "RCP"
+    "RCP",
+    "PROGRAM",
+    "ADD_F32",
+    "SUB_F32",
+    "MUL_F32",
+    "DIV_F32",
+    "RCP_F32",
+    "LAYERNORM",
+    "RMSNORM",
+    "GELU",
+    "SILU",
+    "TANH",
+    "SIGMOID",
+    "EXP",
+    "ADD_SCALAR",
+    "SUB_SCALAR",
+    "MUL_SCALAR",
+    "DIV_SCALAR",
+    "ADD_BCAST",
+    "SUB_BCAST",
+    "MUL_BCAST",
+    "DIV_BCAST",
+    "ADD_MIX",
+    "SUB_MIX",
+    "MUL_MIX",
+    "DIV_MIX"
+};
+
+// LayerNorm / RMSNorm - Must match bfp_kernel.cpp
+#define NORM_MAX_ROW_BLOCKS 64      // up to 1024 channels per row
+#define BFP_NORM_EPS        1e-5f
+#define NORM_ROW_BLOCKS     4       // host demo: rows of 64 channels (also the B period of OP_*_BCAST)
+#define BFP_HOST_SCALAR     2.5f    // host demo: operand of OP_*_SCALAR
+#define BFP_HOST_SEED       1u      // host demo: LFSR seed (kernel arg 15, only read by stochastic rounding)
+
+inline bool is_norm_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    return op == OP_LAYERNORM || op == OP_RMSNORM;
+}
+
+inline bool is_act_op(unsigned int op) {
+    op &= BFP_OPCODE_MASK;
+    return op >= OP_GELU && op <= OP_EXP;
+}
+
+// Host reference for the activation opcodes
+inline double act_reference(unsigned int op, double x) {
+    switch (op & BFP_OPCODE_MASK) {
+        case OP_GELU:    return 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0)));
+        case OP_SILU:    return x / (1.0 + std::exp(-x));
+        case OP_TANH:    return std::tanh(x);
+        case OP_SIGMOID: return 1.0 / (1.0 + std::exp(-x));
+        default:         return std::exp(x);
+    }
+}
+
+// In-place is valid when A and the output share a format (not ENCODE / DECODE / RCP,
+// *_F32 only with FP32 output, *_MIX only with BFP output)
+inline bool supports_in_place(unsigned int op) {
+    const unsigned int base = op & BFP_OPCODE_MASK;
+    if (is_fused_f32_op(base)) return !(op & OP_OUT_BFP) && base != OP_RCP_F32;
+    if (is_mixed_op(base)) return (op & OP_OUT_BFP) != 0;
+    return base != OP_ENCODE && base != OP_DECODE && base != OP_RCP && base <= OP_LAST;
+}
+
+// Device buffers an operation actually touches, in 32-bit words (0 = unused).
+// Unused kernel arguments get a one-block placeholder and are never synced.
+struct BfpBufferPlan {
+    unsigned int in_fp32, in_bfp_a, in_bfp_b, out_fp32, out_bfp, in_fp32_b;
+};
+
+// n_elements: valid elements (FP32 buffers hold exactly that many, no padding);
+// BFP buffers always hold n_blocks full blocks of bs lanes (planar: OP_PLANAR in op)
+inline BfpBufferPlan bfp_buffer_plan(unsigned int op, unsigned int n_blocks, unsigned int n_elements,
+                                     unsigned int row_blocks, bool in_place, unsigned int bs = N) {
+    const bool planar = (op & OP_PLANAR) != 0;
+    const unsigned int fp32 = n_elements, bfp = BfpLayout{planar, n_blocks, bs}.words();
+    const unsigned int base = op & BFP_OPCODE_MASK;
+    BfpBufferPlan p = {0, 0, 0, 0, 0, 0};
+
+    if (is_fused_f32_op(base)) {
+        if (base != OP_RCP_F32) p.in_fp32 = fp32;
+        p.in_fp32_b = fp32;
+        if (op & OP_OUT_BFP) p.out_bfp = bfp; else p.out_fp32 = fp32;
+        if (in_place) p.in_fp32 = 0;             // A lives in out_fp32
+        return p;
+    }
+    if (is_mixed_op(base)) {
+        p.in_bfp_a = bfp;
+        p.in_fp32 = fp32;                        // B, encoded on device
+        if (op & OP_OUT_BFP) p.out_bfp = bfp; else p.out_fp32 = fp32;
+        if (in_place) p.in_bfp_a = 0;            // A lives in out_bfp
+        return p;
+    }
+    switch (base) {
+        case OP_ENCODE:  p.in_fp32 = fp32; p.out_bfp = bfp;  break;
+        case OP_DECODE:  p.in_bfp_a = bfp; p.out_fp32 = fp32; break;
+        case OP_RCP:     p.in_bfp_b = bfp; p.out_bfp = bfp;  break;
+        case OP_PROGRAM: p.in_bfp_a = bfp; p.in_bfp_b = bfp; p.out_bfp = bfp; p.out_fp32 = fp32; break;
+        case OP_LAYERNORM:
+            p.in_fp32_b = row_blocks * bs;       // beta
+            // fall through
+        case OP_RMSNORM:
+            p.in_fp32 = row_blocks * bs;         // gamma
+            p.in_bfp_a = bfp; p.out_bfp = bfp;
+            break;
+        default:
+            p.in_bfp_a = bfp; p.out_bfp = bfp;
+            if (base >= OP_ADD && base <= OP_DIV) p.in_bfp_b = bfp;
+            if (is_bcast_op(base)) p.in_bfp_b = BfpLayout{planar, row_blocks, bs}.words();
+            break;
+    }
+    if (in_place) p.in_bfp_a = 0;                // A lives in out_bfp
+    return p;
+}
+
+// Numeric health counters (stats buffer) - Must match bfp_kernel.cpp
+// Layout: [blocks, exp_overflow, exp_underflow, mant_sat, flush_zero, nan, inf,
+//          exp_hist[0 .. 2^WE - 1]]
+#define BFP_STATS_COUNTERS 7
+#define BFP_STATS_WORDS    (BFP_STATS_COUNTERS + (1 << WE))
+
+static const char* const STATS_NAMES[BFP_STATS_COUNTERS] = {
+    "blocks",
+    "exp_overflow",
+    "exp_underflow",
+    "mant_sat",
+    "flush_zero",
+    "nan",
+    "inf"
+};
+
+// Per-phase cycle profile (profile buffer, 64-bit words) - Must match bfp_kernel.cpp
+// Layout: [total, load, compute, store, stall, other, mem_words, n_blocks]
+// stall = load + store cycles that did not move a word (ideal port: 1 word/cycle)
+#define BFP_PROFILE_WORDS    8
+#define BFP_KERNEL_FREQ_MHZ  200.0   // Kernel clock used to convert cycles to time
+
+enum : unsigned int {
+    PF_TOTAL = 0,
+    PF_LOAD,
+    PF_COMPUTE,
+    PF_STORE,
+    PF_STALL,
+    PF_OTHER,
+    PF_MEM_WORDS,
+    PF_BLOCKS
+};
+
+static const char* const PROFILE_NAMES[] = {
+    "total",
+    "load",
+    "compute",
+    "store",
+    "stall",
+    "other"
 };
 
+// GEMM kernel (bfp_gemm) - Must match bfp_gemm.cpp
+// A is m x K (row blocks along K), B is passed as B^T (n_cols x K, row blocks along K)
+#define GEMM_P          4     // Systolic array rows
+#define GEMM_Q          16    // Systolic array columns
+#define GEMM_MAX_KB     64    // K blocks kept on chip per launch
+#define GEMM_MAX_K      (GEMM_MAX_KB * N)
+#define GEMM_OUT_BFP    0x1   // mode: C as compact BFP row blocks
+#define GEMM_ACCUMULATE 0x2   // mode: out_fp32 += A * B (K tiling)
+
+// Command list (OP_PROGRAM) - Must match bfp_kernel.cpp
+// Layout: [n_steps, out_slot, step0, step1, ...]
+// Step:   op | src_a << 8 | src_b << 16 | dst << 24
+// Slot 0 = block of in_bfp_a, slot 1 = block of in_bfp_b, slots 2..7 = on-chip
+#define BFP_PROG_SLOTS     8
+#define BFP_PROG_MAX_STEPS 16
+#define BFP_PROG_HEADER    2
+#define BFP_PROG_NO_OUTPUT 0xFF
+
+// Helper: Build a per-block program for OP_PROGRAM
+// Example: Z = A * B + B, decoded to FP32 and also stored as BFP
+//   BfpProgram p;
+//   p.mul(2, 0, 1).add(3, 2, 1).decode(3).output(3);
+//   std::vector<uint32_t> words = p.words();
+struct BfpProgram {
+    std::vector<uint32_t> steps;
+    uint32_t out_slot = BFP_PROG_NO_OUTPUT;
+
+    BfpProgram& step(uint32_t op, uint32_t src_a, uint32_t src_b, uint32_t dst) {
+        steps.push_back(op | (src_a << 8) | (src_b << 16) | (dst << 24));
+        return *this;
+    }
+
+    BfpProgram& encode(uint32_t dst)                          { return step(OP_ENCODE, 0, 0, dst); }
+    BfpProgram& decode(uint32_t src)                          { return step(OP_DECODE, src, 0, 0); }
+    BfpProgram& add(uint32_t dst, uint32_t a, uint32_t b)     { return step(OP_ADD, a, b, dst); }
+    BfpProgram& sub(uint32_t dst, uint32_t a, uint32_t b)     { return step(OP_SUB, a, b, dst); }
+    BfpProgram& mul(uint32_t dst, uint32_t a, uint32_t b)     { return step(OP_MUL, a, b, dst); }
+    BfpProgram& div(uint32_t dst, uint32_t a, uint32_t b)     { return step(OP_DIV, a, b, dst); }
+    BfpProgram& rcp(uint32_t dst, uint32_t src)               { return step(OP_RCP, 0, src, dst); }
+    BfpProgram& output(uint32_t slot)                         { out_slot = slot; return *this; }
+
+    // Words to copy into the device program buffer
+    std::vector<uint32_t> words() const {
+        std::vector<uint32_t> w;
+        w.push_back(uint32_t(steps.size()));
+        w.push_back(out_slot);
+        w.insert(w.end(), steps.begin(), steps.end());
+        return w;
+    }
+
+    bool valid() const {
+        if (steps.empty() || steps.size() > BFP_PROG_MAX_STEPS) return false;
+        for (uint32_t s : steps) {
+            if (((s >> 8) & 0xFF) >= BFP_PROG_SLOTS || ((s >> 16) & 0xFF) >= BFP_PROG_SLOTS ||
+                ((s >> 24) & 0xFF) >= BFP_PROG_SLOTS || (s & 0xFF) > OP_RCP) return false;
+        }
+        return out_slot < BFP_PROG_SLOTS || out_slot == BFP_PROG_NO_OUTPUT;
+    }
+};
+
+// Simple CPU-side BFP encoding (canonical delta-free block, matches HW encode_block)
+struct SimpleBFP {
+    unsigned int exp_shared;
+    unsigned int flags;               // BFP_FLAG_SPECIAL: block holds NaN/Inf lanes
+    std::vector<unsigned int> sign;
+    std::vector<unsigned int> mant;
+    
+    SimpleBFP(unsigned int n) : exp_shared(0), flags(0), sign(n, 0), mant(n, 0) {}
+};
+
+inline SimpleBFP encode_fp32_to_bfp(const float* data, unsigned int n) {
+    SimpleBFP result(n);
+    const uint32_t max_mant = (1u << (WM + 1)) - 1;
+    
+    // Find max exponent
+    int max_exp = -1000;
+    for (unsigned int i = 0; i < n; i++) {
+        if (data[i] == 0.0f) continue;
+        
+        union {float f; uint32_t u;} u = {data[i]};
+        int exp = int((u.u >> 23) & 0xFF);
+        if (exp > 0) {
+            int exp_unbiased = exp - 127;
+            if (exp_unbiased > max_exp) max_exp = exp_unbiased;
+        }
+    }
+    
+    if (max_exp == -1000) {
+        return result; // All zeros
+    }
+    
+    // Calculate shared exponent with bias
+    int exp_shared_bfp = max_exp + ((1 << (WE - 1)) - 1); // bias = 15 for WE=5
+    if (exp_shared_bfp < 0) exp_shared_bfp = 0;
+    if (exp_shared_bfp > 31) exp_shared_bfp = 31;
+    result.exp_shared = exp_shared_bfp;
+    
+    // Quantize each element
+    std::vector<bool> special(n, false);
+    for (unsigned int i = 0; i < n; i++) {
+        if (data[i] == 0.0f) {
+            result.sign[i] = 0;
+            result.mant[i] = 0;
+            continue;
+        }
+        
+        union {float f; uint32_t u;} u = {data[i]};
+        result.sign[i] = (u.u >> 31) & 0x1;
+        
+        int exp = int((u.u >> 23) & 0xFF);
+        if (exp == 0) { result.sign[i] = 0; continue; }
+
+        // NaN/Inf: sentinel mantissas, only meaningful with the block flag
+        if (exp == 0xFF) {
+            special[i] = true;
+            result.mant[i] = (u.u & 0x7FFFFF) ? max_mant - 1 : max_mant;
+            continue;
+        }
+        
+        uint32_t mant24 = (u.u & 0x7FFFFF) | (1u << 23);
+        int exp_unbiased = exp - 127;
+        
+        int shift = (23 - WM) + (max_exp - exp_unbiased);
+        
+        uint32_t mant_reduced;
+        if (shift >= 32) {
+            mant_reduced = 0;
+        } else if (shift < 0) {
+            mant_reduced = mant24 << (-shift);
+        } else {
+            // Round to nearest even
+            uint32_t q = mant24 >> shift;
+            uint32_t rem = mant24 & ((1u << shift) - 1);
+            uint32_t half = 1u << (shift - 1);
+            if (rem > half || (rem == half && (q & 1))) {
+                q++;
+            }
+            mant_reduced = q;
+        }
+        
+        if (mant_reduced > max_mant) mant_reduced = max_mant;
+        
+        result.mant[i] = mant_reduced;
+    }
+
+    // Blocks with NaN/Inf: set the flag, finite lanes stay below the sentinels
+    if (std::find(special.begin(), special.end(), true) != special.end()) {
+        result.flags = BFP_FLAG_SPECIAL;
+        for (unsigned int i = 0; i < n; i++) {
+            if (!special[i] && result.mant[i] > max_mant - 2) result.mant[i] = max_mant - 2;
+        }
+    }
+    
+    return result;
+}
+
+// One block of bs lanes of a tensor whose last block may be partial: lanes >=
+// 'lanes' are encoded as zero so they cannot raise the shared exponent
+inline SimpleBFP encode_fp32_block(const float* data, unsigned int lanes, unsigned int bs = N) {
+    float tmp[N_MAX] = {};
+    std::copy(data, data + std::min(lanes, bs), tmp);
+    return encode_fp32_to_bfp(tmp, bs);
+}
+
+// Valid lanes of block 'blk' (blocks of bs lanes) in a tensor of n_elements
+inline unsigned int block_lanes(unsigned int n_elements, unsigned int blk, unsigned int bs = N) {
+    const unsigned int rest = n_elements - blk * bs;
+    return rest < bs ? rest : bs;
+}
+
+// Helper to decode BFP element to FP32 (matches HW rebuild_FP32)
+inline float decode_bfp_to_fp32(uint32_t exp_shared, uint32_t sign, uint32_t mant, uint32_t flags) {
+    const uint32_t mant_max = (1u << (WM + 1)) - 1;
+    const int bias = (1 << (WE - 1)) - 1;  // 15 for WE=5
+    const bool special = (flags & BFP_FLAG_SPECIAL) != 0;
+    
+    // Detect NaN
+    if (special && mant == (mant_max - 1)) {
+        union {float f; uint32_t u;} nan_val;
+        nan_val.u = 0x7FC00000;
+        return nan_val.f;
+    }
+    
+    // Detect Infinity
+    if (special && mant == mant_max) {
+        union {float f; uint32_t u;} inf_val;
+        inf_val.u = sign ? 0xFF800000 : 0x7F800000;
+        return inf_val.f;
+    }
+    
+    // Detect zero
+    if (mant == 0) return 0.0f;
+    
+    // Reconstruction: mantissas are aligned to the shared exponent
+    int exp_shared_unbiased = int(exp_shared) - bias;
+    
+    float mant_val = float(mant) / float(1u << WM);
+    float value = ldexpf(mant_val, exp_shared_unbiased);
+    
+    return sign ? -value : value;
+}
+
 // Helper: Pack BFP data into compact format for HW
-// Format: [exp_shared, sign[0], mant[0], delta[0], sign[1], mant[1], delta[1], ...]
+// Format: [exp_shared | flags << 16, sign[0], mant[0], sign[1], mant[1], ...]
+// (lanes = runtime block size, bfp_block_words(lanes) words)
 inline void pack_bfp_to_compact(
     uint32_t exp_shared,
+    uint32_t flags,
     const uint32_t* sign,
     const uint32_t* mant,
-    const uint32_t* delta,
     uint32_t* compact_buf,
-    uint32_t offset
+    uint32_t offset,
+    uint32_t lanes = N
 ) {
-    compact_buf[offset] = exp_shared;
+    compact_buf[offset] = (exp_shared & BFP_EXP_MASK) | (flags << BFP_FLAG_SHIFT);
     uint32_t idx = offset + 1;
     
-    for (int i = 0; i < N; i++) {
+    for (uint32_t i = 0; i < lanes; i++) {
         compact_buf[idx++] = sign[i];
         compact_buf[idx++] = mant[i];
-        compact_buf[idx++] = delta[i];
     }
 }
 
@@ -63,17 +534,144 @@ inline void unpack_compact_to_bfp(
     const uint32_t* compact_buf,
     uint32_t offset,
     uint32_t& exp_shared,
+    uint32_t& flags,
     uint32_t* sign,
     uint32_t* mant,
-    uint32_t* delta
+    uint32_t lanes = N
 ) {
-    exp_shared = compact_buf[offset];
+    exp_shared = compact_buf[offset] & BFP_EXP_MASK;
+    flags      = compact_buf[offset] >> BFP_FLAG_SHIFT;
     uint32_t idx = offset + 1;
     
-    for (int i = 0; i < N; i++) {
-        sign[i]  = compact_buf[idx++];
-        mant[i]  = compact_buf[idx++];
-        delta[i] = compact_buf[idx++];
+    for (uint32_t i = 0; i < lanes; i++) {
+        sign[i] = compact_buf[idx++];
+        mant[i] = compact_buf[idx++];
+    }
+}
+
+// Helpers: block 'blk' of a tensor in either layout
+inline void pack_bfp_block(const BfpLayout& L, uint32_t blk, uint32_t exp_shared, uint32_t flags,
+                           const uint32_t* sign, const uint32_t* mant, uint32_t* buf) {
+    if (!L.planar) {
+        pack_bfp_to_compact(exp_shared, flags, sign, mant, buf, blk * bfp_block_words(L.bs), L.bs);
+        return;
+    }
+    buf[blk] = (exp_shared & BFP_EXP_MASK) | (flags << BFP_FLAG_SHIFT);
+    uint32_t* sbits = buf + L.sign_base(blk);
+    std::fill(sbits, sbits + bfp_sign_words(L.bs), 0u);
+    for (uint32_t i = 0; i < L.bs; i++) sbits[i / 32] |= (sign[i] & 1u) << (i % 32);
+    std::copy(mant, mant + L.bs, buf + L.mant_base(blk));
+}
+
+inline void unpack_bfp_block(const BfpLayout& L, const uint32_t* buf, uint32_t blk,
+                             uint32_t& exp_shared, uint32_t& flags, uint32_t* sign, uint32_t* mant) {
+    if (!L.planar) {
+        unpack_compact_to_bfp(buf, blk * bfp_block_words(L.bs), exp_shared, flags, sign, mant, L.bs);
+        return;
+    }
+    exp_shared = buf[blk] & BFP_EXP_MASK;
+    flags      = buf[blk] >> BFP_FLAG_SHIFT;
+    const uint32_t* sbits = buf + L.sign_base(blk);
+    for (uint32_t i = 0; i < L.bs; i++) sign[i] = (sbits[i / 32] >> (i % 32)) & 1u;
+    std::copy(buf + L.mant_base(blk), buf + L.mant_base(blk) + L.bs, mant);
+}
+
+// Decode a whole tensor to FP32 (n_blocks * bs floats). Planar blocks without
+// NaN/Inf are one scale per block over contiguous mantissa and sign arrays (a
+// loop the compiler vectorizes); flagged blocks and the interleaved layout
+// go lane by lane through decode_bfp_to_fp32.
+inline void decode_bfp_tensor(const BfpLayout& L, const uint32_t* buf, float* out) {
+    const int bias = (1 << (WE - 1)) - 1;
+    uint32_t sign[N_MAX], mant[N_MAX];
+    for (uint32_t b = 0; b < L.n_blocks; b++) {
+        float* o = out + b * L.bs;
+        if (L.planar && !((buf[b] >> BFP_FLAG_SHIFT) & BFP_FLAG_SPECIAL)) {
+            const float scale = ldexpf(1.0f, int(buf[b] & BFP_EXP_MASK) - bias - WM);
+            const uint32_t* m = buf + L.mant_base(b);
+            const uint32_t* sbits = buf + L.sign_base(b);
+            for (uint32_t i = 0; i < L.bs; i++) {
+                const uint32_t s = (sbits[i / 32] >> (i % 32)) & 1u;
+                const float v = scale * float(m[i]);
+                o[i] = (s && m[i]) ? -v : v;
+            }
+            continue;
+        }
+        uint32_t exp_shared, flags;
+        unpack_bfp_block(L, buf, b, exp_shared, flags, sign, mant);
+        for (uint32_t i = 0; i < L.bs; i++) o[i] = decode_bfp_to_fp32(exp_shared, sign[i], mant[i], flags);
+    }
+}
+
+// Layout converters (same blocks, interleaved <-> planar)
+inline void convert_compact_to_planar(const uint32_t* compact, uint32_t* planar,
+                                      uint32_t n_blocks, uint32_t bs = N) {
+    const BfpLayout in{false, n_blocks, bs}, out{true, n_blocks, bs};
+    uint32_t exp_shared, flags, sign[N_MAX], mant[N_MAX];
+    for (uint32_t b = 0; b < n_blocks; b++) {
+        unpack_bfp_block(in, compact, b, exp_shared, flags, sign, mant);
+        pack_bfp_block(out, b, exp_shared, flags, sign, mant, planar);
+    }
+}
+
+inline void convert_planar_to_compact(const uint32_t* planar, uint32_t* compact,
+                                      uint32_t n_blocks, uint32_t bs = N) {
+    const BfpLayout in{true, n_blocks, bs}, out{false, n_blocks, bs};
+    uint32_t exp_shared, flags, sign[N_MAX], mant[N_MAX];
+    for (uint32_t b = 0; b < n_blocks; b++) {
+        unpack_bfp_block(in, planar, b, exp_shared, flags, sign, mant);
+        pack_bfp_block(out, b, exp_shared, flags, sign, mant, compact);
+    }
+}
+
+// Converters to and from the previous compact format with per-element delta:
+// [exp_shared, (sign, mant, delta) x lanes], 1 + 3*lanes words per block.
+// There, delta == 0 with mant_max / mant_max - 1 marked Inf / NaN; the value
+// of a lane was already mant * 2^(E - bias - wm), so delta is dropped (and
+// recomputed from the mantissa MSB on the way back).
+inline uint32_t delta_from_mant(uint32_t mant) {
+    if (mant == 0) return 0;
+    int msb = WM;
+    while (msb > 0 && !((mant >> msb) & 1u)) msb--;
+    return uint32_t(WM - msb);
+}
+
+inline void convert_delta_to_compact(const uint32_t* legacy, uint32_t* compact,
+                                     uint32_t n_blocks, uint32_t lanes = N) {
+    const uint32_t mant_max = (1u << (WM + 1)) - 1;
+    for (uint32_t b = 0; b < n_blocks; b++) {
+        const uint32_t* in = legacy + b * (1 + 3 * lanes);
+        uint32_t* out = compact + b * bfp_block_words(lanes);
+        bool any_special = false;
+        for (uint32_t i = 0; i < lanes; i++) {
+            any_special |= (in[3 + 3 * i] == 0 && in[2 + 3 * i] >= mant_max - 1);
+        }
+        out[0] = in[0] | (any_special ? BFP_FLAG_SPECIAL << BFP_FLAG_SHIFT : 0u);
+        for (uint32_t i = 0; i < lanes; i++) {
+            const bool special = in[3 + 3 * i] == 0 && in[2 + 3 * i] >= mant_max - 1;
+            uint32_t m = in[2 + 3 * i];
+            if (any_special && !special && m > mant_max - 2) m = mant_max - 2;
+            out[1 + 2 * i] = in[1 + 3 * i];
+            out[2 + 2 * i] = m;
+        }
+    }
+}
+
+inline void convert_compact_to_delta(const uint32_t* compact, uint32_t* legacy,
+                                     uint32_t n_blocks, uint32_t lanes = N) {
+    const uint32_t mant_max = (1u << (WM + 1)) - 1;
+    for (uint32_t b = 0; b < n_blocks; b++) {
+        const uint32_t* in = compact + b * bfp_block_words(lanes);
+        uint32_t* out = legacy + b * (1 + 3 * lanes);
+        const bool flagged = ((in[0] >> BFP_FLAG_SHIFT) & BFP_FLAG_SPECIAL) != 0;
+        out[0] = in[0] & BFP_EXP_MASK;
+        for (uint32_t i = 0; i < lanes; i++) {
+            uint32_t m = in[2 + 2 * i];
+            const bool special = flagged && m >= mant_max - 1;
+            if (!special && m > mant_max - 2) m = mant_max - 2;   // not a sentinel
+            out[1 + 3 * i] = in[1 + 2 * i];
+            out[2 + 3 * i] = m;
+            out[3 + 3 * i] = special ? 0u : delta_from_mant(m);
+        }
     }
 }
 
@@ -197,6 +197,93 @@ else
 fi
 echo ""
 
+# Test 8: PROGRAM
+echo "========================================"
+echo -e "${BLUE}Test 8: PROGRAM (On-device command list)${NC}"
+echo "========================================"
+$EXECUTABLE 7 $N_BLOCKS | tee $TMPFILE
+if [ $? -eq 0 ]; then
+    echo ""
+    echo -e "${CYAN}Key Results:${NC}"
+    echo -e "  Program: (A + B) + B -> DECODE, one launch"
+    MAE=$(grep "MAE:" $TMPFILE | grep -oP 'MAE:\s+\K[0-9.e+-]+')
+    MAPE=$(grep "MAPE:" $TMPFILE | grep -oP 'MAPE:\s+\K[0-9.]+')
+    echo -e "  Mean Absolute Error: ${GREEN}${MAE}${NC}"
+    echo -e "  Mean Absolute % Error: ${GREEN}${MAPE}%${NC}"
+    grep "TEST PASSED\|TEST FAILED" $TMPFILE
+    AVG_TIME=$(grep "kernel_execution" $TMPFILE | grep -oP 'AVG: \K[0-9.e+-]+')
+    echo -e "  Kernel execution time: ${GREEN}${AVG_TIME}s${NC}"
+    echo ""
+    echo -e "${GREEN}✓ PROGRAM test completed${NC}"
+else
+    echo -e "${RED}✗ PROGRAM test failed${NC}"
+fi
+echo ""
+
+# Test 9: Fused FP32 in / FP32 out
+echo "========================================"
+echo -e "${BLUE}Test 9: Fused FP32 ops (ADD_F32 .. RCP_F32)${NC}"
+echo "========================================"
+for OP in 8 9 10 11 12; do
+    $EXECUTABLE $OP $N_BLOCKS > $TMPFILE
+    NAME=$(grep "Operation:" $TMPFILE | awk '{print $2}')
+    MAPE=$(grep "MAPE:" $TMPFILE | grep -oP 'MAPE:\s+\K[0-9.infa]+')
+    AVG_TIME=$(grep "kernel_execution" $TMPFILE | grep -oP 'AVG: \K[0-9.e+-]+')
+    if grep -q "TEST PASSED" $TMPFILE; then
+        echo -e "  ${GREEN}✓${NC} ${NAME}: MAPE ${MAPE}%, kernel ${AVG_TIME}s"
+    else
+        echo -e "  ${RED}✗${NC} ${NAME}: MAPE ${MAPE}%, kernel ${AVG_TIME}s"
+    fi
+done
+echo ""
+
+# Test 10: Runtime block size (same bitstream, bs = 4 .. 64)
+echo "========================================"
+echo -e "${BLUE}Test 10: Runtime block size (DECODE, bs=4..64)${NC}"
+echo "========================================"
+for BS in 4 8 16 32 64; do
+    $EXECUTABLE 1 $N_BLOCKS bs=$BS > $TMPFILE
+    MAPE=$(grep "MAPE:" $TMPFILE | grep -oP 'MAPE:\s+\K[0-9.infa]+')
+    WORDS=$(grep "mem_words" $TMPFILE | awk '{print $2}')
+    echo -e "  bs=${BS}: MAPE ${MAPE}%, ${WORDS} words moved"
+done
+echo ""
+
+# Test 11: Planar layout (OP_PLANAR) vs interleaved blocks
+echo "========================================"
+echo -e "${BLUE}Test 11: Planar vs interleaved layout (ADD / DECODE, bs=16 and 64)${NC}"
+echo "========================================"
+for CASE in "ADD 2 bs=16" "ADD 2 bs=64" "DECODE 1 bs=16" "DECODE 1 bs=64"; do
+    set -- $CASE
+    for LAYOUT in "" planar; do
+        $EXECUTABLE $2 $N_BLOCKS $3 $LAYOUT > $TMPFILE
+        WORDS=$(grep "mem_words" $TMPFILE | awk '{print $2}')
+        HOST=$(grep -- "-- host_decode_${LAYOUT:-interleaved} --" $TMPFILE | grep -oP 'AVG:\s+\K[0-9.e-]+')
+        echo -e "  $1 $3 ${LAYOUT:-interleaved}: ${WORDS} words moved, host decode ${HOST}s"
+    done
+done
+echo ""
+
+# Test 12: Mixed operands (A in BFP, B raw FP32 encoded on device)
+echo "========================================"
+echo -e "${BLUE}Test 12: Mixed BFP x FP32 ops (ADD_MIX .. DIV_MIX, FP32 and BFP out)${NC}"
+echo "========================================"
+for OP in 28 29 30 31; do
+    $EXECUTABLE $OP $N_BLOCKS > $TMPFILE
+    NAME=$(grep "Operation:" $TMPFILE | awk '{print $2}')
+    MAPE=$(grep "MAPE:" $TMPFILE | grep -oP 'MAPE:\s+\K[0-9.infa]+')
+    WORDS=$(grep "mem_words" $TMPFILE | awk '{print $2}')
+    if grep -q "TEST PASSED" $TMPFILE; then
+        echo -e "  ${GREEN}✓${NC} ${NAME}: MAPE ${MAPE}%, ${WORDS} words moved"
+    else
+        echo -e "  ${RED}✗${NC} ${NAME}: MAPE ${MAPE}%, ${WORDS} words moved"
+    fi
+    $EXECUTABLE $OP $N_BLOCKS bfpout inplace > $TMPFILE
+    WORDS=$(grep "mem_words" $TMPFILE | awk '{print $2}')
+    echo -e "    ${NAME} bfpout inplace: ${WORDS} words moved"
+done
+echo ""
+
 # Cleanup
 rm -f $TMPFILE
 
@@ -209,6 +296,11 @@ echo -e "${CYAN}Summary:${NC}"
 echo "  • ENCODE: Converts FP32 to BFP format"
 echo "  • DECODE: Converts BFP back to FP32"
 echo "  • ADD/SUB/MUL/DIV/RCP: Arithmetic in BFP"
+echo "  • PROGRAM: Chain of BFP ops in a single kernel launch"
+echo "  • *_F32: FP32 in/out, encode + op + decode fused on device"
+echo "  • *_MIX: BFP A with raw FP32 B, B encoded on device (no host encode pass)"
+echo "  • bs=<k>: block size chosen per launch (accuracy vs bandwidth)"
+echo "  • planar: exponent / sign-bit / mantissa planes instead of interleaved blocks"
 echo ""
 echo -e "${YELLOW}Note:${NC} Display shows first 8 elements per block for brevity."
 echo "      Full ${N_BLOCKS} blocks x 16 elements = $((N_BLOCKS * 16)) total elements processed."
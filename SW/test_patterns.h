@@ -0,0 +1,51 @@
+/**
+ * Input patterns shared by bfp_host and FP32/SW/fp32_host, so BFP and FP32
+ * runs are measured on the same tensors
+ */
+
+#ifndef TEST_PATTERNS_H
+#define TEST_PATTERNS_H
+
+#define TEST_PATTERN_LEN   16
+#define TEST_PATTERN_COUNT 6
+
+static const float TEST_A[TEST_PATTERN_COUNT][TEST_PATTERN_LEN] = {
+    { 12.35f,  6.50f, 10.20f,  6.60f,  8.80f,  2.56f, 11.11f,  8.00f,
+       5.45f,  9.99f,  0.15f, 18.00f,  3.80f, 90.10f, 14.00f, 10.00f },
+    {  1.0f, 2.0f, 3.0f,  4.0f,  5.0f,  6.0f,  7.0f,  8.0f,
+       9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f },
+    { 64.0f, 128.0f, 256.0f, 512.0f, 32.0f, 16.0f, 8.0f, 4.0f,
+       2.0f, 1.0f, 0.5f, 0.25f, 0.125f, 96.0f, 48.0f, 24.0f },
+    {  0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f,
+       0.9f, 1.1f, 1.2f, 1.3f, 1.4f, 1.5f, 1.6f, 1.7f },
+    { -12.5f, 8.0f, -6.25f, 15.0f, -3.5f, 20.0f, -9.0f, 7.5f,
+       -4.25f, 11.0f, -2.75f, 13.5f, -8.5f, 5.0f, -10.5f, 16.0f },
+    { 100.0f, 99.5f, 98.25f, 97.0f, 95.5f, 94.0f, 92.5f, 91.0f,
+       89.5f, 88.0f, 86.5f, 85.0f, 83.5f, 82.0f, 80.5f, 79.0f }
+};
+
+static const float TEST_B[TEST_PATTERN_COUNT][TEST_PATTERN_LEN] = {
+    { 2.0f, 1.0f, 2.0f, 3.0f, 2.0f, 2.0f, 2.0f, 2.0f,
+      3.0f, 3.0f, 5.0f, 3.0f, 6.0f, 3.0f, 8.0f, 2.0f },
+    { 15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f,
+       7.0f,  6.0f,  5.0f,  4.0f,  3.0f,  2.0f, 1.0f, 0.5f },
+    { 2.0f, 4.0f, 8.0f, 16.0f, 2.0f, 2.0f, 2.0f, 2.0f,
+      2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 3.0f, 3.0f, 3.0f },
+    { 0.5f, 0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f, 1.0f,
+      2.0f, 2.0f, 2.0f, 2.0f, 3.0f, 3.0f, 3.0f, 3.0f },
+    { 2.0f, -2.0f, 2.0f, -2.0f, 2.0f, -2.0f, 2.0f, -2.0f,
+      3.0f, -3.0f, 3.0f, -3.0f, 4.0f, -4.0f, 4.0f, -4.0f },
+    { 10.0f, 9.5f, 9.0f, 8.5f, 8.0f, 7.5f, 7.0f, 6.5f,
+       6.0f, 5.5f, 5.0f, 4.5f, 4.0f, 3.5f, 3.0f, 2.5f }
+};
+
+// Element i of the A / B test tensors: the patterns are cycled element by
+// element, so every block size sees the same tensor
+inline float test_pattern_a(unsigned int i) {
+    return TEST_A[(i / TEST_PATTERN_LEN) % TEST_PATTERN_COUNT][i % TEST_PATTERN_LEN];
+}
+inline float test_pattern_b(unsigned int i) {
+    return TEST_B[(i / TEST_PATTERN_LEN) % TEST_PATTERN_COUNT][i % TEST_PATTERN_LEN];
+}
+
+#endif // TEST_PATTERNS_H